@@ -14,7 +14,7 @@ static char const* RUN_TAG = "Run";
 namespace R3 {
 
 int Application::run() {
-    EngineInstance = new Engine();
+    EngineInstance = new Engine(m_spec);
 
     bool loop = true;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <R3>
+#include <R3_core>
 
 // #define USER_DL "animation.dll"
 #define USER_DL "libanimation.so"
@@ -10,7 +11,15 @@ namespace R3 {
 
 class Application {
 public:
+    /// @brief Construct Application, the Engine is only created by run()
+    /// @param spec passed on to the Engine
+    explicit Application(const EngineSpecification& spec = {})
+        : m_spec(spec) {}
+
     int run();
+
+private:
+    EngineSpecification m_spec;
 };
 
 } // namespace R3
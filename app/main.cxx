@@ -1,6 +1,39 @@
 #include "Application.hxx"
 
-int main() {
-    R3::Application app;
+#include <charconv>
+#include <iostream>
+#include <string_view>
+
+static void usage() {
+    std::cout << "usage: R3_APP [--threads|-t N]\n";
+}
+
+// the whole argument must be an unsigned number, so "abc", "-1" and "4abc" are all rejected
+template <typename T>
+static bool parse(std::string_view value, T& out) {
+    const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), out);
+    return ec == std::errc() && end == value.data() + value.size();
+}
+
+int main(int argc, char** argv) {
+    R3::EngineSpecification spec = {
+        .workerThreads = 0,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+
+        if ((arg == "--threads" || arg == "-t") && i + 1 < argc) {
+            if (!parse(argv[++i], spec.workerThreads)) {
+                usage();
+                return 1;
+            }
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    R3::Application app(spec);
     return app.run();
 }
@@ -0,0 +1,198 @@
+#include "Cooker.hxx"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include "Lock.hxx"
+#include "api/Hash.hpp"
+#include "media/asset/Asset.hxx"
+#include "render/model/ModelDecoder.hxx"
+
+namespace R3 {
+
+namespace local {
+
+static constexpr const char* LOCK_FILE = ".asset.lock.json";
+
+static uint64 hash(uint64 seed, const void* data, usize size) {
+    return fnv1a({static_cast<const std::byte*>(data), size}, seed);
+}
+
+// hash a model together with every buffer and image it references, wherever they are relative to it
+// seeded with the asset VERSION and cook options so changing either cooks everything again
+static uint64 contentHash(const std::filesystem::path& source, bool optimize, uint32 lods) {
+    const std::vector<std::filesystem::path> files = asset::dependencies(source);
+
+    uint64 seed = hash(FNV_OFFSET, &asset::VERSION, sizeof(asset::VERSION));
+    seed = hash(seed, &optimize, sizeof(optimize));
+    seed = hash(seed, &lods, sizeof(lods));
+
+    std::vector<char> chunk(64 * 1024);
+    for (const std::filesystem::path& file : files) {
+        const std::string name = file.lexically_relative(source.parent_path()).generic_string();
+        seed = hash(seed, name.data(), name.size());
+
+        std::ifstream ifs(file, std::ios::binary);
+        while (ifs.read(chunk.data(), std::streamsize(chunk.size())) || ifs.gcount() > 0) {
+            seed = hash(seed, chunk.data(), usize(ifs.gcount()));
+        }
+    }
+
+    return seed;
+}
+
+} // namespace local
+
+Cooker::Cooker(const CookerSpecification& spec)
+    : m_spec(spec) {}
+
+int Cooker::run() {
+    const std::vector<std::filesystem::path> sources = collect();
+    if (sources.empty()) {
+        LOG(Warning, "no models found in", m_spec.directory);
+        return 0;
+    }
+
+    Lock lock(m_spec.directory / local::LOCK_FILE);
+    std::vector<CookReport> reports(sources.size());
+
+    usize jobs = m_spec.jobs != 0 ? m_spec.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min(jobs, sources.size());
+
+    LOG(Info, "cooking", sources.size(), "models with", jobs, "jobs...");
+
+    // every worker pulls the next model until none are left, the largest models do not serialize the rest
+    std::atomic<usize> next = 0;
+    std::vector<std::thread> pool;
+    for (usize i = 0; i < jobs; i++) {
+        pool.emplace_back([&]() {
+            for (usize index = next++; index < sources.size(); index = next++) {
+                reports[index] = cook(sources[index], lock);
+            }
+        });
+    }
+
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    lock.save();
+    report(reports);
+
+    const bool failed =
+        std::any_of(reports.begin(), reports.end(), [](const CookReport& r) { return r.status == CookReport::Failed; });
+    return failed ? 1 : 0;
+}
+
+std::vector<std::filesystem::path> Cooker::collect() const {
+    std::vector<std::filesystem::path> sources;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(m_spec.directory)) {
+        const std::filesystem::path& path = entry.path();
+        if (entry.is_regular_file() && (path.extension() == ".gltf" || path.extension() == ".glb")) {
+            sources.push_back(path);
+        }
+    }
+    std::sort(sources.begin(), sources.end());
+
+    return sources;
+}
+
+CookReport Cooker::cook(const std::filesystem::path& source, Lock& lock) const {
+    CookReport report = {.source = source};
+    const auto start = std::chrono::steady_clock::now();
+
+    try {
+        const std::filesystem::path baked = asset::bakedPath(source);
+        const std::string key = std::filesystem::relative(source, m_spec.directory).generic_string();
+        const uint64 hash = local::contentHash(source, m_spec.optimize, m_spec.lods);
+
+        if (!m_spec.force && lock.isValid(key, hash) && std::filesystem::exists(baked)) {
+            // sources copied over by the build are newer than the bake while their content is not
+            if (!asset::hasBaked(source)) {
+                std::filesystem::last_write_time(baked, std::filesystem::file_time_type::clock::now());
+            }
+            report.status = CookReport::UpToDate;
+        } else {
+            const ModelDecoderSpecification decoderSpecification = {
+                .optimize = m_spec.optimize,
+                .weld = m_spec.optimize,
+                .lods = std::min(m_spec.lods, uint32(MAX_LODS - 1)),
+            };
+            asset::write(ModelDecoder(decoderSpecification).decode(source), baked);
+            lock.update(key, hash);
+            report.status = CookReport::Cooked;
+        }
+
+        // read the bake back, validating it and filling in the report
+        const ModelData data = asset::read(baked);
+        report.meshes = data.meshes.size();
+        for (const MeshData& mesh : data.meshes) {
+            report.vertices += mesh.vertices.size();
+            report.indices += mesh.indexCount();
+        }
+        for (const TextureData& texture : data.textures) {
+            report.textureBytes += texture.pixels.size();
+        }
+        report.bytes = std::filesystem::file_size(baked);
+    } catch (const std::exception& e) {
+        report.status = CookReport::Failed;
+        report.error = e.what();
+    }
+
+    report.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void Cooker::report(std::span<const CookReport> reports) const {
+    static constexpr std::array<const char*, 3> STATUS = {"cooked", "up to date", "FAILED"};
+
+    std::cout << std::left << std::setw(48) << "asset" << std::setw(12) << "status" << std::right << std::setw(8)
+              << "meshes" << std::setw(12) << "vertices" << std::setw(12) << "indices" << std::setw(16)
+              << "texture bytes" << std::setw(16) << "asset bytes" << std::setw(12) << "ms" << '\n';
+
+    CookReport total;
+    for (const CookReport& r : reports) {
+        const std::string key = std::filesystem::relative(r.source, m_spec.directory).generic_string();
+
+        std::cout << std::left << std::setw(48) << key << std::setw(12) << STATUS[r.status] << std::right
+                  << std::setw(8) << r.meshes << std::setw(12) << r.vertices << std::setw(12) << r.indices
+                  << std::setw(16) << r.textureBytes << std::setw(16) << r.bytes << std::setw(12) << std::fixed
+                  << std::setprecision(1) << r.milliseconds << '\n';
+
+        if (r.status == CookReport::Failed) {
+            std::cout << "    " << r.error << '\n';
+        }
+
+        total.meshes += r.meshes;
+        total.vertices += r.vertices;
+        total.indices += r.indices;
+        total.textureBytes += r.textureBytes;
+        total.bytes += r.bytes;
+        total.milliseconds += r.milliseconds;
+    }
+
+    std::cout << std::left << std::setw(60) << "total" << std::right << std::setw(8) << total.meshes << std::setw(12)
+              << total.vertices << std::setw(12) << total.indices << std::setw(16) << total.textureBytes
+              << std::setw(16) << total.bytes << std::setw(12) << std::fixed << std::setprecision(1)
+              << total.milliseconds << '\n';
+
+    if (m_spec.report.empty()) {
+        return;
+    }
+
+    std::ofstream csv(m_spec.report, std::ios::trunc);
+    csv << "asset,status,meshes,vertices,indices,texture_bytes,asset_bytes,ms\n";
+    for (const CookReport& r : reports) {
+        csv << std::filesystem::relative(r.source, m_spec.directory).generic_string() << ',' << STATUS[r.status]
+            << ',' << r.meshes << ',' << r.vertices << ',' << r.indices << ',' << r.textureBytes << ',' << r.bytes
+            << ',' << r.milliseconds << '\n';
+    }
+}
+
+} // namespace R3
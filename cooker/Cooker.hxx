@@ -0,0 +1,62 @@
+#pragma once
+
+/// @file Cooker.hxx
+/// @brief Offline cooker, bakes every glTF model below an asset directory into .r3asset files
+
+#include <R3>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace R3 {
+
+class Lock;
+
+/// @brief Cooker Specification
+struct CookerSpecification {
+    std::filesystem::path directory; ///< asset directory walked for .gltf and .glb models
+    std::filesystem::path report;    ///< optional csv report, empty to only print it
+    uint32 jobs;                     ///< worker threads, 0 for every hardware thread
+    bool force;                      ///< ignore the lock and cook every model
+    bool optimize;                   ///< run the mesh welding and optimization passes, see MeshOptimizer.hxx
+    uint32 lods;                     ///< coarser LODs generated per mesh, see MeshSimplifier.hxx
+};
+
+/// @brief Result of cooking a single model
+struct CookReport {
+    enum Status { Cooked, UpToDate, Failed };
+
+    std::filesystem::path source;
+    Status status = Failed;
+    usize meshes = 0;
+    usize vertices = 0;
+    usize indices = 0;
+    usize textureBytes = 0; ///< decoded RGBA8 bytes
+    usize bytes = 0;        ///< .r3asset file size
+    double milliseconds = 0.0;
+    std::string error;
+};
+
+/// @brief Cooker walks CookerSpecification::directory and bakes models across all worker threads
+/// Models whose content hash matches .asset.lock.json and whose .r3asset exists are skipped
+class Cooker {
+public:
+    /// @brief Construct Cooker from spec
+    /// @param spec
+    Cooker(const CookerSpecification& spec);
+
+    /// @brief Cook every out of date model and print the report
+    /// @return process exit code, non zero if any model failed
+    int run();
+
+private:
+    [[nodiscard]] std::vector<std::filesystem::path> collect() const;
+    [[nodiscard]] CookReport cook(const std::filesystem::path& source, Lock& lock) const;
+    void report(std::span<const CookReport> reports) const;
+
+private:
+    CookerSpecification m_spec;
+};
+
+} // namespace R3
@@ -0,0 +1,78 @@
+#include "Lock.hxx"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace R3 {
+
+Lock::Lock(const std::filesystem::path& path)
+    : m_path(path) {
+    std::ifstream ifs(m_path);
+    if (!ifs.is_open()) {
+        LOG(Info, "creating new", m_path.filename());
+        return;
+    }
+
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    const std::string json = ss.str();
+
+    rapidjson::Document document;
+    document.Parse(json.c_str(), json.size());
+    if (document.HasParseError() || !document.IsObject()) {
+        LOG(Warning, "invalid", m_path, "every asset will be cooked");
+        return;
+    }
+
+    for (auto it = document.MemberBegin(); it != document.MemberEnd(); ++it) {
+        if (!it->value.IsString()) {
+            continue;
+        }
+
+        const char* first = it->value.GetString();
+        const char* last = first + it->value.GetStringLength();
+
+        uint64 hash = 0;
+        if (std::from_chars(first, last, hash, 16).ec == std::errc()) {
+            m_data.emplace(it->name.GetString(), hash);
+        }
+    }
+}
+
+bool Lock::isValid(const std::string& key, uint64 hash) const {
+    std::scoped_lock lock(m_mutex);
+    auto it = m_data.find(key);
+    return it != m_data.end() && it->second == hash;
+}
+
+void Lock::update(const std::string& key, uint64 hash) {
+    std::scoped_lock lock(m_mutex);
+    m_data[key] = hash;
+}
+
+void Lock::save() const {
+    std::scoped_lock lock(m_mutex);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.SetIndent(' ', 2);
+
+    writer.StartObject();
+    for (const auto& [key, hash] : m_data) {
+        char hex[17] = {};
+        std::to_chars(hex, hex + 16, hash, 16);
+
+        writer.Key(key.c_str(), rapidjson::SizeType(key.size()));
+        writer.String(hex);
+    }
+    writer.EndObject();
+
+    std::ofstream ofs(m_path, std::ios::trunc);
+    ofs << buffer.GetString() << '\n';
+}
+
+} // namespace R3
@@ -0,0 +1,42 @@
+#pragma once
+
+/// @file Lock.hxx
+/// @brief Content hash cache of cooked assets, the C++ counterpart of .shader.lock.json in compile_shaders.py
+
+#include <R3>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace R3 {
+
+/// @brief Maps an asset key to the content hash it was last cooked from
+/// Safe to query and update from multiple cooking threads
+class Lock {
+public:
+    /// @brief Read lock from path, starts empty if path does not exist or cannot be parsed
+    /// @param path
+    explicit Lock(const std::filesystem::path& path);
+
+    /// @brief Query if key was last cooked from content with this hash
+    /// @param key
+    /// @param hash
+    /// @return true if key does not need to be cooked again
+    [[nodiscard]] bool isValid(const std::string& key, uint64 hash) const;
+
+    /// @brief Record the hash key was cooked from
+    /// @param key
+    /// @param hash
+    void update(const std::string& key, uint64 hash);
+
+    /// @brief Write lock back to the path it was read from
+    void save() const;
+
+private:
+    std::filesystem::path m_path;
+    std::unordered_map<std::string, uint64> m_data;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace R3
@@ -0,0 +1,61 @@
+#include "Cooker.hxx"
+
+#include <R3>
+#include <charconv>
+#include <iostream>
+#include <string_view>
+
+static void usage() {
+    std::cout << "usage: R3_ASSET_COOKER <asset directory> "
+                 "[--force|-f] [--jobs|-j N] [--report <file.csv>] [--no-optimize] [--lods N]\n";
+}
+
+// N of --jobs and --lods, the whole argument must be an unsigned number
+static bool parse(std::string_view value, R3::uint32& out) {
+    const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), out);
+    return ec == std::errc() && end == value.data() + value.size();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    R3::CookerSpecification spec = {
+        .directory = argv[1],
+        .report = {},
+        .jobs = 0,
+        .force = false,
+        .optimize = true,
+        .lods = 3,
+    };
+
+    for (int i = 2; i < argc; i++) {
+        std::string_view arg = argv[i];
+
+        if (arg == "--force" || arg == "-f") {
+            spec.force = true;
+        } else if ((arg == "--jobs" || arg == "-j") && i + 1 < argc) {
+            if (!parse(argv[++i], spec.jobs)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--lods" && i + 1 < argc) {
+            if (!parse(argv[++i], spec.lods)) {
+                usage();
+                return 1;
+            }
+        } else if (arg == "--no-optimize") {
+            spec.optimize = false;
+        } else if (arg == "--report" && i + 1 < argc) {
+            spec.report = argv[++i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    R3::Cooker cooker(spec);
+    return cooker.run();
+}
@@ -1,20 +1,16 @@
 #include "components/ModelComponent.hpp"
 
 #include "core/Engine.hpp"
-#include "core/Scene.hpp"
-#include "systems/AnimationSystem.hpp"
+#include "media/asset/Asset.hxx"
 
 namespace R3 {
 
-ModelComponent::ModelComponent(const std::string& path) {
-    EngineInstance->renderer().modelLoader().load(path, *this);
-    if (!animation.keyFrames.empty()) {
-        Scene::addSystem<AnimationSystem>();
-
-        for (auto& keyFrame : animation.keyFrames) {
-            animation.maxTime = std::max(keyFrame.timestamp, animation.maxTime);
-        }
-    }
+ModelComponent::ModelComponent(const std::string& path)
+    : status(ModelStatus::Pending) {
+    // prefer a baked asset when it is up to date with its source
+    const std::filesystem::path source = path;
+    const std::filesystem::path file = asset::hasBaked(source) ? asset::bakedPath(source) : source;
+    load = EngineInstance->renderer().modelLoader().loadAsync(file);
 }
 
 } // namespace R3
@@ -0,0 +1,94 @@
+#pragma once
+
+/// @file BoundedQueue.hxx
+/// @brief Blocking FIFO of limited capacity, linking the stages of a pipeline running on different threads
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include "api/Check.hpp"
+#include "api/Construct.hpp"
+#include "api/Types.hpp"
+
+namespace R3 {
+
+/// @brief Multi producer, multi consumer queue holding at most capacity items
+/// push blocks while the queue is full and pop blocks while it is empty, until the queue is closed
+template <typename T>
+class BoundedQueue {
+public:
+    NO_COPY(BoundedQueue);
+    NO_MOVE(BoundedQueue);
+
+    /// @brief Construct an empty queue
+    /// @param capacity items held before push blocks
+    explicit BoundedQueue(usize capacity)
+        : m_capacity(capacity) {
+        CHECK(capacity > 0);
+    }
+
+    /// @brief Append item, waiting for room
+    /// @param item
+    /// @return false if the queue was closed, item is dropped
+    bool push(T item) {
+        std::unique_lock lock(m_mutex);
+        m_notFull.wait(lock, [this]() { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed) {
+            return false;
+        }
+        m_items.push_back(std::move(item));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    /// @brief Remove the oldest item, waiting for one
+    /// @return item, nullopt once the queue is closed and drained
+    std::optional<T> pop() {
+        std::unique_lock lock(m_mutex);
+        m_notEmpty.wait(lock, [this]() { return m_closed || !m_items.empty(); });
+        if (m_items.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return item;
+    }
+
+    /// @brief Remove the oldest item if there is one, without waiting
+    /// @return item, nullopt if the queue is empty
+    std::optional<T> tryPop() {
+        std::unique_lock lock(m_mutex);
+        if (m_items.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return item;
+    }
+
+    /// @brief Refuse further pushes and wake every waiting thread, queued items can still be popped
+    void close() {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+    std::deque<T> m_items;
+    usize m_capacity;
+    bool m_closed = false;
+};
+
+} // namespace R3
@@ -13,9 +13,10 @@ Engine* EngineInstance = nullptr;
 Scene* CurrentScene = nullptr;
 
 #if not R3_DLL_IMPL
-Engine::Engine()
+Engine::Engine(const EngineSpecification& spec)
     : m_window({"R3"}),
-      m_renderer({m_window}) {
+      m_threadPool(spec.workerThreads),
+      m_renderer({m_window, m_threadPool}) {
     profiler::startListen(8080);
 }
 #endif
@@ -37,6 +38,10 @@ EngineStatusCode Engine::loop(const char* dlName) {
     while ((!m_window.shouldClose() && code == EngineStatusCode::Success) || !Scene::isEventQueueEmpty()) {
         double dt = deltaTime();
 
+        EASY_BLOCK("ModelLoader::update");
+        m_renderer.modelLoader().update();
+        EASY_END_BLOCK;
+
         EASY_BLOCK("Scene::dispatchEvents");
         Scene::dispatchEvents();
         EASY_END_BLOCK;
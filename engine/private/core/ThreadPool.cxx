@@ -0,0 +1,62 @@
+#include "core/ThreadPool.hpp"
+
+#include <algorithm>
+#include "api/Log.hpp"
+
+namespace R3 {
+
+ThreadPool::ThreadPool(uint32 threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    m_threads.reserve(threadCount);
+    for (uint32 i = 0; i < threadCount; i++) {
+        m_threads.emplace_back([this]() { work(); });
+    }
+
+    LOG(Verbose, "thread pool started with", threadCount, "workers");
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) {
+                return; // stopping and drained
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG(Error, "thread pool task failed", e.what());
+        }
+    }
+}
+
+} // namespace R3
@@ -10,6 +10,7 @@
 #include <glm/gtx/quaternion.hpp>
 #include <vulkan/vulkan.hpp>
 #include "components/EditorComponent.hpp"
+#include "components/ModelComponent.hpp"
 
 namespace R3::editor {
 
@@ -113,6 +114,61 @@ void Editor::displayDeltaTime(double dt) {
     ImGui::End();
 }
 
+void Editor::displayFrameStats(const FrameStats& stats) {
+    ImGui::Begin("Frame Stats", nullptr, GUI_BOARDERLESS);
+    ImGui::SetWindowPos(ImVec2(10, 30));
+    ImGui::Text("%u draws, %llu triangles", stats.draws, (unsigned long long)stats.triangles);
+    ImGui::Text("%u pipeline binds", stats.pipelineBinds);
+    for (usize i = 0; i < std::size(stats.lodDraws); i++) {
+        if (stats.lodDraws[i] != 0) {
+            ImGui::Text("LOD %zu: %u draws", i, stats.lodDraws[i]);
+        }
+    }
+    ImGui::End();
+}
+
+void Editor::displayTextureCache(const TextureCacheStats& stats) {
+    if (ImGui::Begin("Texture Cache")) {
+        const uint64 acquires = stats.hits + stats.misses;
+        const double hitRate = acquires ? double(stats.hits) / double(acquires) * 100.0 : 0.0;
+        ImGui::Text("%.1f%% hit rate (%llu / %llu)",
+                    hitRate,
+                    (unsigned long long)stats.hits,
+                    (unsigned long long)acquires);
+        ImGui::Text("%zu resident textures, %.2f MiB", stats.residentCount, double(stats.residentBytes) / (1 << 20));
+    }
+    ImGui::End();
+}
+
+void Editor::displayMemory(const MemoryStats& stats) {
+    if (ImGui::Begin("GPU Memory")) {
+        ImGui::Text("%u / %u device allocations", stats.deviceAllocations, stats.maxDeviceAllocations);
+        for (usize i = 0; i < stats.heaps.size(); i++) {
+            const MemoryHeapStats& heap = stats.heaps[i];
+            if (heap.blocks == 0) {
+                continue;
+            }
+
+            // free memory that cannot hold a resource as large as all of it
+            const usize free = heap.reserved - heap.used;
+            const double fragmentation = free ? (1.0 - double(heap.largestFree) / double(free)) * 100.0 : 0.0;
+
+            ImGui::SeparatorText(heap.deviceLocal ? "Device Local" : "Host");
+            ImGui::Text("heap %zu, %.1f MiB", i, double(heap.size) / (1 << 20));
+            ImGui::ProgressBar(heap.reserved ? float(double(heap.used) / double(heap.reserved)) : 0.0f);
+            ImGui::Text("%.2f / %.2f MiB used, %u resources in %u allocations",
+                        double(heap.used) / (1 << 20),
+                        double(heap.reserved) / (1 << 20),
+                        heap.allocations,
+                        heap.blocks);
+            ImGui::Text("%.1f%% fragmented, largest free range %.2f MiB",
+                        fragmentation,
+                        double(heap.largestFree) / (1 << 20));
+        }
+    }
+    ImGui::End();
+}
+
 void Editor::initializeDocking() {
     static constexpr ImGuiDockNodeFlags dockspaceFlags =
         ImGuiDockNodeFlags_PassthruCentralNode | (int)ImGuiDockNodeFlags_NoWindowMenuButton;
@@ -198,6 +254,28 @@ void Editor::displayProperties() {
             transform = transform * rotationMatrix;
             transform[3] += vec4(deltaPosition, 0.0f);
             transform = glm::scale(transform, deltaScale);
+
+            // Edit level of detail
+            if (auto* model = entityView.tryGet<ModelComponent>()) {
+                LodSettings& lodSettings = model->lodSettings;
+                ImGui::Separator();
+                ImGui::Text("level of detail");
+                ImGui::DragFloat("threshold (px)", &lodSettings.threshold, 0.05f, 0.0f, 64.0f, "%.2f");
+                ImGui::SliderFloat("hysteresis", &lodSettings.hysteresis, 0.0f, 0.9f, "%.2f");
+                const char* forcedFormat = lodSettings.forced < 0 ? "auto" : "%d";
+                ImGui::SliderInt("forced", &lodSettings.forced, -1, MAX_LODS - 1, forcedFormat);
+
+                for (usize i = 0; model->status == ModelStatus::Ready && i < model->meshes.size(); i++) {
+                    const Mesh& mesh = model->resource->meshes[i];
+                    const uint32 lod = model->meshes[i].lod;
+                    if (mesh.lods.empty()) {
+                        continue;
+                    }
+                    const uint32 count = std::visit([](const auto& indexBuffer) { return indexBuffer.count(); },
+                                                    mesh.lods[lod].indexBuffer);
+                    ImGui::Text("mesh %zu: LOD %u/%zu, %u triangles", i, lod, mesh.lods.size() - 1, count / 3);
+                }
+            }
         }
     }
     ImGui::End();
@@ -0,0 +1,70 @@
+#pragma once
+
+/// @file MappedFile.hxx
+/// @brief Memory mapped view of a file on disk
+
+#include <filesystem>
+#include <span>
+#include "api/Check.hpp"
+#include "api/Construct.hpp"
+#include "api/Types.hpp"
+
+namespace R3 {
+
+/// @brief Memory mapping of an entire file, never written back to disk
+/// The mapping is released on destruction, any span handed out by bytes() is invalidated with it
+class MappedFile {
+public:
+    /// @brief How the mapping may be accessed
+    enum class Access {
+        Read,        ///< read-only
+        CopyOnWrite, ///< writable, written pages become private copies and the file is left untouched
+    };
+
+public:
+    DEFAULT_CONSTRUCT(MappedFile);
+    NO_COPY(MappedFile);
+
+    /// @brief Map the file at path into memory, throws if the file cannot be opened or mapped
+    /// @param path
+    /// @param access
+    explicit MappedFile(const std::filesystem::path& path, Access access = Access::Read);
+
+    MappedFile(MappedFile&& src) noexcept;
+    MappedFile& operator=(MappedFile&& src) noexcept;
+
+    ~MappedFile();
+
+    /// @brief Query the mapped bytes
+    /// @return view of the entire file
+    [[nodiscard]] std::span<const std::byte> bytes() const { return {m_data, m_size}; }
+
+    /// @brief Query the mapped bytes for writing, only valid for Access::CopyOnWrite
+    /// @return view of the entire file
+    [[nodiscard]] std::span<std::byte> mutableBytes() {
+        CHECK(m_access == Access::CopyOnWrite);
+        return {m_data, m_size};
+    }
+
+    /// @brief Query the start of the mapping
+    /// @return pointer to the first byte, nullptr if nothing is mapped
+    [[nodiscard]] constexpr const std::byte* data() const { return m_data; }
+
+    /// @brief Query the size of the mapping
+    /// @return size in bytes
+    [[nodiscard]] constexpr usize size() const { return m_size; }
+
+private:
+    void release();
+
+private:
+    std::byte* m_data = nullptr;
+    usize m_size = 0;
+    Access m_access = Access::Read;
+#if _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
+
+} // namespace R3
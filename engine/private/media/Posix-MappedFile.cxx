@@ -0,0 +1,72 @@
+#if !_WIN32
+
+#include "media/MappedFile.hxx"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include "api/Ensure.hpp"
+
+namespace R3 {
+
+MappedFile::MappedFile(const std::filesystem::path& path, Access access)
+    : m_access(access) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    ENSURE(fd != -1);
+
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        ENSURE(false);
+    }
+
+    m_size = usize(st.st_size);
+
+    // mmap of length 0 is invalid, an empty file is just an empty view
+    if (m_size != 0) {
+        const int prot = access == Access::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* addr = ::mmap(nullptr, m_size, prot, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            ENSURE(false);
+        }
+        ::madvise(addr, m_size, MADV_WILLNEED);
+        m_data = static_cast<std::byte*>(addr);
+    }
+
+    // the mapping holds its own reference to the file
+    ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& src) noexcept
+    : m_data(std::exchange(src.m_data, nullptr)),
+      m_size(std::exchange(src.m_size, 0)),
+      m_access(src.m_access) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& src) noexcept {
+    if (this != &src) {
+        release();
+        m_data = std::exchange(src.m_data, nullptr);
+        m_size = std::exchange(src.m_size, 0);
+        m_access = src.m_access;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() {
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
+
+} // namespace R3
+
+#endif // !_WIN32
@@ -0,0 +1,92 @@
+#if _WIN32
+
+#include "media/MappedFile.hxx"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <utility>
+#include "api/Ensure.hpp"
+
+namespace R3 {
+
+MappedFile::MappedFile(const std::filesystem::path& path, Access access)
+    : m_access(access) {
+    HANDLE file = CreateFileW(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    ENSURE(file != INVALID_HANDLE_VALUE);
+    m_fileHandle = file;
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(file, &size)) {
+        release();
+        ENSURE(false);
+    }
+
+    m_size = usize(size.QuadPart);
+
+    // CreateFileMapping fails on empty files, an empty file is just an empty view
+    if (m_size != 0) {
+        const DWORD protect = access == Access::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY;
+        m_mappingHandle = CreateFileMappingW(file, nullptr, protect, 0, 0, nullptr);
+        if (m_mappingHandle == nullptr) {
+            release();
+            ENSURE(false);
+        }
+
+        const DWORD desiredAccess = access == Access::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+        m_data = static_cast<std::byte*>(MapViewOfFile(m_mappingHandle, desiredAccess, 0, 0, 0));
+        if (m_data == nullptr) {
+            release();
+            ENSURE(false);
+        }
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& src) noexcept
+    : m_data(std::exchange(src.m_data, nullptr)),
+      m_size(std::exchange(src.m_size, 0)),
+      m_access(src.m_access),
+      m_fileHandle(std::exchange(src.m_fileHandle, nullptr)),
+      m_mappingHandle(std::exchange(src.m_mappingHandle, nullptr)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& src) noexcept {
+    if (this != &src) {
+        release();
+        m_data = std::exchange(src.m_data, nullptr);
+        m_size = std::exchange(src.m_size, 0);
+        m_access = src.m_access;
+        m_fileHandle = std::exchange(src.m_fileHandle, nullptr);
+        m_mappingHandle = std::exchange(src.m_mappingHandle, nullptr);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() {
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_mappingHandle != nullptr) {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle != nullptr) {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+    m_size = 0;
+}
+
+} // namespace R3
+
+#endif // _WIN32
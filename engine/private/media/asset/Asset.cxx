@@ -0,0 +1,408 @@
+#include "media/asset/Asset.hxx"
+
+#include <rapidjson/document.h>
+#include <stb_image.h>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include "api/Check.hpp"
+#include "api/Ensure.hpp"
+#include "api/Log.hpp"
+#include "media/MappedFile.hxx"
+#include "media/ktx2/Ktx2.hxx"
+#include "media/mip/MipChain.hxx"
+
+namespace R3::asset {
+
+static_assert(std::is_trivially_copyable_v<Vertex>);
+static_assert(std::is_trivially_copyable_v<KeyFrame>);
+
+namespace local {
+
+// appends aligned blobs to an in memory image of the file, records are reserved first and patched once known
+class Writer {
+public:
+    usize reserve(usize size) {
+        const usize offset = (m_bytes.size() + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        m_bytes.resize(offset + size);
+        return offset;
+    }
+
+    usize append(const void* data, usize size) {
+        const usize offset = reserve(size);
+        if (size != 0) {
+            std::memcpy(m_bytes.data() + offset, data, size);
+        }
+        return offset;
+    }
+
+    template <typename T>
+    usize append(std::span<const T> data) {
+        return append(data.data(), data.size_bytes());
+    }
+
+    template <typename T>
+    void patch(usize offset, const T& value) {
+        std::memcpy(m_bytes.data() + offset, &value, sizeof(T));
+    }
+
+    [[nodiscard]] constexpr const std::vector<std::byte>& bytes() const { return m_bytes; }
+
+private:
+    std::vector<std::byte> m_bytes;
+};
+
+// texture as uploaded, KTX2 levels are kept as stored and any other image is decoded to an RGBA8 mip chain
+struct Pixels {
+    std::vector<std::byte> bytes;
+    uint32 width = 0;
+    uint32 height = 0;
+    Format format = Format::R8G8B8A8Srgb;
+    uint32 mipLevels = 1;
+};
+
+static Pixels decodeTexture(const TextureData& texture) {
+    if (!texture.pixels.empty()) {
+        return {
+            .bytes = {texture.pixels.begin(), texture.pixels.end()},
+            .width = texture.width,
+            .height = texture.height,
+            .format = texture.format,
+            .mipLevels = texture.mipLevels,
+        };
+    }
+
+    MappedFile file;
+    std::span<const std::byte> encoded = texture.encoded;
+    if (!texture.path.empty()) {
+        file = MappedFile(texture.path);
+        encoded = file.bytes();
+    }
+    if (encoded.empty()) {
+        return {}; // unused texture slot
+    }
+
+    Pixels pixels;
+
+    if (ktx2::isKtx2(encoded)) {
+        std::optional<ktx2::Texture> stored = ktx2::read(encoded);
+        if (!stored) {
+            LOG(Error, "unsupported KTX2 texture", texture.path);
+            ENSURE(false);
+        }
+        for (const std::span<const std::byte> level : stored->levels) {
+            pixels.bytes.insert(pixels.bytes.end(), level.begin(), level.end());
+        }
+        pixels.width = stored->width;
+        pixels.height = stored->height;
+        pixels.format = stored->format;
+        pixels.mipLevels = uint32(stored->levels.size());
+        return pixels;
+    }
+
+    int32 w = 0;
+    int32 h = 0;
+    int32 channels = 0;
+    stbi_uc* decoded = stbi_load_from_memory(
+        std::bit_cast<const stbi_uc*>(encoded.data()), int32(encoded.size()), &w, &h, &channels, STBI_rgb_alpha);
+
+    if (decoded == nullptr) {
+        LOG(Error, "failed to decode texture", texture.path, stbi_failure_reason());
+        ENSURE(false);
+    }
+
+    const std::byte* bytes = std::bit_cast<const std::byte*>(decoded);
+    pixels.bytes.assign(bytes, bytes + usize(w) * usize(h) * 4);
+    pixels.width = uint32(w);
+    pixels.height = uint32(h);
+    stbi_image_free(decoded);
+
+    // baked here once so loading uploads every level instead of blitting the chain on the GPU
+    pixels.mipLevels = mip::generate(pixels.bytes, pixels.width, pixels.height, pixels.format == Format::R8G8B8A8Srgb);
+
+    return pixels;
+}
+
+} // namespace local
+
+std::vector<std::filesystem::path> dependencies(const std::filesystem::path& source) {
+    std::vector<std::filesystem::path> paths = {source};
+    if (source.extension() != ".gltf") {
+        return paths; // glb embeds its buffers and images
+    }
+
+    std::ifstream ifs(source, std::ios::ate | std::ios::binary);
+    if (!ifs.is_open()) {
+        return paths;
+    }
+    std::string json(usize(ifs.tellg()), '\0');
+    ifs.seekg(0);
+    ifs.read(json.data(), std::streamsize(json.size()));
+
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    if (!ifs || document.HasParseError() || !document.IsObject()) {
+        return paths;
+    }
+
+    for (const char* member : {"buffers", "images"}) {
+        const auto array = document.FindMember(member);
+        if (array == document.MemberEnd() || !array->value.IsArray()) {
+            continue;
+        }
+        for (const auto& element : array->value.GetArray()) {
+            const auto uri = element.IsObject() ? element.FindMember("uri") : element.MemberEnd();
+            if (uri == element.MemberEnd() || !uri->value.IsString()) {
+                continue;
+            }
+            const std::string_view value(uri->value.GetString(), uri->value.GetStringLength());
+            if (!value.starts_with("data:")) {
+                paths.push_back(source.parent_path() / value);
+            }
+        }
+    }
+    return paths;
+}
+
+std::filesystem::path bakedPath(const std::filesystem::path& source) {
+    std::filesystem::path path = source;
+    return path.replace_extension(EXTENSION);
+}
+
+bool hasBaked(const std::filesystem::path& source) {
+    std::error_code ec;
+
+    const std::filesystem::path baked = bakedPath(source);
+    if (!std::filesystem::exists(baked, ec)) {
+        return false;
+    }
+
+    // a file of another format version is never loaded, the source is read until it is baked again
+    Header header = {};
+    std::ifstream ifs(baked, std::ios::binary);
+    if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != MAGIC ||
+        header.version != VERSION) {
+        return false;
+    }
+
+    if (!std::filesystem::exists(source, ec)) {
+        return true; // shipped without the source
+    }
+
+    const auto bakedTime = std::filesystem::last_write_time(baked, ec);
+    for (const std::filesystem::path& dependency : dependencies(source)) {
+        const auto time = std::filesystem::last_write_time(dependency, ec);
+        if (!ec && time > bakedTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+usize write(const ModelData& data, const std::filesystem::path& path) {
+    local::Writer writer;
+
+    const usize headerOffset = writer.reserve(sizeof(Header));
+    Header header = {
+        .magic = MAGIC,
+        .version = VERSION,
+        .size = 0,
+        .meshCount = uint32(data.meshes.size()),
+        .textureCount = uint32(data.textures.size()),
+        .jointCount = uint32(data.skeleton.joints.size()),
+        .keyFrameCount = uint32(data.keyFrames.size()),
+        .meshes = 0,
+        .textures = 0,
+        .joints = 0,
+        .keyFrames = 0,
+    };
+
+    //--- Meshes
+    header.meshes = writer.reserve(sizeof(MeshRecord) * data.meshes.size());
+    for (usize i = 0; const MeshData& mesh : data.meshes) {
+        std::vector<uint32> textureIndices(mesh.textureIndices.begin(), mesh.textureIndices.end());
+
+        auto append = [&](const IndexData& indices) {
+            return std::visit([&](auto view) { return writer.append(view); }, indices);
+        };
+
+        std::vector<LodRecord> lods;
+        for (const LodData& lod : mesh.lods) {
+            CHECK(lod.indices.index() == mesh.indices.index());
+            lods.push_back({
+                .indices = append(lod.indices),
+                .indexCount = uint32(std::visit([](auto view) { return view.size(); }, lod.indices)),
+                .error = lod.error,
+            });
+        }
+
+        const MeshRecord record = {
+            .vertices = writer.append(mesh.vertices),
+            .indices = append(mesh.indices),
+            .lods = writer.append(std::span<const LodRecord>(lods)),
+            .textureIndices = writer.append(std::span<const uint32>(textureIndices)),
+            .vertexCount = uint32(mesh.vertices.size()),
+            .indexCount = uint32(mesh.indexCount()),
+            .lodCount = uint32(lods.size()),
+            .textureIndexCount = uint32(textureIndices.size()),
+            .indexSize = std::holds_alternative<std::span<const uint16>>(mesh.indices) ? 2u : 4u,
+            .padding = 0,
+        };
+        writer.patch(header.meshes + sizeof(MeshRecord) * i++, record);
+    }
+
+    //--- Textures
+    header.textures = writer.reserve(sizeof(TextureRecord) * data.textures.size());
+    for (usize i = 0; const TextureData& texture : data.textures) {
+        const local::Pixels pixels = local::decodeTexture(texture);
+
+        const TextureRecord record = {
+            .pixels = pixels.bytes.empty() ? 0 : writer.append(std::span<const std::byte>(pixels.bytes)),
+            .size = pixels.bytes.size(),
+            .width = pixels.width,
+            .height = pixels.height,
+            .type = uint32(texture.type),
+            .format = uint32(pixels.format),
+            .mipLevels = pixels.mipLevels,
+            .padding = 0,
+        };
+        writer.patch(header.textures + sizeof(TextureRecord) * i++, record);
+    }
+
+    //--- Skeleton
+    header.joints = writer.reserve(sizeof(JointRecord) * data.skeleton.joints.size());
+    for (usize i = 0; const Joint& joint : data.skeleton.joints) {
+        std::vector<uint64> children(joint.children.begin(), joint.children.end());
+
+        const JointRecord record = {
+            .undeformedMatrix = joint.undeformedMatrix,
+            .inverseBindMatrix = joint.inverseBindMatrix,
+            .deformedRotation = joint.deformedRotation,
+            .deformedTranslation = joint.deformedTranslation,
+            .deformedScale = joint.deformedScale,
+            .rootIndex = joint.rootIndex,
+            .parentJoint = joint.parentJoint,
+            .children = writer.append(std::span<const uint64>(children)),
+            .childCount = uint32(children.size()),
+            .padding = 0,
+        };
+        writer.patch(header.joints + sizeof(JointRecord) * i++, record);
+    }
+
+    //--- KeyFrames
+    header.keyFrames = writer.append(std::span<const KeyFrame>(data.keyFrames));
+
+    header.size = writer.bytes().size();
+    writer.patch(headerOffset, header);
+
+    // write next to the destination and rename, a reader never sees a partially written asset
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+        ENSURE(ofs.is_open());
+        ofs.write((const char*)writer.bytes().data(), std::streamsize(writer.bytes().size()));
+        ENSURE(ofs.good());
+    }
+    std::filesystem::rename(tmp, path);
+
+    return writer.bytes().size();
+}
+
+ModelData read(const std::filesystem::path& path) {
+    auto file = std::make_shared<const MappedFile>(path);
+    const std::span<const std::byte> bytes = file->bytes();
+
+    Header header = {};
+    ENSURE(bytes.size() >= sizeof(Header));
+    std::memcpy(&header, bytes.data(), sizeof(Header));
+
+    ENSURE(header.magic == MAGIC);
+    if (header.version != VERSION) {
+        LOG(Error, path, "is r3asset version", header.version, "while R3 reads version", VERSION);
+        ENSURE(false);
+    }
+    ENSURE(header.size == bytes.size());
+
+    // every offset is aligned and the mapping is page aligned, so records and blobs can be viewed in place
+    auto view = [&]<typename T>(uint64 offset, usize count) -> std::span<const T> {
+        ENSURE(offset % alignof(T) == 0 && offset + count * sizeof(T) <= bytes.size());
+        return {reinterpret_cast<const T*>(bytes.data() + offset), count};
+    };
+
+    ModelData data;
+
+    //--- Meshes
+    data.meshes.reserve(header.meshCount);
+    for (const MeshRecord& record : view.template operator()<MeshRecord>(header.meshes, header.meshCount)) {
+        const std::span<const uint32> textureIndices =
+            view.template operator()<uint32>(record.textureIndices, record.textureIndexCount);
+        for (const uint32 index : textureIndices) {
+            ENSURE(index < header.textureCount);
+        }
+
+        ENSURE(record.indexSize == sizeof(uint16) || record.indexSize == sizeof(uint32));
+        auto indices = [&](uint64 offset, usize count) -> IndexData {
+            if (record.indexSize == sizeof(uint16)) {
+                return view.template operator()<uint16>(offset, count);
+            }
+            return view.template operator()<uint32>(offset, count);
+        };
+
+        MeshData& mesh = data.meshes.emplace_back(MeshData{
+            .vertices = view.template operator()<Vertex>(record.vertices, record.vertexCount),
+            .indices = indices(record.indices, record.indexCount),
+            .lods = {},
+            .textureIndices = {textureIndices.begin(), textureIndices.end()},
+        });
+        for (const LodRecord& lod : view.template operator()<LodRecord>(record.lods, record.lodCount)) {
+            mesh.lods.push_back({indices(lod.indices, lod.indexCount), lod.error});
+        }
+    }
+
+    //--- Textures
+    data.textures.reserve(header.textureCount);
+    for (const TextureRecord& record : view.template operator()<TextureRecord>(header.textures, header.textureCount)) {
+        TextureData& texture = data.textures.emplace_back();
+        if (record.pixels != 0) {
+            texture.format = Format(record.format);
+            texture.mipLevels = record.mipLevels;
+            ENSURE(record.size == ktx2::chainSize(texture.format, record.width, record.height, record.mipLevels));
+            texture.pixels = view.template operator()<std::byte>(record.pixels, record.size);
+            texture.width = record.width;
+            texture.height = record.height;
+        }
+        texture.type = TextureType(record.type);
+    }
+
+    //--- Skeleton
+    data.skeleton.joints.resize(header.jointCount);
+    data.skeleton.finalJointsMatrices.resize(header.jointCount);
+    const std::span<const JointRecord> joints = view.template operator()<JointRecord>(header.joints, header.jointCount);
+    for (usize i = 0; const JointRecord& record : joints) {
+        const std::span<const uint64> children = view.template operator()<uint64>(record.children, record.childCount);
+
+        Joint& joint = data.skeleton.joints[i];
+        joint.rootIndex = record.rootIndex;
+        joint.undeformedMatrix = record.undeformedMatrix;
+        joint.inverseBindMatrix = record.inverseBindMatrix;
+        joint.deformedTranslation = record.deformedTranslation;
+        joint.deformedRotation = record.deformedRotation;
+        joint.deformedScale = record.deformedScale;
+        joint.parentJoint = record.parentJoint;
+        joint.children.assign(children.begin(), children.end());
+
+        data.skeleton.nodeToJointMap.emplace(joint.rootIndex, i++);
+    }
+
+    //--- KeyFrames
+    const std::span<const KeyFrame> keyFrames =
+        view.template operator()<KeyFrame>(header.keyFrames, header.keyFrameCount);
+    data.keyFrames.assign(keyFrames.begin(), keyFrames.end());
+
+    data.storage.emplace_back(std::move(file));
+
+    return data;
+}
+
+} // namespace R3::asset
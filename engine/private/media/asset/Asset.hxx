@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file Asset.hxx
+/// @brief R3 baked asset format (.r3asset)
+/// A single versioned file holding GPU ready vertex/index blobs, decoded textures, the skeleton and keyframes
+/// It is read through a memory mapping and uploaded without any parsing or decoding
+///
+/// Layout, every blob is aligned to ALIGNMENT
+///     Header
+///     MeshRecord[meshCount]       -> Vertex[], uint16|uint32 indices[], LodRecord[], uint32 textureIndices[]
+///     LodRecord[lodCount]         -> uint16|uint32 indices[]
+///     TextureRecord[textureCount] -> mip levels back to back, RGBA8 or the block compressed format of a KTX2 source
+///     JointRecord[jointCount]     -> uint64 children[]
+///     KeyFrame[keyFrameCount]
+
+#include <filesystem>
+#include <vector>
+#include "api/Api.hpp"
+#include "api/Types.hpp"
+#include "render/model/ModelData.hxx"
+
+namespace R3::asset {
+
+static constexpr uint32 MAGIC = 0x5341'3352; // "R3AS"
+static constexpr uint32 VERSION = 5;         // bump on any layout change, old files are then ignored
+static constexpr usize ALIGNMENT = 16;
+static constexpr const char* EXTENSION = ".r3asset";
+
+struct Header {
+    uint32 magic;
+    uint32 version;
+    uint64 size; // total file size in bytes
+    uint32 meshCount;
+    uint32 textureCount;
+    uint32 jointCount;
+    uint32 keyFrameCount;
+    uint64 meshes;    // offset of MeshRecord[meshCount]
+    uint64 textures;  // offset of TextureRecord[textureCount]
+    uint64 joints;    // offset of JointRecord[jointCount]
+    uint64 keyFrames; // offset of KeyFrame[keyFrameCount]
+};
+
+struct MeshRecord {
+    uint64 vertices;       // offset of Vertex[vertexCount]
+    uint64 indices;        // offset of uint16|uint32[indexCount]
+    uint64 lods;           // offset of LodRecord[lodCount]
+    uint64 textureIndices; // offset of uint32[textureIndexCount]
+    uint32 vertexCount;
+    uint32 indexCount;
+    uint32 lodCount;
+    uint32 textureIndexCount;
+    uint32 indexSize; // 2 or 4, shared by every LOD
+    uint32 padding;
+};
+
+struct LodRecord {
+    uint64 indices; // offset of uint16|uint32[indexCount]
+    uint32 indexCount;
+    float error;
+};
+
+struct TextureRecord {
+    uint64 pixels; // offset of mipLevels levels, 0 for an unused texture slot
+    uint64 size;   // byte size of pixels
+    uint32 width;  // of the largest level
+    uint32 height; // of the largest level
+    uint32 type;   // TextureType
+    uint32 format; // Format
+    uint32 mipLevels;
+    uint32 padding;
+};
+
+struct JointRecord {
+    mat4 undeformedMatrix;
+    mat4 inverseBindMatrix;
+    quat deformedRotation;
+    vec3 deformedTranslation;
+    vec3 deformedScale;
+    uint64 rootIndex;
+    uint64 parentJoint;
+    uint64 children; // offset of uint64[childCount]
+    uint32 childCount;
+    uint32 padding;
+};
+
+/// @brief Query the files a source model is decoded from
+/// @param source
+/// @return source and, for a .gltf, every external buffer and image uri it references, resolved next to source
+R3_API std::vector<std::filesystem::path> dependencies(const std::filesystem::path& source);
+
+/// @brief Query the baked asset path for a source model, eg Sponza.gltf -> Sponza.r3asset
+/// @param source
+/// @return path next to source
+R3_API std::filesystem::path bakedPath(const std::filesystem::path& source);
+
+/// @brief Query if a baked asset exists for source in the current VERSION, and is not older than the source or the
+/// buffers and images a .gltf source references
+/// @param source
+/// @return true if bakedPath(source) can be loaded in place of source
+R3_API bool hasBaked(const std::filesystem::path& source);
+
+/// @brief Serialize model data, textures given as path or encoded data are decoded to RGBA8
+/// @param data
+/// @param path
+/// @return total bytes written
+R3_API usize write(const ModelData& data, const std::filesystem::path& path);
+
+/// @brief Map a baked asset, throws if the file is not a valid .r3asset of this VERSION
+/// @param path
+/// @return model data viewing directly into the mapping, which it keeps alive
+R3_API ModelData read(const std::filesystem::path& path);
+
+} // namespace R3::asset
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <span>
+#include "api/Check.hpp"
+#include "api/Ensure.hpp"
+#include "glTF-Model.hxx"
+
+namespace R3::glTF {
+
+// size in bytes of an accessor componentType
+inline usize datatypeSize(uint32 datatype) {
+    switch (datatype) {
+        case UNSIGNED_BYTE:
+        case BYTE:
+            return sizeof(uint8);
+        case UNSIGNED_SHORT:
+        case SHORT:
+            return sizeof(uint16);
+        case UNSIGNED_INT:
+        case INT:
+            return sizeof(uint32);
+        case FLOAT:
+            return sizeof(float);
+        default:
+            ENSURE(false);
+    }
+}
+
+// number of components in an accessor type
+inline usize componentElements(std::string_view component) {
+    if (component == "SCALAR") {
+        return 1;
+    } else if (component == "VEC2") {
+        return 2;
+    } else if (component == "VEC3") {
+        return 3;
+    } else if (component == "VEC4") {
+        return 4;
+    } else if (component == "MAT2") {
+        return 4;
+    } else if (component == "MAT3") {
+        return 9;
+    } else if (component == "MAT4") {
+        return 16;
+    } else {
+        ENSURE(false);
+    }
+}
+
+// typed read-only view of a sparse accessor's substitutions, without expanding them into a dense array
+// indices are strictly increasing as required by the spec, so lookups are a binary search
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class SparseView {
+public:
+    SparseView(const Model& model, const AccessorSparse& sparse) {
+        m_count = sparse.count;
+        m_indexSize = datatypeSize(sparse.indices.componentType);
+
+        const std::span<const std::byte> indices = model.bufferViewData(sparse.indices.bufferView);
+        const std::span<const std::byte> values = model.bufferViewData(sparse.values.bufferView);
+
+        ENSURE(sparse.indices.byteOffset + m_count * m_indexSize <= indices.size());
+        ENSURE(sparse.values.byteOffset + m_count * sizeof(T) <= values.size());
+
+        m_indices = indices.data() + sparse.indices.byteOffset;
+        m_values = values.data() + sparse.values.byteOffset;
+    }
+
+    // number of substituted elements
+    [[nodiscard]] constexpr usize size() const { return m_count; }
+
+    // dense element index of the i-th substitution
+    [[nodiscard]] uint32 index(usize i) const {
+        switch (m_indexSize) {
+            case sizeof(uint8):
+                return uint32(m_indices[i]);
+            case sizeof(uint16): {
+                uint16 index;
+                std::memcpy(&index, m_indices + i * sizeof(uint16), sizeof(uint16));
+                return index;
+            }
+            default: {
+                uint32 index;
+                std::memcpy(&index, m_indices + i * sizeof(uint32), sizeof(uint32));
+                return index;
+            }
+        }
+    }
+
+    // value of the i-th substitution
+    [[nodiscard]] T value(usize i) const {
+        T element;
+        std::memcpy(&element, m_values + i * sizeof(T), sizeof(T));
+        return element;
+    }
+
+    // substituted value of a dense element, nullopt if the element is not substituted
+    [[nodiscard]] std::optional<T> find(usize element) const {
+        usize lo = 0;
+        usize hi = m_count;
+        while (lo < hi) {
+            const usize mid = lo + (hi - lo) / 2;
+            const uint32 i = index(mid);
+            if (i == element) {
+                return value(mid);
+            } else if (i < element) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // overlay the substitutions onto a dense array, converting each to U
+    template <typename U = T>
+    void apply(std::span<U> dst) const {
+        for (usize i = 0; i < m_count; i++) {
+            const uint32 element = index(i);
+            CHECK(element < dst.size());
+            dst[element] = static_cast<U>(value(i));
+        }
+    }
+
+private:
+    const std::byte* m_indices = nullptr;
+    const std::byte* m_values = nullptr;
+    usize m_count = 0;
+    usize m_indexSize = 0;
+};
+
+// typed read-only view of an accessor's elements
+// resolves the bufferView's buffer and honours byteStride, so interleaved data reads correctly
+// elements are read by value with memcpy as the underlying bytes may not be aligned for T
+// an accessor with no bufferView reads as all zeros, as required by the spec
+// sparse substitutions are overlaid on every read, sparse() exposes them for consumers that use them directly
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class AccessorView {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        Iterator() = default;
+        Iterator(const AccessorView* view, usize index)
+            : m_view(view),
+              m_index(index) {}
+
+        T operator*() const { return (*m_view)[m_index]; }
+
+        Iterator& operator++() {
+            m_index++;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            m_index++;
+            return tmp;
+        }
+
+        bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+
+    private:
+        const AccessorView* m_view = nullptr;
+        usize m_index = 0;
+    };
+
+    AccessorView(const Model& model, usize accessorIndex) {
+        const Accessor& accessor = model.accessors[accessorIndex];
+
+        CHECK(datatypeSize(accessor.componentType) * componentElements(accessor.type) == sizeof(T));
+
+        m_count = accessor.count;
+        m_stride = sizeof(T);
+
+        if (accessor.bufferView != undefined) {
+            const BufferView& bufferView = model.bufferViews[accessor.bufferView];
+            const std::span<const std::byte> data = model.bufferViewData(accessor.bufferView);
+
+            if (bufferView.byteStride != undefined && bufferView.byteStride != 0) {
+                m_stride = bufferView.byteStride;
+            }
+
+            const usize offset = accessor.byteOffset;
+            ENSURE(m_count == 0 || offset + (m_count - 1) * m_stride + sizeof(T) <= data.size());
+            m_data = data.data() + offset;
+        }
+
+        if (accessor.sparse) {
+            m_sparse.emplace(model, *accessor.sparse);
+        }
+    }
+
+    [[nodiscard]] T operator[](usize i) const {
+        if (m_sparse) {
+            if (std::optional<T> substitute = m_sparse->find(i)) {
+                return *substitute;
+            }
+        }
+
+        T element = {};
+        if (m_data) {
+            std::memcpy(&element, m_data + i * m_stride, sizeof(T));
+        }
+        return element;
+    }
+
+    // first element of the dense base, nullptr if the accessor has no bufferView
+    // does not include sparse substitutions
+    [[nodiscard]] constexpr const std::byte* data() const { return m_data; }
+
+    // sparse substitutions, nullopt if the accessor is not sparse
+    [[nodiscard]] constexpr const std::optional<SparseView<T>>& sparse() const { return m_sparse; }
+
+    [[nodiscard]] constexpr usize size() const { return m_count; }
+    [[nodiscard]] constexpr usize stride() const { return m_stride; }
+    [[nodiscard]] constexpr bool contiguous() const { return m_stride == sizeof(T); }
+
+    [[nodiscard]] Iterator begin() const { return Iterator(this, 0); }
+    [[nodiscard]] Iterator end() const { return Iterator(this, m_count); }
+
+    // copy elements into dst, converting each to U
+    // a single memcpy when the elements are tightly packed and no conversion is needed
+    // sparse substitutions are overlaid after the dense copy
+    template <typename U = T>
+    void copy(std::span<U> dst) const {
+        CHECK(dst.size() >= m_count);
+
+        if constexpr (std::is_same_v<U, T>) {
+            if (!m_data) {
+                std::fill_n(dst.begin(), m_count, T{});
+            } else if (contiguous()) {
+                std::memcpy(dst.data(), m_data, m_count * sizeof(T));
+            } else {
+                copyStrided(dst);
+            }
+        } else {
+            copyStrided(dst);
+        }
+
+        if (m_sparse) {
+            m_sparse->apply(dst.first(m_count));
+        }
+    }
+
+private:
+    template <typename U>
+    void copyStrided(std::span<U> dst) const {
+        T element = {};
+        for (usize i = 0; i < m_count; i++) {
+            if (m_data) {
+                std::memcpy(&element, m_data + i * m_stride, sizeof(T));
+            }
+            dst[i] = static_cast<U>(element);
+        }
+    }
+
+private:
+    std::optional<SparseView<T>> m_sparse;
+    const std::byte* m_data = nullptr;
+    usize m_count = 0;
+    usize m_stride = 0;
+};
+
+} // namespace R3::glTF
@@ -3,7 +3,7 @@
 
 namespace R3::glTF {
 
-void KHR_materials_pbrSpecularGlossiness::parse(Extension* extension, rapidjson::Value& value) {
+void KHR_materials_pbrSpecularGlossiness::parse(Extension* extension, const rapidjson::Value& value) {
     auto* self = reinterpret_cast<KHR_materials_pbrSpecularGlossiness*>(extension);
 
     if (value.HasMember("diffuseFactor")) {
@@ -31,4 +31,16 @@ void KHR_materials_pbrSpecularGlossiness::parse(Extension* extension, rapidjson:
     }
 }
 
+void EXT_meshopt_compression::parse(Extension* extension, const rapidjson::Value& value) {
+    auto* self = reinterpret_cast<EXT_meshopt_compression*>(extension);
+
+    self->buffer = value["buffer"].GetUint();
+    maybeAssign(self->byteOffset, value, "byteOffset");
+    self->byteLength = value["byteLength"].GetUint();
+    self->byteStride = value["byteStride"].GetUint();
+    self->count = value["count"].GetUint();
+    self->mode = getString(value["mode"]);
+    maybeAssign(self->filter, value, "filter");
+}
+
 } // namespace R3::glTF
\ No newline at end of file
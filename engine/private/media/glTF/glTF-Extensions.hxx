@@ -6,13 +6,16 @@
 namespace R3::glTF {
 
 static constexpr const char* EXTENSION_KHR_materials_pbrSpecularGlossiness = "KHR_materials_pbrSpecularGlossiness";
+static constexpr const char* EXTENSION_EXT_meshopt_compression = "EXT_meshopt_compression";
+static constexpr const char* EXTENSION_KHR_draco_mesh_compression = "KHR_draco_mesh_compression";
+static constexpr const char* EXTENSION_KHR_texture_basisu = "KHR_texture_basisu";
 
 // https://kcoley.github.io/glTF/extensions/2.0/Khronos/KHR_materials_pbrSpecularGlossiness/
 struct KHR_materials_pbrSpecularGlossiness : public Extension {
     KHR_materials_pbrSpecularGlossiness()
         : Extension(EXTENSION_KHR_materials_pbrSpecularGlossiness) {}
 
-    static void parse(Extension* extension, rapidjson::Value& value);
+    static void parse(Extension* extension, const rapidjson::Value& value);
 
     float diffuseFactor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
     std::optional<TextureInfo> diffuseTexture;
@@ -21,4 +24,21 @@ struct KHR_materials_pbrSpecularGlossiness : public Extension {
     std::optional<TextureInfo> specularGlossinessTexture;
 };
 
+// https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/EXT_meshopt_compression
+// on a bufferView, whose bytes are then decoded from the compressed range of another buffer
+struct EXT_meshopt_compression : public Extension {
+    EXT_meshopt_compression()
+        : Extension(EXTENSION_EXT_meshopt_compression) {}
+
+    static void parse(Extension* extension, const rapidjson::Value& value);
+
+    uint32 buffer; // REQUIRED
+    uint32 byteOffset = 0;
+    uint32 byteLength;                // REQUIRED
+    uint32 byteStride;                // REQUIRED
+    uint32 count;                     // REQUIRED
+    std::string_view mode;            // REQUIRED, ATTRIBUTES, TRIANGLES or INDICES
+    std::string_view filter = "NONE"; // NONE, OCTAHEDRAL, QUATERNION or EXPONENTIAL
+};
+
 } // namespace R3::glTF
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include "glTF-Meshopt.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace R3::glTF::meshopt {
+
+namespace local {
+
+static constexpr uint8 VERTEX_HEADER = 0xA0;
+static constexpr uint8 INDEX_HEADER = 0xE0;
+static constexpr uint8 SEQUENCE_HEADER = 0xD0;
+
+static constexpr usize VERTEX_BLOCK_SIZE_BYTES = 8192;
+static constexpr usize VERTEX_BLOCK_MAX_SIZE = 256;
+static constexpr usize BYTE_GROUP_SIZE = 16;
+static constexpr usize BYTE_GROUP_DECODE_LIMIT = 24; // largest byte group, 4 header bits and 16 + 8 data bytes
+static constexpr usize TAIL_MAX_SIZE = 32;
+
+// vertices per block, a multiple of the byte group size
+static usize vertexBlockSize(usize stride) {
+    const usize size = (VERTEX_BLOCK_SIZE_BYTES / stride) & ~(BYTE_GROUP_SIZE - 1);
+    return std::min(size, VERTEX_BLOCK_MAX_SIZE);
+}
+
+static uint8 unzigzag8(uint8 v) {
+    return uint8(-(v & 1) ^ (v >> 1));
+}
+
+static uint32 unzigzag32(uint32 v) {
+    return uint32(-int32(v & 1)) ^ (v >> 1);
+}
+
+// 16 values of 0, 2, 4 or 8 bits, values that do not fit the narrow widths are escaped to a trailing byte
+static const uint8* decodeBytesGroup(const uint8* data, uint8* dst, uint32 bitslog2) {
+    auto unpack = [&](uint32 bits) {
+        const uint32 escape = (1u << bits) - 1;
+        const uint8* extra = data + bits * 2; // 16 values of bits each
+        for (usize i = 0; i < BYTE_GROUP_SIZE; i++) {
+            const uint32 value = (data[i * bits / 8] >> (8 - bits - i * bits % 8)) & escape;
+            dst[i] = value == escape ? *extra++ : uint8(value);
+        }
+        return extra;
+    };
+
+    switch (bitslog2) {
+        case 0:
+            std::memset(dst, 0, BYTE_GROUP_SIZE);
+            return data;
+        case 1:
+            return unpack(2);
+        case 2:
+            return unpack(4);
+        default:
+            std::memcpy(dst, data, BYTE_GROUP_SIZE);
+            return data + BYTE_GROUP_SIZE;
+    }
+}
+
+// size bytes in groups of 16, preceded by 2 bits per group selecting its width
+static const uint8* decodeBytes(const uint8* data, const uint8* end, uint8* dst, usize size) {
+    const usize groups = size / BYTE_GROUP_SIZE;
+    const usize headerSize = (groups + 3) / 4;
+    if (usize(end - data) < headerSize) {
+        return nullptr;
+    }
+
+    const uint8* header = data;
+    data += headerSize;
+
+    for (usize group = 0; group < groups; group++) {
+        if (usize(end - data) < BYTE_GROUP_DECODE_LIMIT) {
+            return nullptr;
+        }
+        const uint32 bitslog2 = (header[group / 4] >> (group % 4 * 2)) & 3;
+        data = decodeBytesGroup(data, dst + group * BYTE_GROUP_SIZE, bitslog2);
+    }
+    return data;
+}
+
+// every byte of the vertex is a separate stream of deltas against the same byte of the previous vertex
+static const uint8* decodeVertexBlock(
+    const uint8* data, const uint8* end, uint8* dst, usize count, usize stride, uint8 last[VERTEX_BLOCK_MAX_SIZE]) {
+    uint8 deltas[VERTEX_BLOCK_MAX_SIZE];
+    const usize alignedCount = (count + BYTE_GROUP_SIZE - 1) & ~(BYTE_GROUP_SIZE - 1);
+
+    for (usize k = 0; k < stride; k++) {
+        data = decodeBytes(data, end, deltas, alignedCount);
+        if (data == nullptr) {
+            return nullptr;
+        }
+
+        uint8 previous = last[k];
+        for (usize i = 0; i < count; i++) {
+            previous = uint8(unzigzag8(deltas[i]) + previous);
+            dst[i * stride + k] = previous;
+        }
+        last[k] = previous;
+    }
+    return data;
+}
+
+static uint32 decodeVByte(const uint8*& data) {
+    const uint8 lead = *data++;
+    if (lead < 128) {
+        return lead;
+    }
+
+    uint32 result = lead & 127;
+    for (uint32 shift = 7, i = 0; i < 4; i++, shift += 7) {
+        const uint8 group = *data++;
+        result |= uint32(group & 127) << shift;
+        if (group < 128) {
+            break;
+        }
+    }
+    return result;
+}
+
+static uint32 decodeIndex(const uint8*& data, uint32 last) {
+    return last + unzigzag32(decodeVByte(data));
+}
+
+static void writeIndex(std::byte* dst, usize i, usize indexSize, uint32 index) {
+    if (indexSize == sizeof(uint16)) {
+        const uint16 narrow = uint16(index);
+        std::memcpy(dst + i * sizeof(uint16), &narrow, sizeof(uint16));
+    } else {
+        std::memcpy(dst + i * sizeof(uint32), &index, sizeof(uint32));
+    }
+}
+
+template <typename T>
+static T load(const std::byte* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+template <typename T>
+static void store(std::byte* dst, T value) {
+    std::memcpy(dst, &value, sizeof(T));
+}
+
+static int32 round(float v) {
+    return int32(v + (v >= 0.0f ? 0.5f : -0.5f));
+}
+
+template <typename T>
+static void decodeOctahedral(std::span<std::byte> data, usize count) {
+    const float max = float((1 << (sizeof(T) * 8 - 1)) - 1);
+
+    for (usize i = 0; i < count; i++) {
+        std::byte* element = data.data() + i * 4 * sizeof(T);
+
+        // z is stored as the length the octahedron was scaled to, unfold it back into the lower hemisphere
+        float x = float(load<T>(element));
+        float y = float(load<T>(element + sizeof(T)));
+        const float z = float(load<T>(element + 2 * sizeof(T))) - std::abs(x) - std::abs(y);
+
+        const float t = std::min(z, 0.0f);
+        x += x >= 0.0f ? t : -t;
+        y += y >= 0.0f ? t : -t;
+
+        const float scale = max / std::sqrt(x * x + y * y + z * z);
+        store(element, T(round(x * scale)));
+        store(element + sizeof(T), T(round(y * scale)));
+        store(element + 2 * sizeof(T), T(round(z * scale)));
+    }
+}
+
+} // namespace local
+
+bool decodeVertexBuffer(std::span<std::byte> dst, usize count, usize stride, std::span<const std::byte> src) {
+    if (stride == 0 || stride > local::VERTEX_BLOCK_MAX_SIZE || stride % 4 != 0 || dst.size() != count * stride) {
+        return false;
+    }
+
+    const uint8* data = reinterpret_cast<const uint8*>(src.data());
+    const uint8* end = data + src.size();
+    if (src.size() < 1 + stride || (*data & 0xF0) != local::VERTEX_HEADER || (*data & 0x0F) != 0) {
+        return false;
+    }
+    data++;
+
+    // the tail holds the vertex the first deltas are taken against
+    uint8 last[local::VERTEX_BLOCK_MAX_SIZE];
+    std::memcpy(last, end - stride, stride);
+
+    uint8* vertices = reinterpret_cast<uint8*>(dst.data());
+    const usize blockSize = local::vertexBlockSize(stride);
+    for (usize offset = 0; offset < count; offset += blockSize) {
+        const usize size = std::min(blockSize, count - offset);
+        data = local::decodeVertexBlock(data, end, vertices + offset * stride, size, stride, last);
+        if (data == nullptr) {
+            return false;
+        }
+    }
+
+    return usize(end - data) == std::max(stride, local::TAIL_MAX_SIZE);
+}
+
+bool decodeIndexBuffer(std::span<std::byte> dst, usize count, usize indexSize, std::span<const std::byte> src) {
+    if (count % 3 != 0 || (indexSize != sizeof(uint16) && indexSize != sizeof(uint32)) ||
+        dst.size() != count * indexSize) {
+        return false;
+    }
+
+    // header, a code byte per triangle and the 16 byte table of frequent vertex references
+    const uint8* buffer = reinterpret_cast<const uint8*>(src.data());
+    if (src.size() < 1 + count / 3 + 16 || (buffer[0] & 0xF0) != local::INDEX_HEADER) {
+        return false;
+    }
+    const uint32 version = buffer[0] & 0x0F;
+    if (version > 1) {
+        return false;
+    }
+
+    // recently emitted edges and vertices, every triangle references them relative to the newest entry
+    uint32 edges[16][2];
+    uint32 vertices[16];
+    std::memset(edges, 0xFF, sizeof(edges));
+    std::memset(vertices, 0xFF, sizeof(vertices));
+    usize edgeOffset = 0;
+    usize vertexOffset = 0;
+
+    auto pushEdge = [&](uint32 a, uint32 b) {
+        edges[edgeOffset][0] = a;
+        edges[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    };
+    auto pushVertex = [&](uint32 v, bool advance = true) {
+        vertices[vertexOffset] = v;
+        vertexOffset = (vertexOffset + usize(advance)) & 15;
+    };
+
+    uint32 next = 0; // next vertex that was never referenced
+    uint32 last = 0; // last explicitly encoded index, explicit indices are deltas against it
+    const uint32 fecmax = version >= 1 ? 13 : 15;
+
+    const uint8* code = buffer + 1;
+    const uint8* data = code + count / 3;
+    const uint8* dataEnd = buffer + src.size() - 16;
+    const uint8* codeaux = dataEnd;
+
+    for (usize i = 0; i < count; i += 3) {
+        // a triangle reads at most 16 bytes of data, which the table behind dataEnd covers
+        if (data > dataEnd) {
+            return false;
+        }
+
+        const uint8 codetri = *code++;
+        uint32 a = 0;
+        uint32 b = 0;
+        uint32 c = 0;
+
+        if (codetri < 0xF0) {
+            // triangle on a recent edge, the third vertex is new, recent or explicit
+            const uint32 fe = codetri >> 4;
+            a = edges[(edgeOffset - 1 - fe) & 15][0];
+            b = edges[(edgeOffset - 1 - fe) & 15][1];
+
+            const uint32 fec = codetri & 15;
+            if (fec < fecmax) {
+                c = fec == 0 ? next++ : vertices[(vertexOffset - 1 - fec) & 15];
+                pushVertex(c, fec == 0);
+            } else {
+                // 13 and 14 are the last explicit index -1 and +1
+                c = last = fec != 15 ? last + (fec == 13 ? -1 : 1) : local::decodeIndex(data, last);
+                pushVertex(c);
+            }
+
+            pushEdge(c, b);
+            pushEdge(a, c);
+        } else {
+            // triangle on no recent edge, a is new unless explicit and b and c are new, recent or explicit
+            uint32 fea = 0;
+            uint32 feb = 0;
+            uint32 fec = 0;
+            if (codetri < 0xFE) {
+                feb = codeaux[codetri & 15] >> 4;
+                fec = codeaux[codetri & 15] & 15;
+            } else {
+                const uint8 aux = *data++;
+                fea = codetri == 0xFE ? 0 : 15;
+                feb = aux >> 4;
+                fec = aux & 15;
+                if (aux == 0) {
+                    next = 0; // restart
+                }
+            }
+
+            // new vertices are numbered in order before explicit indices are decoded, as the encoder does
+            a = fea == 0 ? next++ : 0;
+            b = feb == 0 ? next++ : vertices[(vertexOffset - feb) & 15];
+            c = fec == 0 ? next++ : vertices[(vertexOffset - fec) & 15];
+
+            if (fea == 15) {
+                a = last = local::decodeIndex(data, last);
+            }
+            if (feb == 15) {
+                b = last = local::decodeIndex(data, last);
+            }
+            if (fec == 15) {
+                c = last = local::decodeIndex(data, last);
+            }
+
+            pushVertex(a);
+            pushVertex(b, feb == 0 || feb == 15);
+            pushVertex(c, fec == 0 || fec == 15);
+
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        }
+
+        local::writeIndex(dst.data(), i + 0, indexSize, a);
+        local::writeIndex(dst.data(), i + 1, indexSize, b);
+        local::writeIndex(dst.data(), i + 2, indexSize, c);
+    }
+
+    return data == dataEnd;
+}
+
+bool decodeIndexSequence(std::span<std::byte> dst, usize count, usize indexSize, std::span<const std::byte> src) {
+    if ((indexSize != sizeof(uint16) && indexSize != sizeof(uint32)) || dst.size() != count * indexSize) {
+        return false;
+    }
+
+    // header, at least a byte per index and a 4 byte tail
+    const uint8* buffer = reinterpret_cast<const uint8*>(src.data());
+    if (src.size() < 1 + count + 4 || (buffer[0] & 0xF0) != local::SEQUENCE_HEADER || (buffer[0] & 0x0F) > 1) {
+        return false;
+    }
+
+    const uint8* data = buffer + 1;
+    const uint8* dataEnd = buffer + src.size() - 4;
+
+    // every index is a delta against one of two baselines, the low bit selects which
+    uint32 last[2] = {0, 0};
+    for (usize i = 0; i < count; i++) {
+        // an index reads at most 5 bytes, which the tail covers
+        if (data >= dataEnd) {
+            return false;
+        }
+
+        const uint32 v = local::decodeVByte(data);
+        const uint32 baseline = v & 1;
+        last[baseline] += local::unzigzag32(v >> 1);
+        local::writeIndex(dst.data(), i, indexSize, last[baseline]);
+    }
+
+    return data == dataEnd;
+}
+
+void decodeFilterOctahedral(std::span<std::byte> data, usize count, usize stride) {
+    if (stride == 4) {
+        local::decodeOctahedral<int8_t>(data, count);
+    } else {
+        local::decodeOctahedral<int16_t>(data, count);
+    }
+}
+
+void decodeFilterQuaternion(std::span<std::byte> data, usize count) {
+    const float scale = 1.0f / std::sqrt(2.0f);
+
+    for (usize i = 0; i < count; i++) {
+        std::byte* element = data.data() + i * 4 * sizeof(int16_t);
+
+        // w holds the scale in its high bits and the index of the dropped largest component in its low 2 bits
+        const int16_t w = local::load<int16_t>(element + 3 * sizeof(int16_t));
+        const float s = scale / float(w | 3);
+
+        const float x = float(local::load<int16_t>(element)) * s;
+        const float y = float(local::load<int16_t>(element + sizeof(int16_t))) * s;
+        const float z = float(local::load<int16_t>(element + 2 * sizeof(int16_t))) * s;
+        const float largest = std::sqrt(std::max(1.0f - x * x - y * y - z * z, 0.0f));
+
+        const usize dropped = usize(w & 3);
+        local::store(element + ((dropped + 1) & 3) * sizeof(int16_t), int16_t(local::round(x * 32767.0f)));
+        local::store(element + ((dropped + 2) & 3) * sizeof(int16_t), int16_t(local::round(y * 32767.0f)));
+        local::store(element + ((dropped + 3) & 3) * sizeof(int16_t), int16_t(local::round(z * 32767.0f)));
+        local::store(element + dropped * sizeof(int16_t), int16_t(local::round(largest * 32767.0f)));
+    }
+}
+
+void decodeFilterExponential(std::span<std::byte> data, usize count, usize stride) {
+    for (usize i = 0; i < count * stride / sizeof(uint32); i++) {
+        std::byte* element = data.data() + i * sizeof(uint32);
+        const uint32 v = local::load<uint32>(element);
+
+        // 24 bit signed mantissa and 8 bit signed exponent, ldexp without the library call
+        const int32 mantissa = int32(v << 8) >> 8;
+        const int32 exponent = int32(v) >> 24;
+        const float scale = std::bit_cast<float>(uint32(exponent + 127) << 23);
+
+        local::store(element, scale * float(mantissa));
+    }
+}
+
+} // namespace R3::glTF::meshopt
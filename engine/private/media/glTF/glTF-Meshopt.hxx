@@ -0,0 +1,55 @@
+#pragma once
+
+/// @file glTF-Meshopt.hxx
+/// @brief Decoders for the EXT_meshopt_compression bitstream
+/// https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/EXT_meshopt_compression
+/// Every decoder validates the stream against the size it must decode to and returns false instead of throwing,
+/// so independent buffer views can be decoded on worker threads
+
+#include <span>
+#include "api/Types.hpp"
+
+namespace R3::glTF::meshopt {
+
+/// @brief Decode an ATTRIBUTES stream
+/// @param[out] dst count * stride bytes
+/// @param count number of elements
+/// @param stride size of an element, a multiple of 4 up to 256
+/// @param src compressed bytes
+/// @return true if src was a valid stream of exactly count elements
+bool decodeVertexBuffer(std::span<std::byte> dst, usize count, usize stride, std::span<const std::byte> src);
+
+/// @brief Decode a TRIANGLES stream
+/// @param[out] dst count * indexSize bytes
+/// @param count number of indices, a multiple of 3
+/// @param indexSize 2 or 4
+/// @param src compressed bytes
+/// @return true if src was a valid stream of exactly count indices
+bool decodeIndexBuffer(std::span<std::byte> dst, usize count, usize indexSize, std::span<const std::byte> src);
+
+/// @brief Decode an INDICES stream
+/// @param[out] dst count * indexSize bytes
+/// @param count number of indices
+/// @param indexSize 2 or 4
+/// @param src compressed bytes
+/// @return true if src was a valid stream of exactly count indices
+bool decodeIndexSequence(std::span<std::byte> dst, usize count, usize indexSize, std::span<const std::byte> src);
+
+/// @brief Undo the OCTAHEDRAL filter in place
+/// @param data count * stride decoded bytes
+/// @param count number of elements
+/// @param stride 4 for snorm8 or 8 for snorm16 components
+void decodeFilterOctahedral(std::span<std::byte> data, usize count, usize stride);
+
+/// @brief Undo the QUATERNION filter in place
+/// @param data count * 8 decoded bytes
+/// @param count number of elements
+void decodeFilterQuaternion(std::span<std::byte> data, usize count);
+
+/// @brief Undo the EXPONENTIAL filter in place
+/// @param data count * stride decoded bytes
+/// @param count number of elements
+/// @param stride a multiple of 4
+void decodeFilterExponential(std::span<std::byte> data, usize count, usize stride);
+
+} // namespace R3::glTF::meshopt
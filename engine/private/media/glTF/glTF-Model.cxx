@@ -1,27 +1,34 @@
 #include "glTF-Model.hxx"
 
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include "api/Ensure.hpp"
 #include "api/Log.hpp"
 #include "api/Version.hpp"
+#include "core/ThreadPool.hpp"
 #include "glTF-Extensions.hxx"
+#include "glTF-Meshopt.hxx"
 #include "glTF-Util.hxx"
 
 using namespace rapidjson;
 
 namespace R3::glTF {
 
-Model::Model(const std::filesystem::path& path)
-    : m_path(path) {
-    std::ifstream ifs(path, std::ios::binary);
-    ENSURE(ifs.is_open() && ifs.good());
+Model::Model(const std::filesystem::path& path, ThreadPool* threadPool)
+    : m_file(path, MappedFile::Access::CopyOnWrite),
+      m_path(path.string()) {
+    const std::span<std::byte> file = m_file.mutableBytes();
 
-    bool glbSuccess = parseGLB(ifs);
-    bool gltfSuccess = parseGLTF(ifs);
+    bool success = parseGLB(file) || parseGLTF(file);
 
-    CHECK(glbSuccess || gltfSuccess);
+    CHECK(success);
 
     populateRoot();
+    resolveBufferViews(threadPool);
 
     LOG(Verbose, "=== Extensions Used ===");
     for (auto& extension : extensionsUsed) {
@@ -34,12 +41,28 @@ Model::Model(const std::filesystem::path& path)
     }
 }
 
-bool Model::parseGLB(std::ifstream& ifs) {
+const std::vector<Camera>& Model::cameras() const {
+    if (!m_cameras) {
+        populateCameras();
+    }
+    return *m_cameras;
+}
+
+const std::vector<Sampler>& Model::samplers() const {
+    if (!m_samplers) {
+        populateSamplers();
+    }
+    return *m_samplers;
+}
+
+bool Model::parseGLB(std::span<std::byte> file) {
     Header header = {};
-    ifs.read((char*)(&header), sizeof(header));
+    if (file.size() < sizeof(header)) {
+        return false; // early exit, too small to be a glb file
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
 
     if (header.magic != HEADER_MAGIC) {
-        ifs.seekg(0);
         return false; // early exit, not glb file
     }
 
@@ -47,46 +70,64 @@ bool Model::parseGLB(std::ifstream& ifs) {
         LOG(Warning, "glb version for", m_path, "is", header.version, "while R3 supports glb version", GLB_VERSION);
     }
 
-    ChunkHeader chunkHeader = {};
-
-    auto readJson = [&] {
-        std::string jsonFile(chunkHeader.length, '\0');
-        ifs.read(jsonFile.data(), chunkHeader.length);
-        m_document.Parse(jsonFile.c_str());
+    usize offset = sizeof(header);
+
+    // JSON is parsed in place inside the mapping and BIN is left in place as a view
+    auto readChunk = [&] {
+        ChunkHeader chunkHeader = {};
+        ENSURE(offset + sizeof(chunkHeader) <= file.size());
+        std::memcpy(&chunkHeader, file.data() + offset, sizeof(chunkHeader));
+        offset += sizeof(chunkHeader);
+
+        ENSURE(offset + chunkHeader.length <= file.size());
+        const std::span<std::byte> chunk = file.subspan(offset, chunkHeader.length);
+        offset += chunkHeader.length;
+
+        if (chunkHeader.type == CHUNK_TYPE_JSON) {
+            parseJSON(chunk);
+        } else if (chunkHeader.type == CHUNK_TYPE_BIN) {
+            m_binChunk = chunk;
+        } else {
+            LOG(Error, "invalid chunk header type");
+            ENSURE(false);
+        }
     };
 
-    auto readBin = [&] {
-        m_buffer.resize(chunkHeader.length);
-        ifs.read((char*)m_buffer.data(), chunkHeader.length);
+    readChunk();
+    readChunk();
+
+    return true;
+}
+
+bool Model::parseGLTF(std::span<std::byte> file) {
+    parseJSON(file);
+    return true;
+}
+
+void Model::parseJSON(std::span<std::byte> json) {
+    // in-situ parsing decodes strings where they lie, every string in the model is a view into json
+    // it needs a null terminated buffer, trailing whitespace (GLB chunk padding, final newline) is terminated in place
+    // and only JSON ending right on its last byte is copied out
+    auto isSpace = [](std::byte c) {
+        return c == std::byte(' ') || c == std::byte('\n') || c == std::byte('\r') || c == std::byte('\t');
     };
 
-    ifs.read((char*)(&chunkHeader), sizeof(chunkHeader));
-    if (chunkHeader.type == CHUNK_TYPE_JSON) {
-        readJson();
-    } else if (chunkHeader.type == CHUNK_TYPE_BIN) {
-        readBin();
+    char* buffer = nullptr;
+    if (!json.empty() && isSpace(json.back())) {
+        json.back() = std::byte('\0');
+        buffer = reinterpret_cast<char*>(json.data());
     } else {
-        LOG(Error, "invalid chunk header type");
-        ENSURE(false);
+        const char* data = reinterpret_cast<const char*>(json.data());
+        m_json.assign(data, data + json.size());
+        m_json.push_back('\0');
+        buffer = m_json.data();
     }
 
-    ifs.read((char*)(&chunkHeader), sizeof(chunkHeader));
-    if (chunkHeader.type == CHUNK_TYPE_JSON) {
-        readJson();
-    } else if (chunkHeader.type == CHUNK_TYPE_BIN) {
-        readBin();
-    } else {
-        LOG(Error, "invalid chunk header type");
+    m_document.ParseInsitu(buffer);
+    if (m_document.HasParseError()) {
+        LOG(Error, "glTF JSON parse error in", m_path, "at offset", m_document.GetErrorOffset());
         ENSURE(false);
     }
-
-    return true;
-}
-
-bool Model::parseGLTF(std::ifstream& ifs) {
-    std::string json = (std::stringstream() << ifs.rdbuf()).str();
-    m_document.Parse(json.c_str());
-    return true;
 }
 
 void Model::populateRoot() {
@@ -97,12 +138,10 @@ void Model::populateRoot() {
     populateAsset();
     populateBuffers();
     populateBufferViews();
-    populateCameras();
     populateImages();
     populateMaterials();
     populateMeshes();
     populateNodes();
-    populateSamplers();
     populateScene();
     populateScenes();
     populateSkins();
@@ -117,7 +156,7 @@ void Model::populateExtensionsUsed() {
     }
 
     for (auto& extension : m_document["extensionsUsed"].GetArray()) {
-        extensionsUsed.emplace_back(extension.GetString());
+        extensionsUsed.emplace_back(getString(extension));
     }
 }
 
@@ -127,7 +166,13 @@ void Model::populateExtensionsRequired() {
     }
 
     for (auto& extension : m_document["extensionsRequired"].GetArray()) {
-        extensionsRequired.emplace_back(extension.GetString());
+        extensionsRequired.emplace_back(getString(extension));
+
+        // only optional Draco compression can be loaded, through the uncompressed attributes it falls back to
+        if (extensionsRequired.back() == EXTENSION_KHR_draco_mesh_compression) {
+            LOG(Error, m_path, "requires", EXTENSION_KHR_draco_mesh_compression, "which R3 does not decode");
+            ENSURE(false);
+        }
     }
 }
 
@@ -155,7 +200,7 @@ void Model::populateAccessors() {
         accessor.count = itAccessor["count"].GetUint();
 
         // type
-        accessor.type = itAccessor["type"].GetString();
+        accessor.type = getString(itAccessor["type"]);
 
         // max
         if (itAccessor.HasMember("max")) {
@@ -167,28 +212,55 @@ void Model::populateAccessors() {
         // min
         if (itAccessor.HasMember("min")) {
             for (auto& elem : itAccessor.GetObject()["min"].GetArray()) {
-                accessor.max.push_back(elem.GetFloat());
+                accessor.min.push_back(elem.GetFloat());
             }
         }
 
         // sparse
         if (itAccessor.HasMember("sparse")) {
-            LOG(Warning, "TODO Sparse Accessors");
+            auto& itSparse = itAccessor["sparse"];
+            AccessorSparse& sparse = accessor.sparse.emplace();
+
+            // count
+            sparse.count = itSparse["count"].GetUint();
+
+            // indices
+            auto& itIndices = itSparse["indices"];
+            sparse.indices.bufferView = itIndices["bufferView"].GetUint();
+            maybeAssign(sparse.indices.byteOffset, itIndices, "byteOffset");
+            sparse.indices.componentType = itIndices["componentType"].GetUint();
+            sparse.indices.extensions = findMember(itIndices, "extensions");
+#if R3_GLTF_JSON_EXTRAS
+            sparse.indices.extras = findMember(itIndices, "extras");
+#endif
+
+            // values
+            auto& itValues = itSparse["values"];
+            sparse.values.bufferView = itValues["bufferView"].GetUint();
+            maybeAssign(sparse.values.byteOffset, itValues, "byteOffset");
+            sparse.values.extensions = findMember(itValues, "extensions");
+#if R3_GLTF_JSON_EXTRAS
+            sparse.values.extras = findMember(itValues, "extras");
+#endif
+
+            // extensions
+            sparse.extensions = findMember(itSparse, "extensions");
+
+            // extras
+#if R3_GLTF_JSON_EXTRAS
+            sparse.extras = findMember(itSparse, "extras");
+#endif
         }
 
         // name
         maybeAssign(accessor.name, itAccessor, "name");
 
         // extensions
-        if (itAccessor.HasMember("extensions")) {
-            accessor.extensions = std::move(itAccessor["extensions"]);
-        }
+        accessor.extensions = findMember(itAccessor, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itAccessor.HasMember("extras")) {
-            accessor.extras = std::move(itAccessor["extras"]);
-        }
+        accessor.extras = findMember(itAccessor, "extras");
 #endif
     }
 }
@@ -216,31 +288,23 @@ void Model::populateAnimations() {
                 maybeAssign(channel.target.node, jsTarget, "node");
 
                 // path
-                channel.target.path = jsTarget["path"].GetString();
+                channel.target.path = getString(jsTarget["path"]);
 
                 // extensions
-                if (jsTarget.HasMember("extensions")) {
-                    channel.extensions = std::move(jsTarget["extensions"]);
-                }
+                channel.target.extensions = findMember(jsTarget, "extensions");
 
                 // extras
 #if R3_GLTF_JSON_EXTRAS
-                if (jsTarget.HasMember("extras")) {
-                    channel.extras = std::move(jsTarget["extras"]);
-                }
+                channel.target.extras = findMember(jsTarget, "extras");
 #endif
             }
 
             // extensions
-            if (itChannel.HasMember("extensions")) {
-                channel.extensions = std::move(itChannel["extensions"]);
-            }
+            channel.extensions = findMember(itChannel, "extensions");
 
             // extras
 #if R3_GLTF_JSON_EXTRAS
-            if (itChannel.HasMember("extras")) {
-                channel.extras = std::move(itChannel["extras"]);
-            }
+            channel.extras = findMember(itChannel, "extras");
 #endif
         }
 
@@ -258,15 +322,11 @@ void Model::populateAnimations() {
             sampler.output = itSampler["output"].GetUint();
 
             // extensions
-            if (itSampler.HasMember("extensions")) {
-                sampler.extensions = std::move(itSampler["extensions"]);
-            }
+            sampler.extensions = findMember(itSampler, "extensions");
 
             // extras
 #if R3_GLTF_JSON_EXTRAS
-            if (itSampler.HasMember("extras")) {
-                sampler.extras = std::move(itSampler["extras"]);
-            }
+            sampler.extras = findMember(itSampler, "extras");
 #endif
         }
 
@@ -274,15 +334,11 @@ void Model::populateAnimations() {
         maybeAssign(animation.name, itAnimation, "name");
 
         // extensions
-        if (itAnimation.HasMember("extensions")) {
-            animation.extensions = std::move(itAnimation["extensions"]);
-        }
+        animation.extensions = findMember(itAnimation, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itAnimation.HasMember("extras")) {
-            animation.extras = std::move(itAnimation["extras"]);
-        }
+        animation.extras = findMember(itAnimation, "extras");
 #endif
     }
 }
@@ -295,22 +351,18 @@ void Model::populateAsset() {
     // generator -- ignore
 
     // version
-    asset.version = jsAsset["version"].GetString();
+    asset.version = getString(jsAsset["version"]);
     checkVersion(asset.version);
 
     // minVersion
     maybeAssign(asset.minVersion, jsAsset, "minVersion");
 
     // extensions
-    if (jsAsset.HasMember("extensions")) {
-        asset.extensions = std::move(jsAsset["extensions"]);
-    }
+    asset.extensions = findMember(jsAsset, "extensions");
 
     // extras
 #if R3_GLTF_JSON_EXTRAS
-    if (jsAsset.HasMember("extras")) {
-        asset.extras = std::move(jsAsset["extras"]);
-    }
+    asset.extras = findMember(jsAsset, "extras");
 #endif
 }
 
@@ -332,32 +384,40 @@ void Model::populateBuffers() {
         maybeAssign(buffer.name, itBuffer, "name");
 
         // extensions
-        if (itBuffer.HasMember("extensions")) {
-            buffer.extensions = std::move(itBuffer["extensions"]);
-        }
+        buffer.extensions = findMember(itBuffer, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itBuffer.HasMember("extras")) {
-            buffer.extras = std::move(itBuffer["extras"]);
-        }
+        buffer.extras = findMember(itBuffer, "extras");
 #endif
 
-        /* load in buffer if external file */
+        // EXT_meshopt_compression fallback buffers only back the compressed bufferViews, which are decoded instead
+        bool fallback = false;
+        const Value* jsMeshopt =
+            buffer.extensions ? findMember(*buffer.extensions, EXTENSION_EXT_meshopt_compression) : nullptr;
+        if (jsMeshopt) {
+            maybeAssign(fallback, *jsMeshopt, "fallback");
+        }
+
+        /* map in buffer if external file, otherwise it is the GLB BIN chunk */
+        std::span<const std::byte>& data = m_buffers.emplace_back();
+        if (fallback) {
+            continue;
+        }
         if (!buffer.uri.empty()) {
             usize split = m_path.find_last_of('/') + 1;
             std::string dir = m_path.substr(0, split);
 
-            std::ifstream ifs;
-            ifs.exceptions(std::ifstream::badbit);
-
             try {
-                ifs.open(dir + buffer.uri, std::ios::binary);
-                m_buffer.resize(buffer.byteLength);
-                ifs.read((char*)m_buffer.data(), buffer.byteLength);
+                const MappedFile& file = m_bufferFiles.emplace_back(dir.append(buffer.uri));
+                CHECK(file.size() >= buffer.byteLength);
+                data = file.bytes().first(buffer.byteLength);
             } catch (std::exception& e) {
                 LOG(Error, "glTF buffer read error", e.what());
             }
+        } else {
+            CHECK(m_binChunk.size() >= buffer.byteLength);
+            data = m_binChunk.first(buffer.byteLength);
         }
     }
 }
@@ -389,25 +449,63 @@ void Model::populateBufferViews() {
         maybeAssign(bufferView.name, itBufferView, "name");
 
         // extensions
-        if (itBufferView.HasMember("extensions")) {
-            bufferView.extensions = std::move(itBufferView["extensions"]);
-        }
+        bufferView.extensions = findMember(itBufferView, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itBufferView.HasMember("extras")) {
-            bufferView.extras = std::move(itBufferView["extras"]);
-        }
+        bufferView.extras = findMember(itBufferView, "extras");
 #endif
     }
 }
 
-void Model::populateCameras() {
+void Model::populateCameras() const {
+    std::vector<Camera>& cameras = m_cameras.emplace();
+
     if (!m_document.HasMember("cameras")) {
         return;
     }
 
-    LOG(Warning, "TODO cameras");
+    for (auto& itCamera : m_document["cameras"].GetArray()) {
+        Camera& camera = cameras.emplace_back();
+
+        // orthographic
+        if (const Value* jsOrthographic = findMember(itCamera, "orthographic")) {
+            camera.orthographic.xmag = (*jsOrthographic)["xmag"].GetFloat();
+            camera.orthographic.ymag = (*jsOrthographic)["ymag"].GetFloat();
+            camera.orthographic.zfar = (*jsOrthographic)["zfar"].GetFloat();
+            camera.orthographic.znear = (*jsOrthographic)["znear"].GetFloat();
+            camera.orthographic.extensions = findMember(*jsOrthographic, "extensions");
+#if R3_GLTF_JSON_EXTRAS
+            camera.orthographic.extras = findMember(*jsOrthographic, "extras");
+#endif
+        }
+
+        // perspective
+        if (const Value* jsPerspective = findMember(itCamera, "perspective")) {
+            maybeAssign(camera.perspective.aspectRation, *jsPerspective, "aspectRatio");
+            camera.perspective.yfov = (*jsPerspective)["yfov"].GetFloat();
+            maybeAssign(camera.perspective.zfar, *jsPerspective, "zfar");
+            camera.perspective.znear = (*jsPerspective)["znear"].GetFloat();
+            camera.perspective.extensions = findMember(*jsPerspective, "extensions");
+#if R3_GLTF_JSON_EXTRAS
+            camera.perspective.extras = findMember(*jsPerspective, "extras");
+#endif
+        }
+
+        // type
+        camera.type = getString(itCamera["type"]);
+
+        // name
+        maybeAssign(camera.name, itCamera, "name");
+
+        // extensions
+        camera.extensions = findMember(itCamera, "extensions");
+
+        // extras
+#if R3_GLTF_JSON_EXTRAS
+        camera.extras = findMember(itCamera, "extras");
+#endif
+    }
 }
 
 void Model::populateImages() {
@@ -430,15 +528,11 @@ void Model::populateImages() {
         maybeAssign(image.name, itImage, "name");
 
         // extensions
-        if (itImage.HasMember("extensions")) {
-            image.extensions = std::move(itImage["extensions"]);
-        }
+        image.extensions = findMember(itImage, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itImage.HasMember("extras")) {
-            image.extras = std::move(itImage["extras"]);
-        }
+        image.extras = findMember(itImage, "extras");
 #endif
     }
 }
@@ -483,15 +577,11 @@ void Model::populateMaterials() {
             }
 
             // extensions
-            if (jsPbr.HasMember("extensions")) {
-                pbrMetallicRoughness.metallicRoughnessTexture->extensions = std::move(jsPbr["extensions"]);
-            }
+            pbrMetallicRoughness.extensions = findMember(jsPbr, "extensions");
 
             // extras
 #if R3_GLTF_JSON_EXTRAS
-            if (jsPbr.HasMember("extras")) {
-                pbrMetallicRoughness.metallicRoughnessTexture->extras = std::move(jsPbr["extras"]);
-            }
+            pbrMetallicRoughness.extras = findMember(jsPbr, "extras");
 #endif
         }
 
@@ -511,15 +601,11 @@ void Model::populateMaterials() {
             maybeAssign(normalTexture.scale, jsNormal, "scale");
 
             // extensions
-            if (jsNormal.HasMember("extensions")) {
-                normalTexture.extensions = std::move(jsNormal["extensions"]);
-            }
+            normalTexture.extensions = findMember(jsNormal, "extensions");
 
             // extras
 #if R3_GLTF_JSON_EXTRAS
-            if (jsNormal.HasMember("extras")) {
-                normalTexture.extras = std::move(jsNormal["extras"]);
-            }
+            normalTexture.extras = findMember(jsNormal, "extras");
 #endif
         }
 
@@ -539,15 +625,11 @@ void Model::populateMaterials() {
             maybeAssign(occlusionTexture.strength, jsOcclusion, "strength");
 
             // extensions
-            if (jsOcclusion.HasMember("extensions")) {
-                occlusionTexture.extensions = std::move(jsOcclusion["extensions"]);
-            }
+            occlusionTexture.extensions = findMember(jsOcclusion, "extensions");
 
             // extras
 #if R3_GLTF_JSON_EXTRAS
-            if (jsOcclusion.HasMember("extras")) {
-                occlusionTexture.extras = std::move(jsOcclusion["extras"]);
-            }
+            occlusionTexture.extras = findMember(jsOcclusion, "extras");
 #endif
         }
 
@@ -591,9 +673,7 @@ void Model::populateMaterials() {
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itMaterial.HasMember("extras")) {
-            material.extras = std::move(itMaterial["extras"]);
-        }
+        material.extras = findMember(itMaterial, "extras");
 #endif
     }
 }
@@ -625,20 +705,16 @@ void Model::populateMeshes() {
             // targets
             if (itPrimitive.HasMember("targets")) {
                 for (auto& itTarget : itPrimitive["targets"].GetArray()) {
-                    primitive.targets.emplace_back(itTarget.GetObject());
+                    primitive.targets.emplace_back(&itTarget);
                 }
             }
 
             // extensions
-            if (itPrimitive.HasMember("extensions")) {
-                primitive.extensions = std::move(itPrimitive["extensions"]);
-            }
+            primitive.extensions = findMember(itPrimitive, "extensions");
 
             // extras
 #if R3_GLTF_JSON_EXTRAS
-            if (itPrimitive.HasMember("extras")) {
-                primitive.extras = std::move(itPrimitive["extras"]);
-            }
+            primitive.extras = findMember(itPrimitive, "extras");
 #endif
         }
 
@@ -653,15 +729,11 @@ void Model::populateMeshes() {
         maybeAssign(mesh.name, itMesh, "name");
 
         // extensions
-        if (itMesh.HasMember("extensions")) {
-            mesh.extensions = std::move(itMesh["extensions"]);
-        }
+        mesh.extensions = findMember(itMesh, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itMesh.HasMember("extras")) {
-            mesh.extras = std::move(itMesh["extras"]);
-        }
+        mesh.extras = findMember(itMesh, "extras");
 #endif
     }
 }
@@ -729,20 +801,18 @@ void Model::populateNodes() {
         maybeAssign(node.name, itNode, "name");
 
         // extensions
-        if (itNode.HasMember("extensions")) {
-            node.extensions = std::move(itNode["extensions"]);
-        }
+        node.extensions = findMember(itNode, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itNode.HasMember("extras")) {
-            node.extras = std::move(itNode["extras"]);
-        }
+        node.extras = findMember(itNode, "extras");
 #endif
     }
 }
 
-void Model::populateSamplers() {
+void Model::populateSamplers() const {
+    std::vector<Sampler>& samplers = m_samplers.emplace();
+
     if (!m_document.HasMember("samplers")) {
         return;
     }
@@ -766,15 +836,11 @@ void Model::populateSamplers() {
         maybeAssign(sampler.name, itSampler, "name");
 
         // extensions
-        if (itSampler.HasMember("extensions")) {
-            sampler.extensions = std::move(itSampler["extensions"]);
-        }
+        sampler.extensions = findMember(itSampler, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itSampler.HasMember("extras")) {
-            sampler.extras = std::move(itSampler["extras"]);
-        }
+        sampler.extras = findMember(itSampler, "extras");
 #endif
     }
 }
@@ -802,15 +868,11 @@ void Model::populateScenes() {
         maybeAssign(nthScene.name, itScene, "name");
 
         // extensions
-        if (itScene.HasMember("extensions")) {
-            nthScene.extensions = std::move(itScene["extensions"]);
-        }
+        nthScene.extensions = findMember(itScene, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itScene.HasMember("extras")) {
-            nthScene.extras = std::move(itScene["extras"]);
-        }
+        nthScene.extras = findMember(itScene, "extras");
 #endif
     }
 }
@@ -838,15 +900,11 @@ void Model::populateSkins() {
         maybeAssign(skin.name, itSkin, "name");
 
         // extensions
-        if (itSkin.HasMember("extensions")) {
-            skin.extensions = std::move(itSkin["extensions"]);
-        }
+        skin.extensions = findMember(itSkin, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itSkin.HasMember("extras")) {
-            skin.extras = std::move(itSkin["extras"]);
-        }
+        skin.extras = findMember(itSkin, "extras");
 #endif
     }
 }
@@ -869,35 +927,168 @@ void Model::populateTextures() {
         maybeAssign(texture.name, itTexture, "name");
 
         // extensions
-        if (itTexture.HasMember("extensions")) {
-            texture.extensions = std::move(itTexture["extensions"]);
-        }
+        texture.extensions = findMember(itTexture, "extensions");
 
         // extras
 #if R3_GLTF_JSON_EXTRAS
-        if (itTexture.HasMember("extras")) {
-            texture.extras = std::move(itTexture["extras"]);
-        }
+        texture.extras = findMember(itTexture, "extras");
 #endif
     }
 }
 
 void Model::populateExtensions() {
-    if (!m_document.HasMember("extensions")) {
-        return;
-    }
-
-    extensions = std::move(m_document["extensions"]);
+    extensions = findMember(m_document, "extensions");
 }
 
 void Model::populateExtras() {
 #if R3_GLTF_JSON_EXTRAS
-    if (!m_document.HasMember("extras")) {
+    extras = findMember(m_document, "extras");
+#endif
+}
+
+void Model::resolveBufferViews(ThreadPool* threadPool) {
+    struct Decode {
+        usize bufferView;
+        EXT_meshopt_compression compression;
+        std::span<const std::byte> src;
+        std::span<std::byte> dst;
+    };
+    std::vector<Decode> decodes;
+    usize decodedSize = 0;
+    usize compressedSize = 0;
+
+    m_bufferViews.resize(bufferViews.size());
+    for (usize i = 0; const BufferView& bufferView : bufferViews) {
+        const Value* jsMeshopt =
+            bufferView.extensions ? findMember(*bufferView.extensions, EXTENSION_EXT_meshopt_compression) : nullptr;
+
+        if (jsMeshopt == nullptr) {
+            const std::span<const std::byte> data = buffer(bufferView.buffer);
+            ENSURE(usize(bufferView.byteOffset) + bufferView.byteLength <= data.size());
+            m_bufferViews[i++] = data.subspan(bufferView.byteOffset, bufferView.byteLength);
+            continue;
+        }
+
+        Decode& decode = decodes.emplace_back();
+        decode.bufferView = i++;
+        EXT_meshopt_compression::parse(&decode.compression, *jsMeshopt);
+
+        const EXT_meshopt_compression& compression = decode.compression;
+        const std::span<const std::byte> data = buffer(compression.buffer);
+        ENSURE(usize(compression.byteOffset) + compression.byteLength <= data.size());
+        ENSURE(usize(compression.count) * compression.byteStride == bufferView.byteLength);
+
+        decode.src = data.subspan(compression.byteOffset, compression.byteLength);
+        decodedSize = (decodedSize + 15) & ~usize(15); // keep every decoded bufferView aligned for its elements
+        decodedSize += bufferView.byteLength;
+        compressedSize += compression.byteLength;
+    }
+
+    if (decodes.empty()) {
         return;
     }
 
-    extras = std::move(m_document["extras"]);
-#endif
+    // every bufferView decodes into its own range of a single allocation, views into it live as long as the model
+    m_decoded.resize(decodedSize);
+    for (usize offset = 0; Decode& decode : decodes) {
+        offset = (offset + 15) & ~usize(15);
+        decode.dst = std::span(m_decoded).subspan(offset, bufferViews[decode.bufferView].byteLength);
+        m_bufferViews[decode.bufferView] = decode.dst;
+        offset += decode.dst.size();
+    }
+
+    auto run = [](const Decode& decode) {
+        const EXT_meshopt_compression& compression = decode.compression;
+
+        bool success = false;
+        if (compression.mode == "ATTRIBUTES") {
+            success = meshopt::decodeVertexBuffer(decode.dst, compression.count, compression.byteStride, decode.src);
+        } else if (compression.mode == "TRIANGLES") {
+            success = meshopt::decodeIndexBuffer(decode.dst, compression.count, compression.byteStride, decode.src);
+        } else if (compression.mode == "INDICES") {
+            success = meshopt::decodeIndexSequence(decode.dst, compression.count, compression.byteStride, decode.src);
+        }
+
+        const uint32 stride = compression.byteStride;
+        if (!success || compression.filter == "NONE") {
+            return success;
+        } else if (compression.filter == "OCTAHEDRAL" && (stride == 4 || stride == 8)) {
+            meshopt::decodeFilterOctahedral(decode.dst, compression.count, stride);
+        } else if (compression.filter == "QUATERNION" && stride == 8) {
+            meshopt::decodeFilterQuaternion(decode.dst, compression.count);
+        } else if (compression.filter == "EXPONENTIAL" && stride % 4 == 0) {
+            meshopt::decodeFilterExponential(decode.dst, compression.count, stride);
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    // bufferViews are independent, the calling thread and any pool worker free meanwhile pull the next one
+    std::vector<uint8> success(decodes.size(), false);
+    std::atomic<usize> next = 0;
+    auto work = [&]() {
+        for (usize index = next++; index < decodes.size(); index = next++) {
+            success[index] = run(decodes[index]);
+        }
+    };
+
+    // helpers started after the calling thread finished find the decode closed and return without touching it
+    // so only running helpers are waited for, never queued ones, and the caller may itself be a pool worker
+    struct Helpers {
+        std::mutex mutex;
+        std::condition_variable idle;
+        usize running = 0;
+        bool closed = false;
+    };
+    auto helpers = std::make_shared<Helpers>();
+
+    if (threadPool != nullptr) {
+        const usize count = std::min<usize>(decodes.size() - 1, threadPool->threadCount());
+        for (usize i = 0; i < count; i++) {
+            threadPool->enqueue([helpers, &work]() {
+                {
+                    std::scoped_lock lock(helpers->mutex);
+                    if (helpers->closed) {
+                        return;
+                    }
+                    helpers->running++;
+                }
+                work();
+                {
+                    std::scoped_lock lock(helpers->mutex);
+                    helpers->running--;
+                }
+                helpers->idle.notify_all();
+            });
+        }
+    }
+
+    work();
+    {
+        std::unique_lock lock(helpers->mutex);
+        helpers->closed = true;
+        helpers->idle.wait(lock, [&]() { return helpers->running == 0; });
+    }
+
+    for (usize i = 0; i < decodes.size(); i++) {
+        if (!success[i]) {
+            LOG(Error,
+                "failed to decode",
+                EXTENSION_EXT_meshopt_compression,
+                "bufferView",
+                decodes[i].bufferView,
+                "of",
+                m_path,
+                "mode",
+                decodes[i].compression.mode,
+                "filter",
+                decodes[i].compression.filter);
+            ENSURE(false);
+        }
+    }
+
+    LOG(Verbose, "decoded", decodes.size(), "compressed bufferViews from", compressedSize, "to", decodedSize, "bytes");
 }
 
 void Model::checkVersion(std::string_view version) const {
@@ -1,20 +1,42 @@
 #pragma once
 
-#include <fstream>
+#include <span>
 #include "api/Types.hpp"
 #include "glTF.hxx"
+#include "media/MappedFile.hxx"
+
+namespace R3 {
+class ThreadPool;
+} // namespace R3
 
 namespace R3::glTF {
 
 class Model : public Root {
 public:
-    explicit Model(const std::filesystem::path& path);
+    /// @brief Parse the model at path and resolve its bufferViews
+    /// @param path
+    /// @param threadPool decodes EXT_meshopt_compression bufferViews alongside the calling thread, null decodes serially
+    explicit Model(const std::filesystem::path& path, ThreadPool* threadPool = nullptr);
+
+    /// @brief Query a buffer's bytes, a read-only view into the mapped GLB BIN chunk or external .bin
+    /// @param index index into buffers
+    [[nodiscard]] std::span<const std::byte> buffer(usize index) const { return m_buffers[index]; }
+
+    /// @brief Query a bufferView's bytes, resolved against the buffer it references
+    /// EXT_meshopt_compression bufferViews are decoded on load and resolve to their decoded bytes
+    /// @param index index into bufferViews
+    [[nodiscard]] std::span<const std::byte> bufferViewData(usize index) const { return m_bufferViews[index]; }
 
-    [[nodiscard]] constexpr const std::vector<std::byte>& buffer() const { return m_buffer; }
+    /// @brief Query the cameras, populated from the document on first call
+    [[nodiscard]] const std::vector<Camera>& cameras() const;
+
+    /// @brief Query the samplers, populated from the document on first call
+    [[nodiscard]] const std::vector<Sampler>& samplers() const;
 
 private:
-    bool parseGLB(std::ifstream& ifs);  // return true if success
-    bool parseGLTF(std::ifstream& ifs); // return true if success
+    bool parseGLB(std::span<std::byte> file);  // return true if success
+    bool parseGLTF(std::span<std::byte> file); // return true if success
+    void parseJSON(std::span<std::byte> json);
 
     void populateRoot();
 
@@ -26,12 +48,12 @@ private:
     void populateAsset();
     void populateBuffers();
     void populateBufferViews();
-    void populateCameras();
+    void populateCameras() const;
     void populateImages();
     void populateMaterials();
     void populateMeshes();
     void populateNodes();
-    void populateSamplers();
+    void populateSamplers() const;
     void populateScene();
     void populateScenes();
     void populateSkins();
@@ -39,12 +61,22 @@ private:
     void populateExtensions();
     void populateExtras();
 
+    void resolveBufferViews(ThreadPool* threadPool);
+
     void checkVersion(std::string_view version) const;
     void checkVersion(uint32 major, uint32 minor) const;
 
 private:
     rapidjson::Document m_document;
-    std::vector<std::byte> m_buffer;
+    MappedFile m_file;                     // the .gltf or .glb file, JSON (parsed in place) and BIN are views into it
+    std::vector<char> m_json;              // null terminated JSON copy, only when it cannot be terminated in place
+    std::vector<MappedFile> m_bufferFiles; // external .bin files referenced by uri
+    std::span<const std::byte> m_binChunk; // GLB BIN chunk, backs the buffer without a uri
+    std::vector<std::span<const std::byte>> m_buffers;
+    std::vector<std::span<const std::byte>> m_bufferViews; // see resolveBufferViews()
+    std::vector<std::byte> m_decoded;                       // decoded EXT_meshopt_compression bufferViews
+    mutable std::optional<std::vector<Camera>> m_cameras;   // lazily populated, see cameras()
+    mutable std::optional<std::vector<Sampler>> m_samplers; // lazily populated, see samplers()
     std::string m_path;
 };
 
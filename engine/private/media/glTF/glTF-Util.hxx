@@ -5,32 +5,46 @@
 
 namespace R3::glTF {
 
+// single lookup of key in value, nullptr if value has no such member
+static inline const rapidjson::Value* findMember(const rapidjson::Value& value, const char* key) {
+    auto it = value.FindMember(key);
+    return it != value.MemberEnd() ? &it->value : nullptr;
+}
+
 template <typename T>
 static constexpr void maybeAssign(T& dst, const rapidjson::Value& value, const char* key) {
-    if (!value.HasMember(key))
+    const rapidjson::Value* member = findMember(value, key);
+    if (member == nullptr)
         return;
 
     if constexpr (std::is_same_v<T, bool>) {
-        dst = value[key].GetBool();
+        dst = member->GetBool();
     } else if constexpr (std::is_same_v<T, uint32>) {
-        dst = value[key].GetUint();
+        dst = member->GetUint();
     } else if constexpr (std::is_same_v<T, int32>) {
-        dst = value[key].GetInt();
+        dst = member->GetInt();
     } else if constexpr (std::is_same_v<T, uint64>) {
-        dst = value[key].GetUint64();
+        dst = member->GetUint64();
     } else if constexpr (std::is_same_v<T, int64>) {
-        dst = value[key].GetInt64();
+        dst = member->GetInt64();
     } else if constexpr (std::is_same_v<T, float>) {
-        dst = value[key].GetFloat();
+        dst = member->GetFloat();
     } else if constexpr (std::is_same_v<T, double>) {
-        dst = value[key].GetDouble();
+        dst = member->GetDouble();
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+        dst = std::string_view(member->GetString(), member->GetStringLength());
     } else if constexpr (std::is_same_v<T, std::string>) {
-        dst = value[key].GetString();
+        dst = member->GetString();
     }
 }
 
+// string view of a required string member
+static inline std::string_view getString(const rapidjson::Value& value) {
+    return {value.GetString(), value.GetStringLength()};
+}
+
 // TextureInfo helper
-static void populateTextureInfo(TextureInfo& textureInfo, rapidjson::Value& value) {
+static void populateTextureInfo(TextureInfo& textureInfo, const rapidjson::Value& value) {
     // index
     textureInfo.index = value["index"].GetUint();
 
@@ -38,15 +52,11 @@ static void populateTextureInfo(TextureInfo& textureInfo, rapidjson::Value& valu
     maybeAssign(textureInfo.texCoord, value, "texCoord");
 
     // extensions
-    if (value.HasMember("extensions")) {
-        textureInfo.extensions = std::move(value["extensions"]);
-    }
+    textureInfo.extensions = findMember(value, "extensions");
 
     // extras
 #if R3_GLTF_JSON_EXTRAS
-    if (value.HasMember("extras")) {
-        textureInfo.extras = std::move(value["extras"]);
-    }
+    textureInfo.extras = findMember(value, "extras");
 #endif
 }
 
@@ -6,10 +6,13 @@
 
 #include <rapidjson/document.h>
 #include <optional>
+#include <string_view>
 #include "api/Types.hpp"
 
+// Strings and JSON values are views into the Model's in-situ parsed document and live as long as the Model
+
 #if R3_GLTF_JSON_EXTRAS
-#define GLTF_EXTRAS std::optional<rapidjson::Value> extras = std::nullopt
+#define GLTF_EXTRAS const rapidjson::Value* extras = nullptr
 #else
 #define GLTF_EXTRAS
 #endif
@@ -43,11 +46,11 @@
 [ ] KHR_materials_variants
 [ ] KHR_materials_volume
 [ ] KHR_mesh_quantization
-[ ] KHR_texture_basisu
+[w] KHR_texture_basisu (KTX2 images uploading without transcoding, else the fallback source)
 [ ] KHR_texture_transform
 [ ] KHR_xmp_json_ld
 [ ] EXT_mesh_gpu_instancing
-[ ] EXT_meshopt_compression
+[x] EXT_meshopt_compression
 [ ] EXT_texture_webp
 
     --- Multi-Vendor ---
@@ -222,7 +225,7 @@ struct AccessorSparseIndices {
     uint32 bufferView; // REQUIRED
     uint32 byteOffset = 0;
     uint32 componentType; // REQUIRED
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -230,7 +233,7 @@ struct AccessorSparseIndices {
 struct AccessorSparseValues {
     uint32 bufferView; // REQUIRED
     uint32 byteOffset = 0;
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -239,7 +242,7 @@ struct AccessorSparse {
     uint32 count;                  // REQUIRED
     AccessorSparseIndices indices; // REQUIRED
     AccessorSparseValues values;   // REQUIRED
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -250,20 +253,20 @@ struct Accessor {
     uint32 componentType; // REQUIRED
     bool normalized = false;
     uint32 count;     // REQUIRED
-    std::string type; // REQUIRED
+    std::string_view type; // REQUIRED
     std::vector<float> max;
     std::vector<float> min;
-    AccessorSparse sparse = {};
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::optional<AccessorSparse> sparse;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#reference-animation-channel-target
 struct AnimationChannelTarget {
     uint32 node = undefined;
-    std::string path; // REQUIRED
-    std::optional<rapidjson::Value> extensions;
+    std::string_view path; // REQUIRED
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -271,16 +274,16 @@ struct AnimationChannelTarget {
 struct AnimationChannel {
     uint32 sampler;                // REQUIRED
     AnimationChannelTarget target; // REQUIRED
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#reference-animation-sampler
 struct AnimationSampler {
     uint32 input; // REQUIRED
-    std::string interpolation = SAMPLER_LINEAR;
+    std::string_view interpolation = SAMPLER_LINEAR;
     uint32 output; // REQUIRED
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -288,27 +291,27 @@ struct AnimationSampler {
 struct Animation {
     std::vector<AnimationChannel> channels; // REQUIRED
     std::vector<AnimationSampler> samplers; // REQUIRED
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#reference-asset
 struct Asset {
-    std::string copyright;
-    std::string generator;
-    std::string version; // REQUIRED
-    std::string minVersion;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view copyright;
+    std::string_view generator;
+    std::string_view version; // REQUIRED
+    std::string_view minVersion;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#reference-buffer
 struct Buffer {
-    std::string uri;
+    std::string_view uri;
     uint32 byteLength; // REQUIRED
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -319,8 +322,8 @@ struct BufferView {
     uint32 byteLength; // REQUIRED
     uint32 byteStride = undefined;
     uint32 target = undefined;
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -330,7 +333,7 @@ struct CameraOrthographic {
     float ymag;  // REQUIRED
     float zfar;  // REQUIRED
     float znear; // REQUIRED
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -340,7 +343,7 @@ struct CameraPerspective {
     float yfov; // REQUIRED
     float zfar = 0;
     float znear; // REQUIRED
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -348,9 +351,9 @@ struct CameraPerspective {
 struct Camera {
     CameraOrthographic orthographic = {};
     CameraPerspective perspective = {};
-    std::string type; // REQUIRED
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view type; // REQUIRED
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -362,11 +365,11 @@ struct Camera {
 
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#reference-image
 struct Image {
-    std::string uri;
-    std::string mimeType;
+    std::string_view uri;
+    std::string_view mimeType;
     uint32 bufferView = undefined;
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -374,8 +377,8 @@ struct Image {
 struct Texture {
     uint32 sampler = undefined;
     uint32 source = undefined;
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -383,7 +386,7 @@ struct Texture {
 struct TextureInfo {
     uint32 index; // REQUIRED
     uint32 texCoord = 0;
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -392,7 +395,7 @@ struct NormalTextureInfo {
     uint32 index; // REQUIRED
     uint32 texCoord = 0;
     float scale = 1.0f;
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -401,7 +404,7 @@ struct OcclusionTextureInfo {
     uint32 index; // REQUIRED
     uint32 texCoord = 0;
     float strength = 1.0f;
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -412,7 +415,7 @@ struct PBRMetallicRoughness {
     float metallicFactor = 1.0f;
     float roughnessFactor = 1.0f;
     std::optional<TextureInfo> metallicRoughnessTexture;
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -423,10 +426,10 @@ struct Material {
     std::optional<OcclusionTextureInfo> occlusionTexture;
     std::optional<TextureInfo> emissiveTexture;
     float emissiveFactor[3] = {0.0f, 0.0f, 0.0f};
-    std::string alphaMode = OPAQUE;
+    std::string_view alphaMode = OPAQUE;
     float alphaCutoff = 0.5;
     bool doubleSided = false;
-    std::string name;
+    std::string_view name;
     std::vector<std::unique_ptr<glTF::Extension>> extensions;
     GLTF_EXTRAS;
 };
@@ -437,8 +440,8 @@ struct MeshPrimitive {
     uint32 indices = undefined;
     uint32 material = undefined;
     uint32 mode{4};
-    std::vector<rapidjson::Value> targets;
-    std::optional<rapidjson::Value> extensions;
+    std::vector<const rapidjson::Value*> targets;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -446,8 +449,8 @@ struct MeshPrimitive {
 struct Mesh {
     std::vector<MeshPrimitive> primitives; // REQUIRED
     std::vector<float> weights;
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -462,8 +465,8 @@ struct Node {
     float scale[3] = {1.0f, 1.0f, 1.0f};
     float translation[3] = {0.0f, 0.0f, 0.0f};
     std::vector<float> weights;
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -473,16 +476,16 @@ struct Sampler {
     uint32 minFilter = undefined;
     uint32 wrapS{REPEAT};
     uint32 wrapT{REPEAT};
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#reference-scene
 struct Scene {
     std::vector<uint32> nodes;
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -491,31 +494,31 @@ struct Skin {
     uint32 inverseBindMatrices = undefined;
     uint32 skeleton = undefined;
     std::vector<uint32> joints; // REQUIRED
-    std::string name;
-    std::optional<rapidjson::Value> extensions;
+    std::string_view name;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#reference-gltf
 struct Root {
-    std::vector<std::string> extensionsUsed;
-    std::vector<std::string> extensionsRequired;
+    std::vector<std::string_view> extensionsUsed;
+    std::vector<std::string_view> extensionsRequired;
     std::vector<Accessor> accessors;
     std::vector<Animation> animations;
     Asset asset; // REQUIRED
     std::vector<Buffer> buffers;
     std::vector<BufferView> bufferViews;
-    std::vector<Camera> cameras;
+    // cameras are populated on demand, see Model::cameras()
     std::vector<Image> images;
     std::vector<Material> materials;
     std::vector<Mesh> meshes;
     std::vector<Node> nodes;
-    std::vector<Sampler> samplers;
+    // samplers are populated on demand, see Model::samplers()
     uint32 scene = undefined;
     std::vector<Scene> scenes;
     std::vector<Skin> skins;
     std::vector<Texture> textures;
-    std::optional<rapidjson::Value> extensions;
+    const rapidjson::Value* extensions = nullptr;
     GLTF_EXTRAS;
 };
 
@@ -0,0 +1,134 @@
+#include "media/ktx2/Ktx2.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include "api/Ensure.hpp"
+#include "api/Log.hpp"
+
+namespace R3::ktx2 {
+
+namespace local {
+
+struct Header {
+    uint32 vkFormat;
+    uint32 typeSize;
+    uint32 pixelWidth;
+    uint32 pixelHeight;
+    uint32 pixelDepth;
+    uint32 layerCount;
+    uint32 faceCount;
+    uint32 levelCount;
+    uint32 supercompressionScheme;
+};
+
+struct LevelIndex {
+    uint64 byteOffset;
+    uint64 byteLength;
+    uint64 uncompressedByteLength;
+};
+
+static_assert(sizeof(Header) == 36);
+static_assert(sizeof(LevelIndex) == 24);
+
+// data format descriptor, key/value data and supercompression global data offsets between header and level index
+static constexpr usize INDEX_SIZE = 32;
+
+static constexpr uint32 SUPERCOMPRESSION_NONE = 0;
+
+// bytes per 4x4 block, 0 for formats stored per texel
+static usize blockSize(Format format) {
+    switch (format) {
+        case Format::BC1RgbUnormBlock:
+        case Format::BC1RgbSrgbBlock:
+        case Format::BC1RgbaUnormBlock:
+        case Format::BC1RgbaSrgbBlock:
+            return 8;
+        case Format::BC3UnormBlock:
+        case Format::BC3SrgbBlock:
+        case Format::BC5UnormBlock:
+        case Format::BC5SnormBlock:
+        case Format::BC7UnormBlock:
+        case Format::BC7SrgbBlock:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+static bool supported(Format format) {
+    return blockSize(format) != 0 || format == Format::R8G8B8A8Unorm || format == Format::R8G8B8A8Srgb;
+}
+
+} // namespace local
+
+bool isKtx2(std::span<const std::byte> bytes) {
+    return bytes.size() >= sizeof(IDENTIFIER) && std::memcmp(bytes.data(), IDENTIFIER, sizeof(IDENTIFIER)) == 0;
+}
+
+std::optional<Texture> read(std::span<const std::byte> bytes) {
+    ENSURE(isKtx2(bytes));
+
+    local::Header header = {};
+    ENSURE(bytes.size() >= sizeof(IDENTIFIER) + sizeof(header));
+    std::memcpy(&header, bytes.data() + sizeof(IDENTIFIER), sizeof(header));
+
+    const Format format = Format(header.vkFormat);
+    if (header.supercompressionScheme != local::SUPERCOMPRESSION_NONE || !local::supported(format)) {
+        LOG(Warning,
+            "KTX2 vkFormat",
+            header.vkFormat,
+            "with supercompression",
+            header.supercompressionScheme,
+            "needs transcoding, which R3 does not support");
+        return std::nullopt;
+    }
+    if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1 || header.pixelHeight == 0) {
+        LOG(Warning, "KTX2 arrays, cubemaps and 1D or 3D textures are not supported");
+        return std::nullopt;
+    }
+
+    // levelCount 0 asks the loader to generate the mip chain
+    const uint32 levelCount = std::max(header.levelCount, 1u);
+    const usize levelIndexOffset = sizeof(IDENTIFIER) + sizeof(header) + local::INDEX_SIZE;
+    ENSURE(levelIndexOffset + levelCount * sizeof(local::LevelIndex) <= bytes.size());
+
+    Texture texture = {
+        .format = format,
+        .width = header.pixelWidth,
+        .height = header.pixelHeight,
+        .levels = {},
+    };
+
+    for (uint32 level = 0; level < levelCount; level++) {
+        local::LevelIndex index = {};
+        std::memcpy(&index, bytes.data() + levelIndexOffset + level * sizeof(index), sizeof(index));
+
+        const usize size =
+            levelSize(format, std::max(header.pixelWidth >> level, 1u), std::max(header.pixelHeight >> level, 1u));
+        ENSURE(index.byteLength == size && index.byteOffset + index.byteLength <= bytes.size());
+        texture.levels.push_back(bytes.subspan(index.byteOffset, index.byteLength));
+    }
+
+    return texture;
+}
+
+bool blockCompressed(Format format) {
+    return local::blockSize(format) != 0;
+}
+
+usize levelSize(Format format, uint32 width, uint32 height) {
+    if (const usize size = local::blockSize(format)) {
+        return usize((width + 3) / 4) * ((height + 3) / 4) * size;
+    }
+    return usize(width) * height * 4;
+}
+
+usize chainSize(Format format, uint32 width, uint32 height, uint32 levels) {
+    usize size = 0;
+    for (uint32 level = 0; level < levels; level++) {
+        size += levelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+    }
+    return size;
+}
+
+} // namespace R3::ktx2
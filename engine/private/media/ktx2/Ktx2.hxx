@@ -0,0 +1,57 @@
+#pragma once
+
+/// @file Ktx2.hxx
+/// @brief Reader for KTX2 texture containers whose payload the GPU samples as stored
+/// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+/// Supported payloads are BC1, BC3, BC5, BC7 and RGBA8 without supercompression, one 2D image with its mip chain.
+/// Basis Universal (BasisLZ, UASTC) and Zstd payloads need a transcoder, they are reported as unsupported
+
+#include <optional>
+#include <span>
+#include <vector>
+#include "api/Types.hpp"
+#include "render/RenderSpecification.hpp"
+
+namespace R3::ktx2 {
+
+static constexpr uint8 IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+/// @brief Texture stored in a KTX2 container
+struct Texture {
+    Format format = Format::Undefined;
+    uint32 width = 0;                               ///< width of the largest level
+    uint32 height = 0;                              ///< height of the largest level
+    std::vector<std::span<const std::byte>> levels; ///< mip levels, largest first, views into the container
+};
+
+/// @brief Query whether bytes start with the KTX2 identifier
+/// @param bytes
+/// @return true if bytes is a KTX2 container
+bool isKtx2(std::span<const std::byte> bytes);
+
+/// @brief Read a KTX2 container, throws if it is malformed
+/// @param bytes entire container
+/// @return texture viewing bytes, nullopt if the payload is not supported
+std::optional<Texture> read(std::span<const std::byte> bytes);
+
+/// @brief Query whether format is stored in 4x4 blocks, such levels cannot be blitted into a mip chain
+/// @param format
+/// @return true if block compressed
+bool blockCompressed(Format format);
+
+/// @brief Query the byte size of a single mip level
+/// @param format a format supported by read() or R8G8B8A8
+/// @param width
+/// @param height
+/// @return size in bytes
+usize levelSize(Format format, uint32 width, uint32 height);
+
+/// @brief Query the byte size of levels mip levels stored back to back
+/// @param format
+/// @param width of the largest level
+/// @param height of the largest level
+/// @param levels
+/// @return size in bytes
+usize chainSize(Format format, uint32 width, uint32 height, uint32 levels);
+
+} // namespace R3::ktx2
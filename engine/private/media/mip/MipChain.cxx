@@ -0,0 +1,101 @@
+#include "media/mip/MipChain.hxx"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include "api/Check.hpp"
+
+namespace R3::mip {
+
+namespace local {
+
+static float toLinear(float c) {
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float toSrgb(float c) {
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+static const std::array<float, 256>& linearTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values = {};
+        for (usize i = 0; i < values.size(); i++) {
+            values[i] = toLinear(float(i) / 255.0f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+static std::byte quantize(float value) {
+    return std::byte(uint8(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f));
+}
+
+// src is one sw x sh level, dst receives the next one, odd edges reuse the last row or column
+static void downsample(
+    std::span<const std::byte> src, uint32 sw, uint32 sh, std::span<std::byte> dst, uint32 dw, uint32 dh, bool srgb) {
+    const std::array<float, 256>& linear = linearTable();
+
+    for (uint32 y = 0; y < dh; y++) {
+        const uint32 y0 = std::min(2 * y, sh - 1);
+        const uint32 y1 = std::min(2 * y + 1, sh - 1);
+        for (uint32 x = 0; x < dw; x++) {
+            const uint32 x0 = std::min(2 * x, sw - 1);
+            const uint32 x1 = std::min(2 * x + 1, sw - 1);
+            const usize texels[4] = {
+                (usize(y0) * sw + x0) * 4,
+                (usize(y0) * sw + x1) * 4,
+                (usize(y1) * sw + x0) * 4,
+                (usize(y1) * sw + x1) * 4,
+            };
+
+            std::byte* out = dst.data() + (usize(y) * dw + x) * 4;
+            for (usize c = 0; c < 4; c++) {
+                float sum = 0.0f;
+                for (const usize texel : texels) {
+                    const uint8 value = std::to_integer<uint8>(src[texel + c]);
+                    sum += srgb && c < 3 ? linear[value] : float(value) / 255.0f;
+                }
+                out[c] = quantize(srgb && c < 3 ? toSrgb(sum * 0.25f) : sum * 0.25f);
+            }
+        }
+    }
+}
+
+} // namespace local
+
+uint32 levelCount(uint32 width, uint32 height) {
+    return uint32(std::bit_width(std::max({width, height, 1u})));
+}
+
+uint32 generate(std::vector<std::byte>& pixels, uint32 width, uint32 height, bool srgb) {
+    CHECK(pixels.size() == usize(width) * height * 4);
+
+    const uint32 levels = levelCount(width, height);
+
+    usize total = 0;
+    for (uint32 level = 0; level < levels; level++) {
+        total += usize(std::max(width >> level, 1u)) * std::max(height >> level, 1u) * 4;
+    }
+    pixels.resize(total);
+
+    usize offset = 0;
+    for (uint32 level = 1; level < levels; level++) {
+        const uint32 sw = std::max(width >> (level - 1), 1u);
+        const uint32 sh = std::max(height >> (level - 1), 1u);
+        const uint32 dw = std::max(width >> level, 1u);
+        const uint32 dh = std::max(height >> level, 1u);
+        const usize srcSize = usize(sw) * sh * 4;
+
+        const std::span<const std::byte> src(pixels.data() + offset, srcSize);
+        const std::span<std::byte> dst(pixels.data() + offset + srcSize, usize(dw) * dh * 4);
+        local::downsample(src, sw, sh, dst, dw, dh, srgb);
+        offset += srcSize;
+    }
+
+    return levels;
+}
+
+} // namespace R3::mip
@@ -0,0 +1,27 @@
+#pragma once
+
+/// @file MipChain.hxx
+/// @brief CPU mip chain generation for RGBA8 images, so textures upload every level in one copy
+/// @details The only mip path: the cooker bakes with it, TexturePipeline::decode and TextureBuffer use it at runtime
+
+#include <span>
+#include <vector>
+#include "api/Types.hpp"
+
+namespace R3::mip {
+
+/// @brief Query the number of levels in a full mip chain down to 1x1
+/// @param width of the largest level
+/// @param height of the largest level
+/// @return level count, at least 1
+uint32 levelCount(uint32 width, uint32 height);
+
+/// @brief Downsample an RGBA8 image into every coarser level with a 2x2 box filter
+/// @param[in,out] pixels the largest level on input, every level back to back, largest first, on return
+/// @param width of the largest level
+/// @param height of the largest level
+/// @param srgb filter color channels in linear space, matching how an sRGB image is sampled and blitted
+/// @return level count, see levelCount()
+uint32 generate(std::vector<std::byte>& pixels, uint32 width, uint32 height, bool srgb);
+
+} // namespace R3::mip
@@ -0,0 +1,122 @@
+#include "render/ShaderLibrary.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include "api/Ensure.hpp"
+#include "api/Hash.hpp"
+#include "api/Log.hpp"
+#include "media/MappedFile.hxx"
+
+namespace R3 {
+
+namespace local {
+
+// layout written by scripts/compile_shaders.py, little endian, offsets are from the start of the bundle
+static constexpr char BUNDLE_MAGIC[4] = {'R', '3', 'S', 'B'};
+static constexpr uint32 BUNDLE_VERSION = 1;
+
+struct BundleHeader {
+    char magic[4];
+    uint32 version;
+    uint32 count;
+    uint32 reserved;
+};
+
+struct BundleEntry {
+    uint32 nameOffset;
+    uint32 nameSize;
+    uint32 codeOffset; // 4 byte aligned, spirv is read as words
+    uint32 codeSize;
+    uint64 hash; // FNV-1a of the code
+};
+
+static_assert(sizeof(BundleHeader) == 16);
+static_assert(sizeof(BundleEntry) == 24);
+
+} // namespace local
+
+ShaderLibrary::ShaderLibrary(const ShaderLibrarySpecification& spec)
+    : m_logicalDevice(&spec.logicalDevice) {
+    if (!std::filesystem::exists(spec.bundle)) {
+        LOG(Info, "shader bundle", spec.bundle.string(), "not found, reading loose spirv files");
+        return;
+    }
+
+    m_bundle = std::make_unique<MappedFile>(spec.bundle);
+    readIndex();
+    LOG(Info, "shader bundle", spec.bundle.string(), "holds", m_entries.size(), "shaders");
+}
+
+ShaderLibrary::~ShaderLibrary() = default;
+
+std::shared_ptr<const Shader> ShaderLibrary::acquire(std::string_view path) {
+    // bundled code is hashed at build time, a loose file is read in full to hash it and to create its module
+    std::vector<std::byte> loose;
+    std::span<const std::byte> code;
+    uint64 contentHash = 0;
+
+    if (auto it = m_entries.find(path); it != m_entries.end()) {
+        code = it->second.code;
+        contentHash = it->second.hash;
+    } else {
+        std::ifstream ifs(std::string(path), std::ios::ate | std::ios::binary);
+        if (!ifs.is_open()) {
+            LOG(Error, "shader", path, "is neither bundled nor found on disk");
+            ENSURE(false);
+        }
+        loose.resize(usize(ifs.tellg()));
+        ifs.seekg(0);
+        ifs.read(reinterpret_cast<char*>(loose.data()), std::streamsize(loose.size()));
+        ENSURE(ifs.good() && !loose.empty() && loose.size() % 4 == 0); // spirv is read as words
+        code = loose;
+        contentHash = fnv1a(code);
+    }
+
+    const uint64 key = fnv1aMix(fnv1a(path), contentHash);
+
+    std::scoped_lock lock(m_mutex);
+    std::weak_ptr<const Shader>& entry = m_shaders[key];
+    if (std::shared_ptr<const Shader> shader = entry.lock()) {
+        return shader;
+    }
+
+    auto shader = std::make_shared<const Shader>(ShaderSpecification{
+        .logicalDevice = *m_logicalDevice,
+        .path = path,
+        .code = code,
+    });
+    entry = shader;
+    return shader;
+}
+
+void ShaderLibrary::readIndex() {
+    const std::span<const std::byte> bytes = m_bundle->bytes();
+
+    local::BundleHeader header;
+    ENSURE(bytes.size() >= sizeof(header));
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    ENSURE(std::memcmp(header.magic, local::BUNDLE_MAGIC, sizeof(header.magic)) == 0);
+    if (header.version != local::BUNDLE_VERSION) {
+        LOG(Error, "shader bundle is version", header.version, "while R3 reads version", local::BUNDLE_VERSION);
+        ENSURE(false);
+    }
+    ENSURE(bytes.size() >= sizeof(header) + usize(header.count) * sizeof(local::BundleEntry));
+
+    for (uint32 i = 0; i < header.count; i++) {
+        local::BundleEntry entry;
+        std::memcpy(&entry, bytes.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        ENSURE(usize(entry.nameOffset) + entry.nameSize <= bytes.size());
+        ENSURE(usize(entry.codeOffset) + entry.codeSize <= bytes.size());
+        ENSURE(entry.codeOffset % 4 == 0 && entry.codeSize % 4 == 0);
+
+        const std::string_view name(reinterpret_cast<const char*>(bytes.data() + entry.nameOffset), entry.nameSize);
+        m_entries.emplace(name,
+                          Entry{
+                              .code = bytes.subspan(entry.codeOffset, entry.codeSize),
+                              .hash = entry.hash,
+                          });
+    }
+}
+
+} // namespace R3
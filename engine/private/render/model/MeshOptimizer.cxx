@@ -0,0 +1,420 @@
+#include "render/model/MeshOptimizer.hxx"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include "api/Hash.hpp"
+#include "api/Log.hpp"
+
+namespace R3::optimize {
+
+namespace local {
+
+static constexpr uint32 NONE = ~0u;
+
+// triangles adjacent to every vertex, triangles of vertex v are triangles[offsets[v]..offsets[v + 1]]
+struct Adjacency {
+    std::vector<uint32> offsets;
+    std::vector<uint32> triangles;
+};
+
+static Adjacency adjacency(std::span<const uint32> indices, usize vertexCount) {
+    Adjacency adjacency;
+    adjacency.offsets.assign(vertexCount + 1, 0);
+    adjacency.triangles.resize(indices.size());
+
+    for (uint32 index : indices) {
+        adjacency.offsets[index + 1]++;
+    }
+    for (usize v = 0; v < vertexCount; v++) {
+        adjacency.offsets[v + 1] += adjacency.offsets[v];
+    }
+
+    std::vector<uint32> fill(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+    for (usize i = 0; i < indices.size(); i++) {
+        adjacency.triangles[fill[indices[i]]++] = uint32(i / 3);
+    }
+
+    return adjacency;
+}
+
+// FIFO cache of CACHE_SIZE entries, a vertex is cached while fewer than CACHE_SIZE misses happened since its own
+class Cache {
+public:
+    explicit Cache(usize vertexCount)
+        : m_time(vertexCount, 0) {}
+
+    // access vertex, return true on a miss
+    bool access(uint32 vertex) {
+        if (m_timestamp - m_time[vertex] > CACHE_SIZE) {
+            m_time[vertex] = m_timestamp++;
+            return true;
+        }
+        return false;
+    }
+
+    // age of vertex in misses, > CACHE_SIZE if not cached
+    [[nodiscard]] uint32 age(uint32 vertex) const { return m_timestamp - m_time[vertex]; }
+
+    // evict every vertex
+    void flush() { m_timestamp += CACHE_SIZE + 1; }
+
+private:
+    std::vector<uint32> m_time;
+    uint32 m_timestamp = CACHE_SIZE + 1;
+};
+
+// every Vertex attribute quantized to the weld grid, boneIDs are taken as is
+using WeldKey = std::array<int64, sizeof(Vertex) / sizeof(float)>;
+static_assert(sizeof(Vertex) == sizeof(float) * 18 + sizeof(ivec4));
+
+static WeldKey weldKey(const Vertex& vertex, float epsilon) {
+    const float inverse = epsilon > 0.0f ? 1.0f / epsilon : 0.0f;
+    auto quantize = [&](float value) -> int64 {
+        if (inverse == 0.0f) {
+            return value == 0.0f ? 0 : int64(std::bit_cast<uint32>(value)); // +0 and -0 weld
+        }
+        return int64(std::floor(double(value) * inverse + 0.5));
+    };
+
+    WeldKey key;
+    usize k = 0;
+    for (const vec3& v : {vertex.position, vertex.normal, vertex.tangent, vertex.bitangent}) {
+        key[k++] = quantize(v.x);
+        key[k++] = quantize(v.y);
+        key[k++] = quantize(v.z);
+    }
+    key[k++] = quantize(vertex.textureCoords.x);
+    key[k++] = quantize(vertex.textureCoords.y);
+    for (usize i = 0; i < 4; i++) {
+        key[k++] = vertex.boneIDs[i];
+    }
+    for (usize i = 0; i < 4; i++) {
+        key[k++] = quantize(vertex.weights[i]);
+    }
+
+    return key;
+}
+
+// FNV-1a over the key
+static uint64 weldHash(const WeldKey& key) {
+    uint64 hash = FNV_OFFSET;
+    for (int64 value : key) {
+        hash = fnv1aMix(hash, uint64(value));
+    }
+    return hash ^ (hash >> 32);
+}
+
+} // namespace local
+
+usize weld(std::vector<Vertex>& vertices, std::span<uint32> indices, float epsilon) {
+    if (vertices.empty()) {
+        return 0;
+    }
+    if (std::any_of(indices.begin(), indices.end(), [&](uint32 index) { return index >= vertices.size(); })) {
+        LOG(Warning, "index out of range, mesh left unwelded");
+        return 0;
+    }
+
+    // open addressing table at most half full, slots hold indices into welded
+    const usize capacity = std::bit_ceil(vertices.size() * 2);
+    std::vector<uint32> table(capacity, local::NONE);
+    std::vector<local::WeldKey> keys;
+    std::vector<Vertex> welded;
+    std::vector<uint32> remap(vertices.size());
+    keys.reserve(vertices.size());
+    welded.reserve(vertices.size());
+
+    for (usize v = 0; v < vertices.size(); v++) {
+        const local::WeldKey key = local::weldKey(vertices[v], epsilon);
+
+        usize slot = local::weldHash(key) & (capacity - 1);
+        while (table[slot] != local::NONE && keys[table[slot]] != key) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+
+        if (table[slot] == local::NONE) {
+            table[slot] = uint32(welded.size());
+            keys.push_back(key);
+            welded.push_back(vertices[v]);
+        }
+        remap[v] = table[slot];
+    }
+
+    for (uint32& index : indices) {
+        index = remap[index];
+    }
+
+    const usize removed = vertices.size() - welded.size();
+    vertices = std::move(welded);
+
+    return removed;
+}
+
+float acmr(std::span<const uint32> indices, usize vertexCount, usize cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+
+    std::vector<uint32> time(vertexCount, 0);
+    uint32 timestamp = uint32(cacheSize) + 1;
+    usize misses = 0;
+
+    for (uint32 index : indices) {
+        if (timestamp - time[index] > cacheSize) {
+            time[index] = timestamp++;
+            misses++;
+        }
+    }
+
+    return float(misses) / float(indices.size() / 3);
+}
+
+std::vector<uint32> vertexCache(std::span<uint32> indices, usize vertexCount) {
+    const usize triangleCount = indices.size() / 3;
+    std::vector<uint32> clusters;
+    if (triangleCount == 0) {
+        return clusters;
+    }
+
+    const local::Adjacency adjacency = local::adjacency(indices, vertexCount);
+
+    // triangles of every vertex not yet emitted
+    std::vector<uint32> live(vertexCount);
+    for (usize v = 0; v < vertexCount; v++) {
+        live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+    }
+
+    local::Cache cache(vertexCount);
+    std::vector<uint8> emitted(triangleCount, false);
+    std::vector<uint32> deadEnd;
+    std::vector<uint32> candidates;
+    std::vector<uint32> output;
+    output.reserve(indices.size());
+
+    uint32 cursor = 0;
+
+    // most recently touched vertex with live triangles, else the next one in input order, starts a new cluster
+    auto skipDeadEnd = [&]() -> uint32 {
+        while (!deadEnd.empty()) {
+            const uint32 vertex = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[vertex] > 0) {
+                return vertex;
+            }
+        }
+        for (; cursor < vertexCount; cursor++) {
+            if (live[cursor] > 0) {
+                return cursor;
+            }
+        }
+        return local::NONE;
+    };
+
+    uint32 fanning = skipDeadEnd();
+    clusters.push_back(0);
+
+    while (fanning != local::NONE) {
+        candidates.clear();
+
+        // emit every remaining triangle around the fanning vertex
+        for (uint32 i = adjacency.offsets[fanning]; i < adjacency.offsets[fanning + 1]; i++) {
+            const uint32 triangle = adjacency.triangles[i];
+            if (emitted[triangle]) {
+                continue;
+            }
+
+            for (usize k = 0; k < 3; k++) {
+                const uint32 vertex = indices[triangle * 3 + k];
+                output.push_back(vertex);
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                live[vertex]--;
+                cache.access(vertex);
+            }
+            emitted[triangle] = true;
+        }
+
+        // fan next around the oldest candidate that stays in cache while its own triangles are emitted
+        uint32 next = local::NONE;
+        int64 best = -1;
+        for (uint32 vertex : candidates) {
+            if (live[vertex] == 0) {
+                continue;
+            }
+
+            int64 priority = 0;
+            if (cache.age(vertex) + 2 * live[vertex] <= CACHE_SIZE) {
+                priority = cache.age(vertex);
+            }
+            if (priority > best) {
+                best = priority;
+                next = vertex;
+            }
+        }
+
+        if (next == local::NONE) {
+            next = skipDeadEnd();
+            if (next != local::NONE) {
+                clusters.push_back(uint32(output.size() / 3));
+            }
+        }
+
+        fanning = next;
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+    return clusters;
+}
+
+usize overdraw(std::span<uint32> indices, std::span<const Vertex> vertices, std::span<const uint32> clusters) {
+    const usize triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || clusters.empty()) {
+        return 0;
+    }
+
+    local::Cache cache(vertices.size());
+    auto misses = [&](usize triangle) {
+        return usize(cache.access(indices[triangle * 3 + 0])) + usize(cache.access(indices[triangle * 3 + 1])) +
+               usize(cache.access(indices[triangle * 3 + 2]));
+    };
+
+    // split every cluster further as soon as the ACMR of its prefix is close to that of the whole cluster
+    // smaller clusters sort better while the cache cost of breaking there stays within OVERDRAW_THRESHOLD
+    std::vector<uint32> splits;
+    for (usize c = 0; c < clusters.size(); c++) {
+        const usize start = clusters[c];
+        const usize end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+
+        cache.flush();
+        usize clusterMisses = 0;
+        for (usize t = start; t < end; t++) {
+            clusterMisses += misses(t);
+        }
+        const float threshold = OVERDRAW_THRESHOLD * float(clusterMisses) / float(end - start);
+
+        cache.flush();
+        splits.push_back(uint32(start));
+
+        usize runningMisses = 0;
+        usize runningTriangles = 0;
+        for (usize t = start; t < end; t++) {
+            runningMisses += misses(t);
+            runningTriangles++;
+
+            if (t + 1 < end && float(runningMisses) / float(runningTriangles) <= threshold) {
+                splits.push_back(uint32(t + 1));
+                cache.flush();
+                runningMisses = 0;
+                runningTriangles = 0;
+            }
+        }
+    }
+
+    auto position = [&](usize triangle, usize k) { return vertices[indices[triangle * 3 + k]].position; };
+
+    // area weighted centroid of the whole mesh
+    vec3 meshCentroid = vec3(0.0f);
+    float meshArea = 0.0f;
+    for (usize t = 0; t < triangleCount; t++) {
+        const vec3 p0 = position(t, 0);
+        const vec3 p1 = position(t, 1);
+        const vec3 p2 = position(t, 2);
+        const float area = glm::length(glm::cross(p1 - p0, p2 - p0));
+
+        meshCentroid += (p0 + p1 + p2) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid = meshCentroid / meshArea;
+    }
+
+    // clusters facing away from the mesh centre and far from it occlude the rest, draw them first
+    struct Cluster {
+        uint32 start;
+        uint32 end;
+        float key;
+    };
+
+    std::vector<Cluster> sorted;
+    sorted.reserve(splits.size());
+    for (usize c = 0; c < splits.size(); c++) {
+        const uint32 start = splits[c];
+        const uint32 end = c + 1 < splits.size() ? splits[c + 1] : uint32(triangleCount);
+
+        vec3 centroid = vec3(0.0f);
+        vec3 normal = vec3(0.0f);
+        float area = 0.0f;
+        for (usize t = start; t < end; t++) {
+            const vec3 p0 = position(t, 0);
+            const vec3 p1 = position(t, 1);
+            const vec3 p2 = position(t, 2);
+            const vec3 n = glm::cross(p1 - p0, p2 - p0);
+            const float a = glm::length(n);
+
+            centroid += (p0 + p1 + p2) * (a / 3.0f);
+            normal += n;
+            area += a;
+        }
+
+        float key = 0.0f;
+        const float length = glm::length(normal);
+        if (area > 0.0f && length > 0.0f) {
+            key = glm::dot(centroid / area - meshCentroid, normal / length);
+        }
+
+        sorted.push_back({start, end, key});
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+    std::vector<uint32> output;
+    output.reserve(indices.size());
+    for (const Cluster& cluster : sorted) {
+        output.insert(output.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+
+    return sorted.size();
+}
+
+void vertexFetch(std::vector<Vertex>& vertices, std::span<uint32> indices) {
+    std::vector<uint32> remap(vertices.size(), local::NONE);
+    std::vector<Vertex> fetched;
+    fetched.reserve(vertices.size());
+
+    for (uint32& index : indices) {
+        if (remap[index] == local::NONE) {
+            remap[index] = uint32(fetched.size());
+            fetched.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices = std::move(fetched);
+}
+
+Stats optimize(std::vector<Vertex>& vertices, std::span<uint32> indices) {
+    Stats stats;
+
+    if (indices.size() < 3 || indices.size() % 3 != 0) {
+        return stats;
+    }
+    if (std::any_of(indices.begin(), indices.end(), [&](uint32 index) { return index >= vertices.size(); })) {
+        LOG(Warning, "index out of range, mesh left unoptimized");
+        return stats;
+    }
+
+    stats.acmrBefore = acmr(indices, vertices.size());
+
+    const std::vector<uint32> clusters = vertexCache(indices, vertices.size());
+    stats.clusters = overdraw(indices, vertices, clusters);
+    vertexFetch(vertices, indices);
+
+    stats.acmrAfter = acmr(indices, vertices.size());
+
+    return stats;
+}
+
+} // namespace R3::optimize
@@ -0,0 +1,75 @@
+#pragma once
+
+/// @file MeshOptimizer.hxx
+/// @brief Vertex welding and triangle and vertex reordering passes run on decoded meshes before upload or baking
+/// Apart from welding, passes only reorder data, the rendered result is identical
+///
+/// 0. weld         - collapses vertices whose attributes are equal within an epsilon, rewrites indices
+/// 1. vertexCache  - Tipsify (Sander et al. 2007), reorders triangles for post-transform vertex cache hits
+/// 2. overdraw     - splits the cache order into clusters and sorts them outward facing first to reduce overdraw
+/// 3. vertexFetch  - reorders vertices by first use so vertex fetch walks memory linearly
+
+#include <span>
+#include <vector>
+#include "api/Types.hpp"
+#include "render/RenderSpecification.hpp"
+#include "render/ShaderObjects.hpp"
+
+namespace R3::optimize {
+
+/// @brief Post-transform cache size the passes optimize for, a conservative FIFO size for current hardware
+static constexpr usize CACHE_SIZE = 16;
+
+/// @brief Overdraw clusters are split once their ACMR is within this factor of the vertex cache cluster they came from
+static constexpr float OVERDRAW_THRESHOLD = 1.05f;
+
+/// @brief Default weld epsilon, attributes are compared on a grid of this spacing
+static constexpr float WELD_EPSILON = 1e-6f;
+
+/// @brief Results of optimize
+struct Stats {
+    float acmrBefore = 0.0f; ///< average cache miss ratio, transformed vertices per triangle
+    float acmrAfter = 0.0f;  ///< average cache miss ratio, transformed vertices per triangle
+    usize clusters = 0;      ///< number of clusters sorted for overdraw
+};
+
+/// @brief Collapse vertices with equal position, normal, tangent, bitangent, UV and skin data and remap indices
+/// Attributes are quantized to a grid of epsilon spacing and hashed, an epsilon of 0 welds bit identical vertices only
+/// @param[in,out] vertices
+/// @param[in,out] indices
+/// @param epsilon
+/// @return number of vertices removed
+usize weld(std::vector<Vertex>& vertices, std::span<uint32> indices, float epsilon = WELD_EPSILON);
+
+/// @brief Simulate a FIFO post-transform cache over indices
+/// @param indices triangle list
+/// @param vertexCount number of vertices referenced by indices
+/// @param cacheSize
+/// @return average cache miss ratio, between 0.5 (ideal) and 3.0 (no reuse)
+float acmr(std::span<const uint32> indices, usize vertexCount, usize cacheSize = CACHE_SIZE);
+
+/// @brief Reorder triangles for vertex cache locality
+/// @param[in,out] indices triangle list
+/// @param vertexCount number of vertices referenced by indices
+/// @return index of the first triangle of every cluster, cache misses are only forced at cluster starts
+std::vector<uint32> vertexCache(std::span<uint32> indices, usize vertexCount);
+
+/// @brief Reorder clusters of triangles so outward facing, distant ones are drawn first
+/// @param[in,out] indices triangle list in vertex cache order
+/// @param vertices
+/// @param clusters cluster starts returned by vertexCache
+/// @return number of clusters after splitting
+usize overdraw(std::span<uint32> indices, std::span<const Vertex> vertices, std::span<const uint32> clusters);
+
+/// @brief Reorder vertices by first use in indices and remap indices, unreferenced vertices are dropped
+/// @param[in,out] vertices
+/// @param[in,out] indices
+void vertexFetch(std::vector<Vertex>& vertices, std::span<uint32> indices);
+
+/// @brief Run every pass in order
+/// @param[in,out] vertices
+/// @param[in,out] indices triangle list
+/// @return stats, unchanged data when indices is not a triangle list
+Stats optimize(std::vector<Vertex>& vertices, std::span<uint32> indices);
+
+} // namespace R3::optimize
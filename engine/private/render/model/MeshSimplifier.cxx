@@ -0,0 +1,303 @@
+#include "render/model/MeshSimplifier.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include "render/model/MeshOptimizer.hxx"
+
+namespace R3::optimize {
+
+namespace local {
+
+// symmetric 4x4 matrix summing squared distances to planes, stored as its upper triangle
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+    double a11 = 0, a12 = 0, a13 = 0;
+    double a22 = 0, a23 = 0;
+    double a33 = 0;
+
+    // plane n.p + d = 0 with unit n
+    void addPlane(dvec3 n, double d) {
+        a00 += n.x * n.x, a01 += n.x * n.y, a02 += n.x * n.z, a03 += n.x * d;
+        a11 += n.y * n.y, a12 += n.y * n.z, a13 += n.y * d;
+        a22 += n.z * n.z, a23 += n.z * d;
+        a33 += d * d;
+    }
+
+    void operator+=(const Quadric& q) {
+        a00 += q.a00, a01 += q.a01, a02 += q.a02, a03 += q.a03;
+        a11 += q.a11, a12 += q.a12, a13 += q.a13;
+        a22 += q.a22, a23 += q.a23;
+        a33 += q.a33;
+    }
+
+    // sum of squared distances from p to every plane
+    [[nodiscard]] double evaluate(dvec3 p) const {
+        const double error = a00 * p.x * p.x + 2 * a01 * p.x * p.y + 2 * a02 * p.x * p.z + 2 * a03 * p.x +
+                             a11 * p.y * p.y + 2 * a12 * p.y * p.z + 2 * a13 * p.y + a22 * p.z * p.z +
+                             2 * a23 * p.z + a33;
+        return std::max(error, 0.0);
+    }
+};
+
+// collapse of vertex from onto vertex to, stale once either version changed
+struct Collapse {
+    double cost;
+    uint32 from;
+    uint32 to;
+    uint32 fromVersion;
+    uint32 toVersion;
+
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+static dvec3 position(std::span<const Vertex> vertices, uint32 v) {
+    return dvec3(vertices[v].position);
+}
+
+// vertices sharing a position with another vertex sit on an attribute seam
+static void lockSeams(std::span<const Vertex> vertices, std::span<const uint32> used, std::vector<uint8>& locked) {
+    std::vector<uint32> order(used.begin(), used.end());
+    auto less = [&](uint32 a, uint32 b) {
+        const vec3& p = vertices[a].position;
+        const vec3& q = vertices[b].position;
+        return p.x != q.x ? p.x < q.x : p.y != q.y ? p.y < q.y : p.z < q.z;
+    };
+    std::sort(order.begin(), order.end(), less);
+
+    for (usize i = 1; i < order.size(); i++) {
+        if (vertices[order[i - 1]].position == vertices[order[i]].position) {
+            locked[order[i - 1]] = true;
+            locked[order[i]] = true;
+        }
+    }
+}
+
+// edges used by other than exactly two triangles are borders or non manifold
+static void lockBorders(std::span<const uint32> indices, std::vector<uint8>& locked) {
+    std::vector<uint64> edges;
+    edges.reserve(indices.size());
+    for (usize i = 0; i < indices.size(); i += 3) {
+        for (usize k = 0; k < 3; k++) {
+            const uint32 a = indices[i + k];
+            const uint32 b = indices[i + (k + 1) % 3];
+            edges.push_back(uint64(std::min(a, b)) << 32 | std::max(a, b));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for (usize i = 0; i < edges.size();) {
+        usize j = i;
+        while (j < edges.size() && edges[j] == edges[i]) {
+            j++;
+        }
+        if (j - i != 2) {
+            locked[edges[i] >> 32] = true;
+            locked[edges[i] & 0xFFFF'FFFF] = true;
+        }
+        i = j;
+    }
+}
+
+} // namespace local
+
+std::vector<uint32> simplify(std::span<const Vertex> vertices,
+                             std::span<const uint32> indices,
+                             usize targetIndexCount,
+                             float& error) {
+    error = 0.0f;
+
+    std::vector<uint32> triangles(indices.begin(), indices.end());
+    const usize triangleCount = triangles.size() / 3;
+    if (triangles.size() <= targetIndexCount) {
+        return triangles;
+    }
+
+    std::vector<uint32> used(triangles.begin(), triangles.end());
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+
+    std::vector<uint8> locked(vertices.size(), false);
+    local::lockSeams(vertices, used, locked);
+    local::lockBorders(triangles, locked);
+
+    // planes of every triangle, and the triangles around every vertex
+    std::vector<local::Quadric> quadrics(vertices.size());
+    std::vector<std::vector<uint32>> adjacency(vertices.size());
+    for (usize t = 0; t < triangleCount; t++) {
+        const uint32* tri = &triangles[t * 3];
+        const dvec3 p0 = local::position(vertices, tri[0]);
+        const dvec3 n = glm::cross(local::position(vertices, tri[1]) - p0, local::position(vertices, tri[2]) - p0);
+        const double length = glm::length(n);
+
+        for (usize k = 0; k < 3; k++) {
+            adjacency[tri[k]].push_back(uint32(t));
+        }
+        if (length > 0.0) {
+            const dvec3 unit = n / length;
+            for (usize k = 0; k < 3; k++) {
+                quadrics[tri[k]].addPlane(unit, -glm::dot(unit, p0));
+            }
+        }
+    }
+
+    std::vector<uint8> dead(triangleCount, false);
+    std::vector<uint8> removed(vertices.size(), false);
+    std::vector<uint32> version(vertices.size(), 0);
+    std::priority_queue<local::Collapse, std::vector<local::Collapse>, std::greater<>> queue;
+
+    auto push = [&](uint32 from, uint32 to) {
+        if (locked[from]) {
+            return;
+        }
+        local::Quadric q = quadrics[from];
+        q += quadrics[to];
+        queue.push({q.evaluate(local::position(vertices, to)), from, to, version[from], version[to]});
+    };
+
+    // every interior edge is used by two triangles in opposite directions, queue it once from a < b
+    for (usize i = 0; i < triangles.size(); i += 3) {
+        for (usize k = 0; k < 3; k++) {
+            const uint32 a = triangles[i + k];
+            const uint32 b = triangles[i + (k + 1) % 3];
+            if (a < b) {
+                push(a, b);
+                push(b, a);
+            }
+        }
+    }
+
+    std::vector<uint32> neighbors;
+    auto pushAround = [&](uint32 v) {
+        neighbors.clear();
+        for (uint32 t : adjacency[v]) {
+            for (usize k = 0; k < 3; k++) {
+                if (triangles[t * 3 + k] != v) {
+                    neighbors.push_back(triangles[t * 3 + k]);
+                }
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        for (uint32 w : neighbors) {
+            push(v, w);
+            push(w, v);
+        }
+    };
+
+    // collapsing from onto to must not flip or degenerate any triangle that survives it
+    auto flips = [&](uint32 from, uint32 to) {
+        const dvec3 target = local::position(vertices, to);
+        for (uint32 t : adjacency[from]) {
+            const uint32* tri = &triangles[t * 3];
+            if (dead[t] || tri[0] == to || tri[1] == to || tri[2] == to) {
+                continue;
+            }
+
+            dvec3 p[3];
+            for (usize k = 0; k < 3; k++) {
+                p[k] = local::position(vertices, tri[k]);
+            }
+            const dvec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+            for (usize k = 0; k < 3; k++) {
+                if (tri[k] == from) {
+                    p[k] = target;
+                }
+            }
+            const dvec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+            if (glm::dot(before, after) <= 0.25 * glm::length(before) * glm::length(after)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    usize liveTriangles = triangleCount;
+    double maxCost = 0.0;
+
+    while (liveTriangles * 3 > targetIndexCount && !queue.empty()) {
+        const local::Collapse collapse = queue.top();
+        queue.pop();
+
+        const uint32 from = collapse.from;
+        const uint32 to = collapse.to;
+        if (removed[from] || removed[to] || collapse.fromVersion != version[from] ||
+            collapse.toVersion != version[to] || flips(from, to)) {
+            continue;
+        }
+
+        // triangles sharing the edge vanish, the rest move over to to
+        for (uint32 t : adjacency[from]) {
+            if (dead[t]) {
+                continue;
+            }
+            uint32* tri = &triangles[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                dead[t] = true;
+                liveTriangles--;
+                continue;
+            }
+            for (usize k = 0; k < 3; k++) {
+                if (tri[k] == from) {
+                    tri[k] = to;
+                }
+            }
+            adjacency[to].push_back(t);
+        }
+
+        std::erase_if(adjacency[to], [&](uint32 t) { return dead[t]; });
+        adjacency[from].clear();
+        removed[from] = true;
+        quadrics[to] += quadrics[from];
+        version[to]++;
+        maxCost = std::max(maxCost, collapse.cost);
+
+        pushAround(to);
+    }
+
+    std::vector<uint32> result;
+    result.reserve(liveTriangles * 3);
+    for (usize t = 0; t < triangleCount; t++) {
+        if (!dead[t]) {
+            result.insert(result.end(), triangles.begin() + t * 3, triangles.begin() + t * 3 + 3);
+        }
+    }
+
+    // cost sums squared distances to every merged plane, so its root bounds the distance to each of them
+    error = float(std::sqrt(maxCost));
+    return result;
+}
+
+std::vector<Lod> lodChain(std::span<const Vertex> vertices,
+                          std::span<const uint32> indices,
+                          usize count,
+                          float reduction) {
+    std::vector<Lod> lods;
+    lods.reserve(count); // previous views the indices of the last level
+
+    std::span<const uint32> previous = indices;
+    float previousError = 0.0f;
+
+    while (lods.size() < count && previous.size() / 3 >= MIN_LOD_TRIANGLES) {
+        const usize target = usize(float(previous.size() / 3) * reduction) * 3;
+
+        float error = 0.0f;
+        std::vector<uint32> simplified = simplify(vertices, previous, target, error);
+        if (simplified.empty() || float(simplified.size()) > float(previous.size()) * MIN_LOD_REDUCTION) {
+            break;
+        }
+
+        vertexCache(simplified, vertices.size());
+
+        // every level simplifies the previous one, so deviations from the full mesh add up
+        previousError += error;
+        lods.push_back({std::move(simplified), previousError});
+        previous = lods.back().indices;
+    }
+
+    return lods;
+}
+
+} // namespace R3::optimize
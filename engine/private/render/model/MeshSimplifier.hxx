@@ -0,0 +1,51 @@
+#pragma once
+
+/// @file MeshSimplifier.hxx
+/// @brief Quadric error edge collapse simplification (Garland and Heckbert 1997) used to build LOD chains
+/// Vertices are never moved or created, every LOD is an index buffer into the vertex buffer of the full mesh
+/// Vertices on borders and attribute seams are locked so LODs keep their silhouette and UV layout
+
+#include <span>
+#include <vector>
+#include "api/Types.hpp"
+#include "render/RenderSpecification.hpp"
+#include "render/ShaderObjects.hpp"
+
+namespace R3::optimize {
+
+/// @brief Meshes below this many triangles get no further LODs
+static constexpr usize MIN_LOD_TRIANGLES = 64;
+
+/// @brief A level is dropped if simplification keeps more than this fraction of the previous level's triangles
+static constexpr float MIN_LOD_REDUCTION = 0.85f;
+
+/// @brief Simplified index buffer
+struct Lod {
+    std::vector<uint32> indices; ///< triangle list into the vertices of the full mesh
+    float error = 0.0f;          ///< upper bound of the geometric deviation from the full mesh, in model units
+};
+
+/// @brief Simplify a triangle list by collapsing the cheapest edges first
+/// @param vertices
+/// @param indices triangle list
+/// @param targetIndexCount stop once at most this many indices remain
+/// @param[out] error geometric deviation of the result from indices, in model units
+/// @return simplified triangle list indexing vertices
+std::vector<uint32> simplify(std::span<const Vertex> vertices,
+                             std::span<const uint32> indices,
+                             usize targetIndexCount,
+                             float& error);
+
+/// @brief Build up to count LODs, every level targets reduction times the triangles of the previous one
+/// Every level is reordered for the vertex cache, see MeshOptimizer.hxx
+/// @param vertices
+/// @param indices triangle list of the full mesh
+/// @param count
+/// @param reduction
+/// @return coarser levels in order, possibly fewer than count
+std::vector<Lod> lodChain(std::span<const Vertex> vertices,
+                          std::span<const uint32> indices,
+                          usize count,
+                          float reduction);
+
+} // namespace R3::optimize
@@ -0,0 +1,77 @@
+#pragma once
+
+/// @file ModelData.hxx
+/// @brief CPU side model data, the result of decoding a glTF or reading a baked .r3asset
+/// ModelLoader uploads it to the GPU and the asset format serializes it
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <variant>
+#include <vector>
+#include "render/RenderSpecification.hpp"
+#include "render/ShaderObjects.hpp"
+#include "render/TextureBuffer.hpp"
+#include "render/model/KeyFrame.hpp"
+#include "render/model/Skeleton.hpp"
+
+namespace R3 {
+
+/// @brief Texture payload, at most one of (path|encoded|pixels) is set
+/// A texture with none set is an unused glTF texture slot and is not uploaded
+struct TextureData {
+    std::filesystem::path path;                 ///< external encoded image (png, jpeg, ktx2)
+    std::span<const std::byte> encoded;         ///< encoded image embedded in a buffer
+    std::filesystem::path fallbackPath;         ///< glTF fallback of a ktx2 image, used if the GPU cannot sample it
+    std::span<const std::byte> fallbackEncoded; ///< embedded fallback, at most one of (fallbackPath|fallbackEncoded)
+    std::span<const std::byte> pixels;          ///< mipLevels levels of format back to back, largest first
+    uint32 width = 0;                           ///< width of the largest level of pixels
+    uint32 height = 0;                          ///< height of the largest level of pixels
+    Format format = Format::R8G8B8A8Srgb;       ///< format of pixels
+    uint32 mipLevels = 1;                       ///< levels in pixels
+    TextureType type = TextureType::Nil;
+};
+
+/// @brief Indices of a mesh, 16 bit whenever every index fits
+using IndexData = std::variant<std::span<const uint16>, std::span<const uint32>>;
+
+/// @brief Simplified level of detail of a mesh, indexing the vertices of the full mesh
+struct LodData {
+    IndexData indices;
+    float error = 0.0f; ///< geometric deviation from the full mesh, in model units
+};
+
+/// @brief Geometry and material bindings of a single mesh primitive
+struct MeshData {
+    std::span<const Vertex> vertices;
+    IndexData indices;
+    std::vector<LodData> lods;         ///< coarser levels after indices, see MeshSimplifier.hxx
+    std::vector<usize> textureIndices; ///< indices into ModelData::textures
+
+    /// @brief Query number of indices regardless of their width
+    [[nodiscard]] usize indexCount() const {
+        return std::visit([](auto indices) { return indices.size(); }, indices);
+    }
+};
+
+/// @brief Everything needed to create a ModelComponent, independent of the GPU
+struct ModelData {
+    std::vector<MeshData> meshes;
+    std::vector<TextureData> textures;
+    Skeleton skeleton;
+    std::vector<KeyFrame> keyFrames;
+    std::vector<std::shared_ptr<const void>> storage; ///< owns the memory the spans above view
+
+    /// @brief Take ownership of data and view its contents
+    /// @param data
+    /// @return view valid for the lifetime of this ModelData
+    template <typename T>
+    std::span<const T> own(std::vector<T>&& data) {
+        auto owned = std::make_shared<const std::vector<T>>(std::move(data));
+        std::span<const T> view = *owned;
+        storage.emplace_back(std::move(owned));
+        return view;
+    }
+};
+
+} // namespace R3
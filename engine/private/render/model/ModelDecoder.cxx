@@ -0,0 +1,522 @@
+#include "render/model/ModelDecoder.hxx"
+
+#include <R3>
+#include <cstring>
+#include <numeric>
+#include "media/MappedFile.hxx"
+#include "media/glTF/glTF-AccessorView.hxx"
+#include "media/glTF/glTF-Extensions.hxx"
+#include "media/glTF/glTF-Model.hxx"
+#include "media/glTF/glTF-Util.hxx"
+#include "media/ktx2/Ktx2.hxx"
+#include "render/model/MeshOptimizer.hxx"
+#include "render/model/MeshSimplifier.hxx"
+#include "render/model/VertexDecode.hxx"
+
+namespace R3 {
+
+namespace local {
+
+// elements of a view as a tightly packed array
+// zero-copy when the accessor already is packed, otherwise gathered into scratch with sparse substitutions applied
+template <typename T>
+static const T* packed(const glTF::AccessorView<T>& view, std::vector<T>& scratch) {
+    if (view.data() != nullptr && view.contiguous() && !view.sparse()) {
+        return reinterpret_cast<const T*>(view.data());
+    }
+
+    scratch.resize(view.size());
+    view.copy(std::span(scratch));
+    return scratch.data();
+}
+
+} // namespace local
+
+ModelDecoder::ModelDecoder(const ModelDecoderSpecification& spec)
+    : m_threadPool(spec.threadPool),
+      m_optimize(spec.optimize),
+      m_weld(spec.weld),
+      m_weldEpsilon(spec.weldEpsilon),
+      m_lods(spec.lods),
+      m_lodReduction(spec.lodReduction) {
+    CHECK(m_lods < MAX_LODS);
+}
+
+ModelData ModelDecoder::decode(const std::filesystem::path& path) {
+    // embedded images are views into the model's mapped buffers, so the data keeps the model alive
+    auto gltf = std::make_shared<glTF::Model>(path, m_threadPool);
+
+    m_data = ModelData();
+    m_directory = path;
+    m_directory.replace_filename("");
+    m_missesBefore = 0.0f;
+    m_missesAfter = 0.0f;
+    m_triangles = 0;
+    m_verticesBefore = 0;
+    m_verticesAfter = 0;
+
+    preProcessTextures(*gltf);
+    for (auto& scene : gltf->scenes) {
+        for (uint32 iNode : scene.nodes) {
+            processNode(*gltf, gltf->nodes[iNode]);
+        }
+    }
+    processAnimations(*gltf);
+    processSkeleton(*gltf);
+
+    if (m_verticesBefore != m_verticesAfter) {
+        LOG(Info, path.filename(), "welded", m_verticesBefore, "->", m_verticesAfter, "vertices");
+    }
+    if (m_triangles != 0) {
+        LOG(Info,
+            path.filename(),
+            "ACMR",
+            m_missesBefore / float(m_triangles),
+            "->",
+            m_missesAfter / float(m_triangles),
+            "over",
+            m_triangles,
+            "triangles");
+    }
+
+    m_data.storage.emplace_back(std::move(gltf));
+
+    return std::move(m_data);
+}
+
+void ModelDecoder::processNode(glTF::Model& model, glTF::Node& node) {
+    for (auto child : node.children) {
+        processNode(model, model.nodes[child]);
+    }
+
+    if (node.mesh != undefined) {
+        processMesh(model, model.meshes[node.mesh]);
+    }
+}
+
+void ModelDecoder::processMesh(glTF::Model& model, glTF::Mesh& mesh) {
+    for (auto& primitive : mesh.primitives) {
+        CHECK(primitive.mode == glTF::TRIANGLES);
+
+        const decode::Kernels& kernels = decode::kernels();
+
+        //--- Vertices
+        CHECK(primitive.attributes.HasMember(glTF::POSITION));
+        const glTF::AccessorView<vec3> positions(model, primitive.attributes[glTF::POSITION].GetUint());
+
+        decode::VertexStreams streams = {.count = positions.size()};
+
+        std::vector<vec3> positionScratch;
+        streams.positions = local::packed(positions, positionScratch);
+
+        std::vector<vec3> normalScratch;
+        if (primitive.attributes.HasMember(glTF::NORMAL)) {
+            const glTF::AccessorView<vec3> normals(model, primitive.attributes[glTF::NORMAL].GetUint());
+            CHECK(normals.size() >= streams.count);
+            streams.normals = local::packed(normals, normalScratch);
+        }
+
+        std::vector<vec2> texCoordScratch;
+        if (primitive.attributes.HasMember(glTF::TEXCOORD_0)) {
+            const glTF::AccessorView<vec2> texCoords(model, primitive.attributes[glTF::TEXCOORD_0].GetUint());
+            CHECK(texCoords.size() >= streams.count);
+            streams.texCoords = local::packed(texCoords, texCoordScratch);
+        }
+
+        std::vector<ivec4> joints;
+        if (primitive.attributes.HasMember(glTF::JOINTS_0)) {
+            usize index = primitive.attributes[glTF::JOINTS_0].GetUint();
+
+            // joints are unsigned so widening to uint32 is bit identical to int32
+            auto readJoints = [&]<typename T>(void (*widen)(const T*, uint32*, usize)) {
+                const glTF::AccessorView<glm::vec<4, T>> view(model, index);
+                CHECK(view.size() >= streams.count);
+
+                std::vector<glm::vec<4, T>> scratch;
+                const glm::vec<4, T>* src = local::packed(view, scratch);
+
+                joints.resize(view.size());
+                widen(reinterpret_cast<const T*>(src), reinterpret_cast<uint32*>(joints.data()), view.size() * 4);
+                streams.joints = joints.data();
+            };
+
+            if (glTF::datatypeSize(model.accessors[index].componentType) == sizeof(uint8)) {
+                readJoints(kernels.widenU8);
+            } else if (glTF::datatypeSize(model.accessors[index].componentType) == sizeof(uint16)) {
+                readJoints(kernels.widenU16);
+            } else {
+                LOG(Error, "unsupported joint datatype", model.accessors[index].componentType);
+            }
+        }
+
+        std::vector<vec4> weights;
+        if (primitive.attributes.HasMember(glTF::WEIGHTS_0)) {
+            usize index = primitive.attributes[glTF::WEIGHTS_0].GetUint();
+
+            // integer weights are always normalized
+            auto readWeights = [&]<typename T>(void (*unorm)(const T*, float*, usize)) {
+                const glTF::AccessorView<glm::vec<4, T>> view(model, index);
+                CHECK(view.size() >= streams.count);
+
+                std::vector<glm::vec<4, T>> scratch;
+                const glm::vec<4, T>* src = local::packed(view, scratch);
+
+                weights.resize(view.size());
+                unorm(reinterpret_cast<const T*>(src), reinterpret_cast<float*>(weights.data()), view.size() * 4);
+                streams.weights = weights.data();
+            };
+
+            if (glTF::datatypeSize(model.accessors[index].componentType) == sizeof(uint8)) {
+                readWeights(kernels.unormU8);
+            } else if (glTF::datatypeSize(model.accessors[index].componentType) == sizeof(uint16)) {
+                readWeights(kernels.unormU16);
+            } else {
+                const glTF::AccessorView<vec4> view(model, index);
+                CHECK(view.size() >= streams.count);
+                streams.weights = local::packed(view, weights);
+            }
+        }
+
+        std::vector<Vertex> vertices(streams.count);
+        kernels.assemble(streams, vertices.data());
+
+        //--- Indices
+        std::vector<uint32> indices;
+        if (primitive.indices != undefined) {
+            glTF::Accessor& accessor = model.accessors[primitive.indices];
+            indices.resize(accessor.count);
+
+            auto readIndices = [&]<typename T>(void (*widen)(const T*, uint32*, usize)) {
+                const glTF::AccessorView<T> view(model, primitive.indices);
+                std::vector<T> scratch;
+                widen(local::packed(view, scratch), indices.data(), view.size());
+            };
+
+            switch (glTF::datatypeSize(accessor.componentType)) {
+                case sizeof(uint8):
+                    readIndices(kernels.widenU8);
+                    break;
+                case sizeof(uint16):
+                    readIndices(kernels.widenU16);
+                    break;
+                case sizeof(uint32):
+                    glTF::AccessorView<uint32>(model, primitive.indices).copy(std::span(indices));
+                    break;
+                default:
+                    LOG(Warning, "unknown datatype size");
+            }
+        } else {
+            LOG(Verbose, "mesh does not contain indices");
+        }
+
+        if (m_weld && !vertices.empty()) {
+            // welding needs an index buffer to rewrite, non indexed meshes get the trivial one
+            if (indices.empty()) {
+                indices.resize(vertices.size());
+                std::iota(indices.begin(), indices.end(), 0);
+            }
+
+            m_verticesBefore += vertices.size();
+            const usize removed = optimize::weld(vertices, indices, m_weldEpsilon);
+            m_verticesAfter += vertices.size();
+            LOG(Verbose, "mesh", m_data.meshes.size(), "welded", removed, "duplicate vertices");
+        }
+
+        if (m_optimize && !indices.empty()) {
+            const optimize::Stats stats = optimize::optimize(vertices, indices);
+            LOG(Verbose,
+                "mesh",
+                m_data.meshes.size(),
+                "ACMR",
+                stats.acmrBefore,
+                "->",
+                stats.acmrAfter,
+                "in",
+                stats.clusters,
+                "overdraw clusters");
+
+            const usize triangles = indices.size() / 3;
+            m_missesBefore += stats.acmrBefore * float(triangles);
+            m_missesAfter += stats.acmrAfter * float(triangles);
+            m_triangles += triangles;
+        }
+
+        std::vector<optimize::Lod> lods;
+        if (m_lods != 0 && !indices.empty()) {
+            lods = optimize::lodChain(vertices, indices, m_lods, m_lodReduction);
+            LOG(Verbose, "mesh", m_data.meshes.size(), "has", lods.size(), "LODs");
+        }
+
+        // indices are processed as uint32, stored at the narrowest width that addresses every vertex
+        const bool narrow = vertices.size() <= usize(UINT16_MAX) + 1;
+        auto store = [&](std::vector<uint32>&& src) -> IndexData {
+            if (narrow) {
+                return m_data.own(std::vector<uint16>(src.begin(), src.end()));
+            }
+            return m_data.own(std::move(src));
+        };
+
+        MeshData& meshData = m_data.meshes.emplace_back(MeshData{
+            .vertices = m_data.own(std::move(vertices)),
+            .indices = store(std::move(indices)),
+            .lods = {},
+            .textureIndices = {},
+        });
+        for (optimize::Lod& lod : lods) {
+            meshData.lods.push_back({store(std::move(lod.indices)), lod.error});
+        }
+
+        if (primitive.material != undefined) {
+            processMaterial(model, model.materials[primitive.material]);
+        }
+    }
+}
+
+void ModelDecoder::processAnimations(glTF::Model& model) {
+    // for every channel of every animation, get the sampler timestamps
+    // use those timestamps as key so that we can build up a mat4 that represents the TRS transform gotten from
+    // the individual Translation, Rotation, and Scale components of the glTF file
+    for (glTF::Animation& animation : model.animations) {
+        for (glTF::AnimationChannel& channel : animation.channels) {
+            KeyFrame::ModifierType modifierType = KeyFrame::stringToModifier(channel.target.path);
+
+            glTF::AnimationSampler& sampler = animation.samplers[channel.sampler];
+
+            // collect timestamps
+            const glTF::AccessorView<float> inputTimestamps(model, sampler.input);
+
+            // addKeyFrames by reading the sampler output as vec3 or quat
+            auto addKeyFrames = [&]<typename T>() {
+                const glTF::AccessorView<T> modifiers(model, sampler.output);
+
+                for (usize i = 0; float timestamp : inputTimestamps) {
+                    const T modifier = modifiers[i];
+
+                    if constexpr (std::is_same_v<T, vec3>) {
+                        m_data.keyFrames.emplace_back(
+                            KeyFrame{timestamp, channel.target.node, modifierType, vec4(modifier, 0.0f)}); // WIP
+                    } else {
+                        m_data.keyFrames.emplace_back(KeyFrame{timestamp,
+                                                              channel.target.node,
+                                                              modifierType,
+                                                              vec4(modifier.x, modifier.y, modifier.z, modifier.w)});
+                    }
+
+                    i++;
+                }
+            };
+
+            if (modifierType == KeyFrame::Translation) { // populate vec3 translate data
+                addKeyFrames.template operator()<vec3>();
+            } else if (modifierType == KeyFrame::Rotation) { // populate quat rotation data
+                addKeyFrames.template operator()<quat>();
+            } else if (modifierType == KeyFrame::Scale) { // populate vec3 scale data
+                addKeyFrames.template operator()<vec3>();
+            } else if (modifierType == KeyFrame::Weights) { // populate weights or something
+                LOG(Warning, "weights not yet supported");
+            }
+        } // for (channel : animation.channels)
+    } // for (animation : model.animations)
+}
+
+void ModelDecoder::processSkeleton(glTF::Model& model) {
+    usize numberOfSkeletons = model.skins.size();
+
+    if (numberOfSkeletons == 0) {
+        return;
+    }
+
+    if (numberOfSkeletons > 1) {
+        LOG(Warning, "more that one skeleton");
+    }
+
+    const auto& skin = model.skins[0];
+
+    if (skin.inverseBindMatrices != undefined) {
+        usize numberOfJoints = skin.joints.size();
+
+        m_data.skeleton.joints.resize(numberOfJoints);
+        m_data.skeleton.finalJointsMatrices.resize(numberOfJoints);
+
+        LOG(Verbose, "loading skeleton:", !skin.name.empty() ? skin.name : "UNNAMED");
+
+        const glTF::AccessorView<mat4> inverseBindMatrices(model, skin.inverseBindMatrices);
+
+        for (usize i = 0; i < numberOfJoints; i++) {
+            auto rootIndex = skin.joints[i];
+
+            m_data.skeleton.joints[i].rootIndex = rootIndex;
+            m_data.skeleton.joints[i].inverseBindMatrix = inverseBindMatrices[i];
+
+            auto& node = model.nodes[rootIndex];
+
+            m_data.skeleton.joints[i].deformedTranslation = glm::make_vec3(node.translation);
+            m_data.skeleton.joints[i].deformedRotation = glm::mat4(glm::make_quat(node.rotation));
+            m_data.skeleton.joints[i].deformedScale = glm::make_vec3(node.scale);
+            m_data.skeleton.joints[i].undeformedMatrix = glm::make_mat4(node.matrix);
+
+            m_data.skeleton.nodeToJointMap.emplace(rootIndex, i);
+        }
+
+        usize rootJoint = skin.joints[0];
+
+        processJoint(model, rootJoint, undefined);
+    }
+}
+
+void ModelDecoder::processJoint(glTF::Model& model, usize rootIndex, usize parentJoint) {
+    usize currentJoint = m_data.skeleton.nodeToJointMap[rootIndex];
+
+    auto& joint = m_data.skeleton.joints[currentJoint];
+
+    joint.parentJoint = parentJoint;
+
+    usize numberOfChildren = model.nodes[rootIndex].children.size();
+    if (numberOfChildren > 0) {
+        joint.children.resize(numberOfChildren);
+
+        for (usize i = 0; i < numberOfChildren; i++) {
+            usize childRootIndex = model.nodes[rootIndex].children[i];
+            joint.children[i] = m_data.skeleton.nodeToJointMap[childRootIndex];
+            processJoint(model, childRootIndex, currentJoint);
+        }
+    }
+}
+
+void ModelDecoder::processMaterial(glTF::Model& model, glTF::Material& material) {
+    int32 pbrSpecularGlossiness_INDEX = undefined;
+
+    for (int32 i = 0; auto& extension : material.extensions) {
+        if (std::strcmp(extension->name, glTF::EXTENSION_KHR_materials_pbrSpecularGlossiness) == 0) {
+            pbrSpecularGlossiness_INDEX = i;
+        }
+        i++;
+    }
+
+    if (material.emissiveTexture) {
+        processTexture(model, *material.emissiveTexture, TextureType::Emissive);
+    }
+
+    if (material.occlusionTexture) {
+        processTexture(model, *material.occlusionTexture, TextureType::AmbientOcclusion);
+    }
+
+    if (material.normalTexture) {
+        processTexture(model, *material.normalTexture, TextureType::Normal);
+    }
+
+    if (material.pbrMetallicRoughness.metallicRoughnessTexture) {
+        processTexture(model, *material.pbrMetallicRoughness.metallicRoughnessTexture, TextureType::MetallicRoughness);
+    }
+
+    if (material.pbrMetallicRoughness.baseColorTexture) {
+        processTexture(model, *material.pbrMetallicRoughness.baseColorTexture, TextureType::Albedo);
+    } else if (material.pbrMetallicRoughness.baseColorFactor[0] != 1.0f ||
+               material.pbrMetallicRoughness.baseColorFactor[1] != 1.0f ||
+               material.pbrMetallicRoughness.baseColorFactor[2] != 1.0f ||
+               material.pbrMetallicRoughness.baseColorFactor[3] != 1.0f) {
+        uint8 color[4] = {
+            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[0] * 255.0f),
+            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[1] * 255.0f),
+            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[2] * 255.0f),
+            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[3] * 255.0f),
+        };
+        processTexture(model, color, TextureType::Albedo);
+    } else if (pbrSpecularGlossiness_INDEX != undefined) {
+        auto* ext = (glTF::KHR_materials_pbrSpecularGlossiness*)material.extensions[pbrSpecularGlossiness_INDEX].get();
+        processTexture(model, *ext->diffuseTexture, TextureType::Albedo);
+    }
+}
+
+void ModelDecoder::processTexture(glTF::Model&, uint8 color[4], TextureType type) {
+    m_data.meshes.back().textureIndices.emplace_back(m_data.textures.size());
+
+    const std::byte* pixels = std::bit_cast<const std::byte*>(color);
+    m_data.textures.emplace_back(TextureData{
+        .path = {},
+        .encoded = {},
+        .pixels = m_data.own(std::vector<std::byte>(pixels, pixels + 4)),
+        .width = 1,
+        .height = 1,
+        .type = type,
+    });
+}
+
+void ModelDecoder::processTexture([[maybe_unused]] glTF::Model& model,
+                                  glTF::TextureInfo& textureInfo,
+                                  TextureType type) {
+    const TextureData& textureData = m_data.textures[textureInfo.index];
+
+    if (!textureData.path.empty() || !textureData.encoded.empty()) {
+        m_data.meshes.back().textureIndices.emplace_back(textureInfo.index);
+        m_data.textures[textureInfo.index].type = type;
+    }
+}
+
+void ModelDecoder::processTexture(glTF::Model& model, glTF::NormalTextureInfo& textureInfo, TextureType type) {
+    glTF::TextureInfo adapter{.index = textureInfo.index, .texCoord = {}, .extensions = {}};
+    processTexture(model, adapter, type);
+}
+
+void ModelDecoder::processTexture(glTF::Model& model, glTF::OcclusionTextureInfo& textureInfo, TextureType type) {
+    glTF::TextureInfo adapter{.index = textureInfo.index, .texCoord = {}, .extensions = {}};
+    processTexture(model, adapter, type);
+}
+
+void ModelDecoder::preProcessTextures(glTF::Model& model) {
+    m_data.textures.resize(model.textures.size());
+
+    for (usize i = 0; i < model.textures.size(); i++) {
+        const glTF::Texture& texture = model.textures[i];
+        uint32 source = texture.source;
+
+        // KHR_texture_basisu images are taken over source when their KTX2 payload uploads without transcoding
+        const rapidjson::Value* basisu =
+            texture.extensions ? glTF::findMember(*texture.extensions, glTF::EXTENSION_KHR_texture_basisu) : nullptr;
+        uint32 fallback = undefined;
+        if (basisu != nullptr) {
+            const uint32 ktx2Source = (*basisu)["source"].GetUint();
+            const glTF::Image& image = model.images[ktx2Source];
+
+            MappedFile file;
+            std::span<const std::byte> bytes;
+            if (!image.uri.empty()) {
+                file = MappedFile(m_directory / image.uri);
+                bytes = file.bytes();
+            } else {
+                bytes = model.bufferViewData(image.bufferView);
+            }
+
+            if (ktx2::isKtx2(bytes) && ktx2::read(bytes)) {
+                fallback = source; // the GPU may lack the compressed format, only the TexturePipeline can tell
+                source = ktx2Source;
+            } else if (source == undefined) {
+                LOG(Warning, "texture", i, "has no fallback for its", glTF::EXTENSION_KHR_texture_basisu, "image");
+            }
+        }
+
+        if (source == undefined) {
+            continue; // unused slot, never referenced by a material
+        }
+
+        const glTF::Image& image = model.images[source];
+        TextureData& textureData = m_data.textures[i];
+
+        if (!image.uri.empty()) {
+            textureData.path = m_directory / image.uri;
+        } else {
+            textureData.encoded = model.bufferViewData(image.bufferView);
+        }
+
+        if (fallback != undefined) {
+            const glTF::Image& fallbackImage = model.images[fallback];
+            if (!fallbackImage.uri.empty()) {
+                textureData.fallbackPath = m_directory / fallbackImage.uri;
+            } else {
+                textureData.fallbackEncoded = model.bufferViewData(fallbackImage.bufferView);
+            }
+        }
+    }
+}
+
+} // namespace R3
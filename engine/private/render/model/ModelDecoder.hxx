@@ -0,0 +1,84 @@
+#pragma once
+
+/// @file ModelDecoder.hxx
+/// @brief Decodes glTF models into CPU side ModelData
+
+#include <filesystem>
+#include "api/Api.hpp"
+#include "render/model/MeshOptimizer.hxx"
+#include "render/model/ModelData.hxx"
+
+namespace R3 {
+
+namespace glTF {
+struct Node;                 ///< @private
+struct Mesh;                 ///< @private
+struct Material;             ///< @private
+struct TextureInfo;          ///< @private
+struct NormalTextureInfo;    ///< @private
+struct OcclusionTextureInfo; ///< @private
+class Model;                 ///< @private
+} // namespace glTF
+
+class ThreadPool;
+
+/// @brief Model Decoder Specification
+struct ModelDecoderSpecification {
+    ThreadPool* threadPool = nullptr;           ///< helps decode compressed bufferViews, null decodes on the caller
+    bool optimize = true;                       ///< reorder triangles and vertices of every mesh, see MeshOptimizer.hxx
+    bool weld = true;                           ///< collapse duplicate vertices of every mesh, see MeshOptimizer.hxx
+    float weldEpsilon = optimize::WELD_EPSILON; ///< grid spacing attributes are compared on when welding
+    uint32 lods = 3;                            ///< coarser LODs generated per mesh, see MeshSimplifier.hxx
+    float lodReduction = 0.5f;                  ///< fraction of triangles every LOD keeps of the previous one
+};
+
+/// @brief ModelDecoder walks a glTF model and decodes it into ModelData
+/// Touches no GPU state, so decoding can run on any thread and without a Renderer
+class R3_API ModelDecoder {
+public:
+    ModelDecoder() = default;
+
+    /// @brief Construct ModelDecoder from spec
+    /// @param spec
+    explicit ModelDecoder(const ModelDecoderSpecification& spec);
+
+    /// @brief Decode the glTF model at path
+    /// @param path
+    /// @return decoded model, owns or keeps alive everything it views
+    [[nodiscard]] ModelData decode(const std::filesystem::path& path);
+
+private:
+    void processNode(glTF::Model& model, glTF::Node& node);
+    void processMesh(glTF::Model& model, glTF::Mesh& mesh);
+    void processAnimations(glTF::Model& model);
+    void processSkeleton(glTF::Model& model);
+    void processJoint(glTF::Model& model, usize rootIndex, usize parentJoint);
+    void processMaterial(glTF::Model& model, glTF::Material& material);
+    void processTexture(glTF::Model& model, uint8 color[4], TextureType type);
+    void processTexture(glTF::Model& model, glTF::TextureInfo& textureInfo, TextureType type);
+    void processTexture(glTF::Model& model, glTF::NormalTextureInfo& textureInfo, TextureType type);
+    void processTexture(glTF::Model& model, glTF::OcclusionTextureInfo& textureInfo, TextureType type);
+
+    void preProcessTextures(glTF::Model& model);
+
+private:
+    ThreadPool* m_threadPool = nullptr;
+    ModelData m_data;
+    std::filesystem::path m_directory;
+    bool m_optimize = true;
+    bool m_weld = true;
+    float m_weldEpsilon = optimize::WELD_EPSILON;
+    uint32 m_lods = 3;
+    float m_lodReduction = 0.5f;
+
+    // vertices before and after welding over every mesh, logged per model
+    usize m_verticesBefore = 0;
+    usize m_verticesAfter = 0;
+
+    // triangle weighted cache misses over every optimized mesh, logged per model
+    float m_missesBefore = 0.0f;
+    float m_missesAfter = 0.0f;
+    usize m_triangles = 0;
+};
+
+} // namespace R3
@@ -1,72 +1,56 @@
 #include "render/model/ModelLoader.hpp"
 
 #include <R3>
+#include <algorithm>
 #include <filesystem>
-#include <thread>
-#include "media/glTF/glTF-Extensions.hxx"
-#include "media/glTF/glTF-Model.hxx"
-#include "render/CommandPool.hpp"
-#include "render/DescriptorSet.hpp"
+#include "core/Entity.hpp"
+#include "core/Scene.hpp"
+#include "input/ModelEvent.hpp"
+#include "media/asset/Asset.hxx"
+#include "render/DescriptorAllocator.hpp"
+#include "render/PhysicalDevice.hpp"
+#include "render/PipelineCache.hpp"
 #include "render/ShaderObjects.hpp"
+#include "render/UploadContext.hpp"
+#include "render/model/ModelData.hxx"
+#include "render/model/ModelDecoder.hxx"
+#include "render/model/TexturePipeline.hxx"
+#include "render/model/VertexPack.hxx"
+#include "systems/AnimationSystem.hpp"
 
 namespace R3 {
 
 namespace local {
 
-static usize datatypeSize(uint32 datatype) {
-    switch (datatype) {
-        case glTF::UNSIGNED_BYTE:
-        case glTF::BYTE:
-            return sizeof(uint8);
-        case glTF::UNSIGNED_SHORT:
-        case glTF::SHORT:
-            return sizeof(uint16);
-        case glTF::UNSIGNED_INT:
-        case glTF::INT:
-            return sizeof(uint32);
-        case glTF::FLOAT:
-            return sizeof(float);
-        default:
-            ENSURE(false);
-    }
+// { binding, type, count, stage }
+static constexpr DescriptorSetLayoutBinding LAYOUT_BINDINGS[] = {
+    // Uniform Buffer Object
+    {0, DescriptorType::UniformBuffer, 1, ShaderStage::Vertex},
+    // Albedo
+    {1, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
+    // Metallic Roughness
+    {2, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
+    // Normal
+    {3, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
+    // Ambient Occlusion
+    {4, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
+    // Emissive
+    {5, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
+    // Lighting
+    {6, DescriptorType::UniformBuffer, 1, ShaderStage::Fragment},
+    // MousePicker
+    {7, DescriptorType::StorageBuffer, 1, ShaderStage::Fragment},
 };
 
-static usize componentElements(std::string_view component) {
-    if (component == "SCALAR") {
-        return 1;
-    } else if (component == "VEC2") {
-        return 2;
-    } else if (component == "VEC3") {
-        return 3;
-    } else if (component == "VEC4") {
-        return 4;
-    } else if (component == "MAT2") {
-        return 4;
-    } else if (component == "MAT3") {
-        return 9;
-    } else if (component == "MAT4") {
-        return 16;
-    } else {
-        ENSURE(false);
+// the glTF a baked asset was cooked from, empty if it was not shipped next to it
+static std::filesystem::path sourceOf(const std::filesystem::path& baked) {
+    for (const char* extension : {".gltf", ".glb"}) {
+        std::filesystem::path source = baked;
+        if (std::filesystem::exists(source.replace_extension(extension))) {
+            return source;
+        }
     }
-};
-
-template <typename T, typename N = T>
-static void readAccessor(glTF::Model& model, usize accessorIndex, std::vector<T>& data) {
-    CHECK(data.empty());
-
-    glTF::Accessor& accessor = model.accessors[accessorIndex];
-    glTF::BufferView& bufferView = model.bufferViews[accessor.bufferView];
-
-    CHECK(datatypeSize(accessor.componentType) * componentElements(accessor.type) == sizeof(N));
-
-    uint32 offset = accessor.byteOffset + bufferView.byteOffset;
-    data.resize(accessor.count);
-
-    // can take a vector of <typename T> and read the accessor as <typename N>
-    // eg accesor<uint16>[] --> std::vector<uint32>
-    usize i = 0;
-    std::ranges::generate(data, [&] { return *std::bit_cast<const N*>(&model.buffer()[offset + i++ * sizeof(N)]); });
+    return {};
 }
 
 } // namespace local
@@ -76,561 +60,401 @@ ModelLoader::ModelLoader(const ModelLoaderSpecification& spec)
       m_logicalDevice(&spec.logicalDevice),
       m_swapchain(&spec.swapchain),
       m_renderPass(&spec.renderPass),
-      m_commandPool(&spec.commandPool),
-      m_storageBuffer(&spec.storageBuffer) {
+      m_storageBuffer(&spec.storageBuffer),
+      m_stagingRing(&spec.stagingRing),
+      m_pipelineCache(&spec.pipelineCache),
+      m_descriptorAllocator(&spec.descriptorAllocator),
+      m_textureCache(&spec.textureCache),
+      m_threadPool(&spec.threadPool),
+      m_loaderPool(spec.loaderThreads) {
+    UploadContext uploadContext({
+        .logicalDevice = *m_logicalDevice,
+        .swapchain = *m_swapchain,
+        .stagingRing = *m_stagingRing,
+    });
+
     const uint32 data = 0x00FF'FFFF; // forfills glTF spec of white base color on missing pbrMetallicRoughness
     const TextureBufferSpecification nilTextureSpec = {
         .physicalDevice = *m_physicalDevice,
         .logicalDevice = *m_logicalDevice,
-        .commandBuffer = m_commandPool->commandBuffers().front(),
+        .uploadContext = uploadContext,
         .width = 1,
         .height = 1,
-        .data = nullptr,
         .raw = std::bit_cast<const std::byte*>(&data),
-        .path = nullptr,
         .type = TextureType::Nil,
     };
     m_nilTexture = std::make_shared<TextureBuffer>(nilTextureSpec);
+    uploadContext.flush();
+
+    m_texturePipeline = std::make_unique<TexturePipeline>(TexturePipelineSpecification{
+        .physicalDevice = *m_physicalDevice,
+        .logicalDevice = *m_logicalDevice,
+        .swapchain = *m_swapchain,
+        .stagingRing = *m_stagingRing,
+        .threadPool = spec.threadPool,
+        .textureCache = *m_textureCache,
+    });
+}
+
+ModelLoader::~ModelLoader() {
+    // queued loads are completed as failed, m_loaderPool joins the running ones
+    m_stopping.store(true, std::memory_order_relaxed);
 }
 
 void ModelLoader::load(const std::filesystem::path& path, ModelComponent& model) {
-    glTF::Model gltf(path);
+    instantiate(acquire(path), model);
+    model.status = ModelStatus::Ready;
+}
 
-    m_directory = path;
-    m_directory.replace_filename("");
+std::shared_ptr<ModelLoad> ModelLoader::loadAsync(const std::filesystem::path& path) {
+    auto load = std::make_shared<ModelLoad>();
+    load->path = path;
 
-    preProcessTextures(gltf);
-    for (auto& scene : gltf.scenes) {
-        for (uint32 iNode : scene.nodes) {
-            processNode(gltf, gltf.nodes[iNode]);
+    m_loaderPool.enqueue([this, load]() {
+        try {
+            if (m_stopping.load(std::memory_order_relaxed)) {
+                load->error = "loader destroyed before the load started";
+            } else {
+                load->resource = acquire(load->path);
+            }
+        } catch (const std::exception& e) {
+            load->error = e.what();
         }
-    }
-    processAnimations(gltf);
-    processSkeleton(gltf);
-
-    model.meshes.reserve(m_prototypes.size());
-    for (auto& prototype : m_prototypes) {
-        Mesh mesh;
-
-        mesh.vertexBuffer = std::move(prototype.vertexBuffer);
-        mesh.indexBuffer = std::move(prototype.indexBuffer);
-
-        // Descriptor Set Layout Bindings
-        static const std::vector<DescriptorSetLayoutBinding> layoutBindings = {
-            // { binding, type, count, stage }
-
-            // Uniform Buffer Object
-            {0, DescriptorType::UniformBuffer, 1, ShaderStage::Vertex},
-            // Albedo
-            {1, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
-            // Metallic Roughness
-            {2, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
-            // Normal
-            {3, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
-            // Ambient Occlusion
-            {4, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
-            // Emissive
-            {5, DescriptorType::CombinedImageSampler, 1, ShaderStage::Fragment},
-            // Lighting
-            {6, DescriptorType::UniformBuffer, 1, ShaderStage::Fragment},
-            // MousePicker
-            {7, DescriptorType::StorageBuffer, 1, ShaderStage::Fragment},
-        };
+        load->done.store(true, std::memory_order_release);
+    });
 
-        // Descriptor Pool
-        mesh.material.descriptorPool = DescriptorPool({
-            .logicalDevice = *m_logicalDevice,
-            .descriptorSetCount = MAX_FRAMES_IN_FLIGHT,
-            .layoutBindings = layoutBindings,
-        });
+    m_loads.push_back(load);
+    return load;
+}
 
-        // Pipeline
-        mesh.pipeline = GraphicsPipeline({
-            .physicalDevice = *m_physicalDevice,
-            .logicalDevice = *m_logicalDevice,
-            .swapchain = *m_swapchain,
-            .renderPass = *m_renderPass,
-            .descriptorSetLayout = mesh.material.descriptorPool.layout(),
-            .vertexBindingSpecification = Vertex::vertexBindingSpecification(),
-            .vertexAttributeSpecification = Vertex::vertexAttributeSpecification(),
-            .vertexShaderPath = "spirv/pbr.vert.spv",
-            .fragmentShaderPath = "spirv/pbr.frag.spv",
-            .msaa = true,
-        });
+void ModelLoader::update() {
+    if (m_loads.empty()) {
+        return;
+    }
 
-        // Uniform
-        for (auto i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            mesh.material.uniforms[i] = UniformBuffer({
-                .physicalDevice = *m_physicalDevice,
-                .logicalDevice = *m_logicalDevice,
-                .bufferSize = sizeof(VertexUniformBufferObject),
-            });
-            mesh.material.uniforms[i + 3] = UniformBuffer({
-                .physicalDevice = *m_physicalDevice,
-                .logicalDevice = *m_logicalDevice,
-                .bufferSize = sizeof(FragmentUniformBufferObject),
-            });
+    Entity::componentView<ModelComponent>().each([this](auto entity, ModelComponent& model) {
+        if (model.status != ModelStatus::Pending || !model.load || !model.load->done.load(std::memory_order_acquire)) {
+            return;
         }
 
-        // Textures
-        std::vector<TextureDescriptor> textureDescriptors;
-
-        for (usize index : prototype.textureIndices) {
-            TextureType type = m_textures[index]->type();
-            mesh.material.pbrFlags |= (1 << (uint32(type) - 1));
-
-            switch (type) {
-                case TextureType::Albedo:
-                    mesh.material.textures.albedo = m_textures[index];
-                    textureDescriptors.push_back({*mesh.material.textures.albedo, 1});
-                    break;
-                case TextureType::MetallicRoughness:
-                    mesh.material.textures.metallicRoughness = m_textures[index];
-                    textureDescriptors.push_back({*mesh.material.textures.metallicRoughness, 2});
-                    break;
-                case TextureType::Normal:
-                    mesh.material.textures.normal = m_textures[index];
-                    textureDescriptors.push_back({*mesh.material.textures.normal, 3});
-                    break;
-                case TextureType::AmbientOcclusion:
-                    mesh.material.textures.ambientOcclusion = m_textures[index];
-                    textureDescriptors.push_back({*mesh.material.textures.ambientOcclusion, 4});
-                    break;
-                case TextureType::Emissive:
-                    mesh.material.textures.emissive = m_textures[index];
-                    textureDescriptors.push_back({*mesh.material.textures.emissive, 5});
-                    break;
-                default:
-                    break;
+        const bool success = model.load->resource != nullptr;
+        if (success) {
+            instantiate(model.load->resource, model);
+            if (!model.animation.keyFrames.empty()) {
+                Scene::addSystem<AnimationSystem>();
             }
+        } else {
+            LOG(Error, "failed to load", model.load->path.string(), model.load->error);
         }
 
-        if (!(mesh.material.pbrFlags & TexturePBR::ALBEDO_FLAG)) {
-            mesh.material.textures.albedo = m_nilTexture;
-            textureDescriptors.push_back({*mesh.material.textures.albedo, 1});
-        }
-        if (!(mesh.material.pbrFlags & TexturePBR::METALLIC_ROUGHNESS_FLAG)) {
-            mesh.material.textures.metallicRoughness = m_nilTexture;
-            textureDescriptors.push_back({*mesh.material.textures.metallicRoughness, 2});
-        }
-        if (!(mesh.material.pbrFlags & TexturePBR::NORMAL_FLAG)) {
-            mesh.material.textures.normal = m_nilTexture;
-            textureDescriptors.push_back({*mesh.material.textures.normal, 3});
-        }
-        if (!(mesh.material.pbrFlags & TexturePBR::AMBIENT_OCCLUSION_FLAG)) {
-            mesh.material.textures.ambientOcclusion = m_nilTexture;
-            textureDescriptors.push_back({*mesh.material.textures.ambientOcclusion, 4});
-        }
-        if (!(mesh.material.pbrFlags & TexturePBR::EMISSIVE_FLAG)) {
-            mesh.material.textures.emissive = m_nilTexture;
-            textureDescriptors.push_back({*mesh.material.textures.emissive, 5});
-        }
+        model.status = success ? ModelStatus::Ready : ModelStatus::Failed;
+        model.load.reset();
+        Scene::pushEvent<ModelLoadedEvent>(uuid32(entity), success);
+    });
 
-        // Bindings
-        std::vector<UniformDescriptor> uniformDescriptors;
-        for (uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            uniformDescriptors.push_back({mesh.material.uniforms[i], 0});
-            uniformDescriptors.push_back({mesh.material.uniforms[i + 3], 6});
-        };
+    // a finished load is kept until its ModelComponent consumed it, or was destroyed before it could
+    std::erase_if(m_loads, [](const std::shared_ptr<ModelLoad>& load) {
+        return load->done.load(std::memory_order_acquire) && load.use_count() == 1;
+    });
+}
 
-        StorageDescriptor storageDescriptors[] = {{*m_storageBuffer, 7}};
+std::shared_ptr<const ModelResource> ModelLoader::acquire(const std::filesystem::path& path) {
+    std::error_code ec;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    const std::string key = (ec ? path.lexically_normal() : canonical).generic_string();
 
-        DescriptorPool& descriptorPool = mesh.material.descriptorPool;
-        std::vector<DescriptorSet>& descriptorSets = descriptorPool.descriptorSets();
+    std::shared_ptr<Slot> slot;
+    {
+        std::scoped_lock lock(m_mutex);
+        std::erase_if(m_resources, [](const auto& entry) {
+            return entry.second->resource.expired() && entry.second.use_count() == 1;
+        });
 
-        for (uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            descriptorSets[i].bindResources({uniformDescriptors, storageDescriptors, textureDescriptors});
+        std::shared_ptr<Slot>& entry = m_resources[key];
+        if (!entry) {
+            entry = std::make_shared<Slot>();
         }
-
-        model.meshes.emplace_back(std::move(mesh));
+        slot = entry;
     }
 
-    model.animation.keyFrames = std::move(m_keyFrames);
-    model.skeleton = std::move(m_skeleton);
-
-    // save for reuse
-    m_prototypes.clear();
-    m_keyFrames.clear();
-    m_textures.clear();
-    m_skeleton = Skeleton();
-}
-
-void ModelLoader::processNode(glTF::Model& model, glTF::Node& node) {
-    for (auto child : node.children) {
-        processNode(model, model.nodes[child]);
-    }
-
-    if (node.mesh != undefined) {
-        processMesh(model, model.meshes[node.mesh]);
+    // files already in use are neither read nor uploaded again
+    std::scoped_lock lock(slot->mutex);
+    if (std::shared_ptr<const ModelResource> resource = slot->resource.lock()) {
+        return resource;
     }
-}
-
-void ModelLoader::processMesh(glTF::Model& model, glTF::Mesh& mesh) {
-    for (auto& primitive : mesh.primitives) {
-        CHECK(primitive.mode == glTF::TRIANGLES);
 
-        //--- Vertices
-        std::vector<vec3> positions;
-        CHECK(primitive.attributes.HasMember(glTF::POSITION));
-        local::readAccessor(model, primitive.attributes[glTF::POSITION].GetUint(), positions);
+    const ModelDecoderSpecification decoderSpecification = {.threadPool = m_threadPool.get()};
+    ModelData data;
+    if (path.extension() == asset::EXTENSION) {
+        data = asset::read(path);
 
-        std::vector<vec3> normals;
-        if (primitive.attributes.HasMember(glTF::NORMAL)) {
-            local::readAccessor(model, primitive.attributes[glTF::NORMAL].GetUint(), normals);
-        }
-
-        std::vector<vec2> texCoords;
-        if (primitive.attributes.HasMember(glTF::TEXCOORD_0)) {
-            local::readAccessor(model, primitive.attributes[glTF::TEXCOORD_0].GetUint(), texCoords);
+        // baked textures keep the compressed format of their KTX2 image but not the glTF fallback image
+        const bool sampled = std::ranges::all_of(data.textures, [&](const TextureData& texture) {
+            return texture.pixels.empty() || m_physicalDevice->sampledFormat(texture.format);
+        });
+        const std::filesystem::path source = sampled ? std::filesystem::path() : local::sourceOf(path);
+        if (!source.empty()) {
+            LOG(Warning, path, "holds textures this GPU cannot sample, loading", source, "instead");
+            data = ModelDecoder(decoderSpecification).decode(source);
         }
+    } else {
+        data = ModelDecoder(decoderSpecification).decode(path);
+    }
+    std::shared_ptr<const ModelResource> resource = upload(data);
+    slot->resource = resource;
+    return resource;
+}
 
-        std::vector<ivec4> joints;
-        if (primitive.attributes.HasMember(glTF::JOINTS_0)) {
-            usize index = primitive.attributes[glTF::JOINTS_0].GetUint();
-            std::vector<glm::vec<4, uint16>> jointIndices;
+std::shared_ptr<ModelResource> ModelLoader::upload(ModelData& data) const {
+    std::vector<std::shared_ptr<TextureBuffer>> textures(data.textures.size());
+    std::vector<std::future<std::shared_ptr<TextureBuffer>>> pending(data.textures.size());
+    std::vector<uint64> keys(data.textures.size());
+    std::unordered_map<uint64, usize> submitted; // key to the first texture loading it
 
-            if (local::datatypeSize(model.accessors[index].componentType) == sizeof(uint8)) {
-                local::readAccessor<decltype(jointIndices)::value_type, glm::vec<4, uint8>>(model, index, jointIndices);
-            } else if (local::datatypeSize(model.accessors[index].componentType) == sizeof(uint16)) {
-                local::readAccessor(model, index, jointIndices);
-            } else {
-                LOG(Error, "unsupported joint datatype", model.accessors[index].componentType);
-            }
-
-            joints.resize(jointIndices.size());
-            std::ranges::copy(jointIndices, joints.begin());
+    for (usize i = 0; i < data.textures.size(); i++) {
+        const TextureData& texture = data.textures[i];
+        if (texture.path.empty() && texture.encoded.empty() && texture.pixels.empty()) {
+            continue;
         }
 
-        std::vector<vec4> weights;
-        if (primitive.attributes.HasMember(glTF::WEIGHTS_0)) {
-            usize index = primitive.attributes[glTF::WEIGHTS_0].GetUint();
-
-            if (local::datatypeSize(model.accessors[index].componentType) == sizeof(uint8)) {
-                local::readAccessor<vec4, glm::vec<4, uint8>>(model, index, weights);
-            } else if (local::datatypeSize(model.accessors[index].componentType) == sizeof(uint16)) {
-                local::readAccessor<vec4, glm::vec<4, uint16>>(model, index, weights);
-            } else {
-                local::readAccessor(model, index, weights);
-            }
+        // equal files and equal bytes share one upload, across models too
+        uint64& key = keys[i];
+        if (!texture.path.empty()) {
+            key = TextureCache::key(texture.path);
+        } else if (!texture.encoded.empty()) {
+            key = TextureCache::key(texture.encoded);
+        } else {
+            const uint64 layout[] = {texture.width, texture.height, uint64(texture.format), texture.mipLevels};
+            key = TextureCache::key(texture.pixels, TextureCache::key(std::as_bytes(std::span(layout))));
         }
 
-        std::vector<Vertex> vertices(positions.size());
-        for (usize i = 0; i < vertices.size(); i++) {
-            vertices[i].position = positions[i];
-            vertices[i].normal = i < normals.size() ? normals[i] : vec3(0);
-            vertices[i].textureCoords = i < texCoords.size() ? texCoords[i] : vec2(0);
-            vertices[i].boneIDs = i < joints.size() ? joints[i] : ivec4(-1);
-            vertices[i].weights = i < weights.size() ? weights[i] : vec4(0.0f);
+        // resident textures skip the pipeline, a texture used twice by this model is read and decoded once
+        if ((textures[i] = m_textureCache->find(key))) {
+            continue;
         }
-
-        //--- Indices
-        std::vector<uint32> indices;
-        if (primitive.indices != undefined) {
-            glTF::Accessor& accessor = model.accessors[primitive.indices];
-
-            switch (local::datatypeSize(accessor.componentType)) {
-                case sizeof(uint8):
-                    local::readAccessor<uint32, uint8>(model, primitive.indices, indices);
-                    break;
-                case sizeof(uint16):
-                    local::readAccessor<uint32, uint16>(model, primitive.indices, indices);
-                    break;
-                case sizeof(uint32):
-                    local::readAccessor(model, primitive.indices, indices);
-                    break;
-                default:
-                    LOG(Warning, "unknown datatype size");
-            }
-        } else {
-            LOG(Verbose, "mesh does not contain indices");
+        if (submitted.try_emplace(key, i).second) {
+            pending[i] = m_texturePipeline->submit(key, texture);
         }
+    }
 
-        m_prototypes.emplace_back(MeshPrototype{
-            .vertexBuffer = VertexBuffer({
-                .physicalDevice = *m_physicalDevice,
-                .logicalDevice = *m_logicalDevice,
-                .commandBuffer = m_commandPool->commandBuffers().front(),
-                .vertices = vertices,
-            }),
-            .indexBuffer = IndexBuffer<uint32>({
-                .physicalDevice = *m_physicalDevice,
-                .logicalDevice = *m_logicalDevice,
-                .commandBuffer = m_commandPool->commandBuffers().front(),
-                .indices = indices,
-            }),
-            .textureIndices = {},
-        });
-
-        if (primitive.material != undefined) {
-            processMaterial(model, model.materials[primitive.material]);
+    // every future is waited for before one can throw, the pipeline still reads data.textures until then
+    for (const auto& future : pending) {
+        if (future.valid()) {
+            future.wait();
         }
     }
-}
-
-void ModelLoader::processAnimations(glTF::Model& model) {
-    // for every channel of every animation, get the sampler timestamps
-    // use those timestamps as key so that we can build up a mat4 that represents the TRS transform gotten from
-    // the individual Translation, Rotation, and Scale components of the glTF file
-    for (glTF::Animation& animation : model.animations) {
-        for (glTF::AnimationChannel& channel : animation.channels) {
-            KeyFrame::ModifierType modifierType = KeyFrame::stringToModifier(channel.target.path);
-
-            glTF::AnimationSampler& sampler = animation.samplers[channel.sampler];
-
-            // collect timestamps
-            std::vector<float> inputTimestamps;
-            local::readAccessor(model, sampler.input, inputTimestamps);
-
-            // addKeyFrames by populating a vector of vec3 or quat
-            auto addKeyFrames = [&]<typename T>(std::vector<T>& modifiers) {
-                local::readAccessor(model, sampler.output, modifiers);
-
-                for (usize i = 0; float timestamp : inputTimestamps) {
-                    if constexpr (std::is_same_v<T, vec3>) {
-                        m_keyFrames.emplace_back(
-                            KeyFrame{timestamp, channel.target.node, modifierType, vec4(modifiers[i], 0.0f)}); // WIP
-                    } else {
-                        m_keyFrames.emplace_back(
-                            KeyFrame{timestamp,
-                                     channel.target.node,
-                                     modifierType,
-                                     vec4(modifiers[i].x, modifiers[i].y, modifiers[i].z, modifiers[i].w)});
-                    }
-
-                    i++;
-                }
-            };
-
-            if (modifierType == KeyFrame::Translation) { // populate vec3 translate data
-                std::vector<vec3> translations;
-                addKeyFrames(translations);
-            } else if (modifierType == KeyFrame::Rotation) { // populate quat rotation data
-                std::vector<quat> rotations;
-                addKeyFrames(rotations);
-            } else if (modifierType == KeyFrame::Scale) { // populate vec3 scale data
-                std::vector<vec3> scales;
-                addKeyFrames(scales);
-            } else if (modifierType == KeyFrame::Weights) { // populate weights or something
-                LOG(Warning, "weights not yet supported");
-            }
-        } // for (channel : animation.channels)
-    } // for (animation : model.animations)
-}
-
-void ModelLoader::processSkeleton(glTF::Model& model) {
-    usize numberOfSkeletons = model.skins.size();
-
-    if (numberOfSkeletons == 0) {
-        return;
+    for (const auto& [key, index] : submitted) {
+        textures[index] = pending[index].get();
     }
-
-    if (numberOfSkeletons > 1) {
-        LOG(Warning, "more that one skeleton");
+    for (usize i = 0; i < data.textures.size(); i++) {
+        if (!textures[i] && submitted.contains(keys[i])) {
+            textures[i] = textures[submitted[keys[i]]];
+        }
     }
 
-    const auto& skin = model.skins[0];
-
-    if (skin.inverseBindMatrices != undefined) {
-        usize numberOfJoints = skin.joints.size();
-
-        m_skeleton.joints.resize(numberOfJoints);
-        m_skeleton.finalJointsMatrices.resize(numberOfJoints);
-
-        LOG(Verbose, "loading skeleton:", !skin.name.empty() ? skin.name : "UNNAMED");
-
-        std::vector<mat4> inverseBindMatrices;
-        local::readAccessor(model, skin.inverseBindMatrices, inverseBindMatrices);
+    // geometry of every mesh is recorded by the loading thread and submitted to the transfer queue at once
+    UploadContext uploadContext({
+        .logicalDevice = *m_logicalDevice,
+        .swapchain = *m_swapchain,
+        .stagingRing = *m_stagingRing,
+    });
 
-        for (usize i = 0; i < numberOfJoints; i++) {
-            auto rootIndex = skin.joints[i];
+    auto resource = std::make_shared<ModelResource>();
 
-            m_skeleton.joints[i].rootIndex = rootIndex;
-            m_skeleton.joints[i].inverseBindMatrix = inverseBindMatrices[i];
+    usize vertexBytes = 0;
+    usize packedBytes = 0;
 
-            auto& node = model.nodes[rootIndex];
+    // pipelines of every mesh use the layout their instances allocate sets with
+    const DescriptorLayout& layout = m_descriptorAllocator->layout(local::LAYOUT_BINDINGS);
 
-            m_skeleton.joints[i].deformedTranslation = glm::make_vec3(node.translation);
-            m_skeleton.joints[i].deformedRotation = glm::mat4(glm::make_quat(node.rotation));
-            m_skeleton.joints[i].deformedScale = glm::make_vec3(node.scale);
-            m_skeleton.joints[i].undeformedMatrix = glm::make_mat4(node.matrix);
+    resource->meshes.reserve(data.meshes.size());
+    for (const MeshData& meshData : data.meshes) {
+        Mesh& mesh = resource->meshes.emplace_back();
 
-            m_skeleton.nodeToJointMap.emplace(rootIndex, i);
+        const pack::PackedVertices vertices = pack::pack(meshData.vertices, pack::choose(meshData.vertices));
+        mesh.vertexBuffer = VertexBuffer({
+            .physicalDevice = *m_physicalDevice,
+            .logicalDevice = *m_logicalDevice,
+            .uploadContext = uploadContext,
+            .vertices = vertices.bytes,
+            .stride = vertices.stride,
+        });
+        mesh.vertexLayout = vertices.layout;
+        mesh.dequantize = vertices.dequantize;
+        vertexBytes += meshData.vertices.size_bytes();
+        packedBytes += vertices.bytes.size();
+
+        // bounding sphere around the bounding box, enough for picking a LOD
+        if (!meshData.vertices.empty()) {
+            vec3 lo = meshData.vertices.front().position;
+            vec3 hi = lo;
+            for (const Vertex& vertex : meshData.vertices) {
+                lo = glm::min(lo, vertex.position);
+                hi = glm::max(hi, vertex.position);
+            }
+            mesh.bounds = vec4((lo + hi) * 0.5f, glm::length(hi - lo) * 0.5f);
         }
 
-        usize rootJoint = skin.joints[0];
-
-        processJoint(model, rootJoint, undefined);
-    }
-}
-
-void ModelLoader::processJoint(glTF::Model& model, usize rootIndex, usize parentJoint) {
-    usize currentJoint = m_skeleton.nodeToJointMap[rootIndex];
-
-    auto& joint = m_skeleton.joints[currentJoint];
-
-    joint.parentJoint = parentJoint;
-
-    usize numberOfChildren = model.nodes[rootIndex].children.size();
-    if (numberOfChildren > 0) {
-        joint.children.resize(numberOfChildren);
+        // index width was chosen per mesh when decoding or baking
+        auto createLod = [&](const IndexData& indices, float error) {
+            MeshLod& lod = mesh.lods.emplace_back();
+            lod.error = error;
+            std::visit(
+                [&]<std::integral T>(std::span<const T> view) {
+                    lod.indexBuffer = IndexBuffer<T>({
+                        .physicalDevice = *m_physicalDevice,
+                        .logicalDevice = *m_logicalDevice,
+                        .uploadContext = uploadContext,
+                        .indices = view,
+                    });
+                },
+                indices);
+        };
 
-        for (usize i = 0; i < numberOfChildren; i++) {
-            usize childRootIndex = model.nodes[rootIndex].children[i];
-            joint.children[i] = m_skeleton.nodeToJointMap[childRootIndex];
-            processJoint(model, childRootIndex, currentJoint);
+        createLod(meshData.indices, 0.0f);
+        for (const LodData& lod : meshData.lods) {
+            if (mesh.lods.size() < MAX_LODS) {
+                createLod(lod.indices, lod.error);
+            }
         }
-    }
-}
 
-void ModelLoader::processMaterial(glTF::Model& model, glTF::Material& material) {
-    int32 pbrSpecularGlossiness_INDEX = undefined;
+        // Pipeline, pbr.vert is compiled once per VertexLayout and the pipeline shared by every mesh using it
+        auto createPipeline = [&]<typename T>(std::string_view vertexShaderPath) {
+            mesh.pipeline = m_pipelineCache->acquire({
+                .physicalDevice = *m_physicalDevice,
+                .logicalDevice = *m_logicalDevice,
+                .swapchain = *m_swapchain,
+                .renderPass = *m_renderPass,
+                .descriptorSetLayout = layout.descriptorSetLayout,
+                .pipelineLayout = layout.pipelineLayout,
+                .vertexBindingSpecification = T::vertexBindingSpecification(),
+                .vertexAttributeSpecification = T::vertexAttributeSpecification(),
+                .vertexShaderPath = vertexShaderPath,
+                .fragmentShaderPath = "spirv/pbr.frag.spv",
+                .msaa = true,
+            });
+        };
 
-    for (int32 i = 0; auto& extension : material.extensions) {
-        if (std::strcmp(extension->name, glTF::EXTENSION_KHR_materials_pbrSpecularGlossiness) == 0) {
-            pbrSpecularGlossiness_INDEX = i;
+        switch (mesh.vertexLayout) {
+            case VertexLayout::Full:
+                createPipeline.template operator()<Vertex>("spirv/pbr.vert.spv");
+                break;
+            case VertexLayout::PackedStatic:
+                createPipeline.template operator()<PackedStaticVertex>("spirv/pbr.vert.packed_static.spv");
+                break;
+            case VertexLayout::PackedSkinned:
+                createPipeline.template operator()<PackedSkinnedVertex>("spirv/pbr.vert.packed_skinned.spv");
+                break;
         }
-        i++;
-    }
 
-    if (material.emissiveTexture) {
-        processTexture(model, *material.emissiveTexture, TextureType::Emissive);
-    }
-
-    if (material.occlusionTexture) {
-        processTexture(model, *material.occlusionTexture, TextureType::AmbientOcclusion);
-    }
+        // Textures
+        TexturePBR& slots = mesh.material.textures;
+        for (usize index : meshData.textureIndices) {
+            if (!textures[index]) {
+                continue;
+            }
 
-    if (material.normalTexture) {
-        processTexture(model, *material.normalTexture, TextureType::Normal);
-    }
+            const TextureType type = data.textures[index].type; // a cached texture may serve another type elsewhere
+            mesh.material.pbrFlags |= (1 << (uint32(type) - 1));
 
-    if (material.pbrMetallicRoughness.metallicRoughnessTexture) {
-        processTexture(model, *material.pbrMetallicRoughness.metallicRoughnessTexture, TextureType::MetallicRoughness);
-    }
+            switch (type) {
+                case TextureType::Albedo:
+                    slots.albedo = textures[index];
+                    break;
+                case TextureType::MetallicRoughness:
+                    slots.metallicRoughness = textures[index];
+                    break;
+                case TextureType::Normal:
+                    slots.normal = textures[index];
+                    break;
+                case TextureType::AmbientOcclusion:
+                    slots.ambientOcclusion = textures[index];
+                    break;
+                case TextureType::Emissive:
+                    slots.emissive = textures[index];
+                    break;
+                default:
+                    break;
+            }
+        }
 
-    if (material.pbrMetallicRoughness.baseColorTexture) {
-        processTexture(model, *material.pbrMetallicRoughness.baseColorTexture, TextureType::Albedo);
-    } else if (material.pbrMetallicRoughness.baseColorFactor[0] != 1.0f ||
-               material.pbrMetallicRoughness.baseColorFactor[1] != 1.0f ||
-               material.pbrMetallicRoughness.baseColorFactor[2] != 1.0f ||
-               material.pbrMetallicRoughness.baseColorFactor[3] != 1.0f) {
-        uint8 color[4] = {
-            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[0] * 255.0f),
-            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[1] * 255.0f),
-            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[2] * 255.0f),
-            static_cast<uint8>(material.pbrMetallicRoughness.baseColorFactor[3] * 255.0f),
-        };
-        processTexture(model, color, TextureType::Albedo);
-    } else if (pbrSpecularGlossiness_INDEX != undefined) {
-        auto* ext = (glTF::KHR_materials_pbrSpecularGlossiness*)material.extensions[pbrSpecularGlossiness_INDEX].get();
-        processTexture(model, *ext->diffuseTexture, TextureType::Albedo);
+        for (std::shared_ptr<TextureBuffer>* slot :
+             {&slots.albedo, &slots.metallicRoughness, &slots.normal, &slots.ambientOcclusion, &slots.emissive}) {
+            if (!*slot) {
+                *slot = m_nilTexture;
+            }
+        }
     }
-}
 
-void ModelLoader::processTexture(glTF::Model&, uint8 color[4], TextureType type) {
-    m_prototypes.back().textureIndices.emplace_back(static_cast<uint32>(m_textures.size()));
+    // the resource is handed out once every buffer it references was copied
+    uploadContext.flush();
 
-    TextureBufferSpecification textureBufferSpecification = {
-        .physicalDevice = *m_physicalDevice,
-        .logicalDevice = *m_logicalDevice,
-        .commandBuffer = m_commandPool->commandBuffers().front(),
-        .width = 1,
-        .height = 1,
-        .data = nullptr,
-        .raw = std::bit_cast<const std::byte*>(color),
-        .path = nullptr,
-        .type = type,
-    };
+    LOG(Verbose, "packed", vertexBytes, "->", packedBytes, "vertex bytes over", data.meshes.size(), "meshes");
 
-    m_textures.emplace_back(std::make_shared<TextureBuffer>(textureBufferSpecification));
-}
-
-void ModelLoader::processTexture(glTF::Model& model, glTF::TextureInfo& textureInfo, TextureType type) {
-    glTF::Texture& texture = model.textures[textureInfo.index];
-
-    if (texture.source != undefined) {
-        m_prototypes.back().textureIndices.emplace_back(textureInfo.index);
-        m_textures[textureInfo.index]->setType(type);
+    resource->skeleton = std::move(data.skeleton);
+    resource->keyFrames = std::move(data.keyFrames);
+    for (const KeyFrame& keyFrame : resource->keyFrames) {
+        resource->duration = std::max(keyFrame.timestamp, resource->duration);
     }
-}
 
-void ModelLoader::processTexture(glTF::Model& model, glTF::NormalTextureInfo& textureInfo, TextureType type) {
-    glTF::TextureInfo adapter{.index = textureInfo.index, .texCoord = {}, .extensions = {}};
-    processTexture(model, adapter, type);
+    return resource;
 }
 
-void ModelLoader::processTexture(glTF::Model& model, glTF::OcclusionTextureInfo& textureInfo, TextureType type) {
-    glTF::TextureInfo adapter{.index = textureInfo.index, .texCoord = {}, .extensions = {}};
-    processTexture(model, adapter, type);
-}
+void ModelLoader::instantiate(std::shared_ptr<const ModelResource> resource, ModelComponent& model) const {
+    model.meshes.clear();
+    model.meshes.reserve(resource->meshes.size());
 
-void ModelLoader::preProcessTextures(glTF::Model& model) {
-    m_textures.resize(model.textures.size());
-    std::vector<std::thread> pool;
+    // instances of every model allocate their sets with the one shared layout
+    const DescriptorLayout& layout = m_descriptorAllocator->layout(local::LAYOUT_BINDINGS);
 
-    for (uint32 i = 0; const glTF::Texture& texture : model.textures) {
-        if (texture.source == uint32(undefined)) {
-            m_textures.emplace_back(nullptr);
-            continue;
-        }
+    for (const Mesh& mesh : resource->meshes) {
+        MeshInstance& instance = model.meshes.emplace_back();
 
-        glTF::Image& image = model.images[texture.source];
-        std::filesystem::path path = m_directory;
-        path.replace_filename(image.uri);
+        instance.descriptorSets = m_descriptorAllocator->allocate(layout, MAX_FRAMES_IN_FLIGHT);
 
-        pool.emplace_back([&, i, path]() {
-            CommandPool commandPool = CommandPoolSpecification{
+        // Uniform
+        for (auto i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            instance.uniforms[i] = UniformBuffer({
+                .physicalDevice = *m_physicalDevice,
                 .logicalDevice = *m_logicalDevice,
-                .swapchain = *m_swapchain,
-                .type = CommandPoolType::Transient | CommandPoolType::Reset,
-                .commandBufferCount = 1,
-            };
-
-            std::vector<CommandBuffer> commandBuffers = CommandBuffer::allocate({
+                .bufferSize = sizeof(VertexUniformBufferObject),
+            });
+            instance.uniforms[i + 3] = UniformBuffer({
+                .physicalDevice = *m_physicalDevice,
                 .logicalDevice = *m_logicalDevice,
-                .swapchain = *m_swapchain,
-                .commandPool = commandPool,
-                .commandBufferCount = 1,
+                .bufferSize = sizeof(FragmentUniformBufferObject),
             });
+        }
 
-            if (!image.uri.empty()) {
-                TextureBufferSpecification textureBufferSpecification = {
-                    .physicalDevice = *m_physicalDevice,
-                    .logicalDevice = *m_logicalDevice,
-                    .commandBuffer = commandBuffers.front(),
-                    .width = undefined,
-                    .height = undefined,
-                    .data = nullptr,
-                    .raw = nullptr,
-                    .path = path.c_str(),
-                    .type = TextureType::Nil, // set later
-                };
-                m_textures[i] = std::make_shared<TextureBuffer>(textureBufferSpecification);
-            } else {
-                glTF::BufferView& bufferView = model.bufferViews[image.bufferView];
-                const std::byte* data = std::bit_cast<const std::byte*>(&model.buffer()[bufferView.byteOffset]);
-
-                TextureBufferSpecification textureBufferSpecification = {
-                    .physicalDevice = *m_physicalDevice,
-                    .logicalDevice = *m_logicalDevice,
-                    .commandBuffer = commandBuffers.front(),
-                    .width = bufferView.byteLength,
-                    .height = 0,
-                    .data = data,
-                    .raw = nullptr,
-                    .path = nullptr,
-                    .type = TextureType::Nil, // set later
-                };
-                m_textures[i] = std::make_shared<TextureBuffer>(textureBufferSpecification);
-            }
-        });
+        // Bindings
+        const TexturePBR& textures = mesh.material.textures;
+        const TextureDescriptor textureDescriptors[] = {
+            {*textures.albedo, 1},
+            {*textures.metallicRoughness, 2},
+            {*textures.normal, 3},
+            {*textures.ambientOcclusion, 4},
+            {*textures.emissive, 5},
+        };
 
-        i++;
-    }
+        std::vector<UniformDescriptor> uniformDescriptors;
+        for (uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            uniformDescriptors.push_back({instance.uniforms[i], 0});
+            uniformDescriptors.push_back({instance.uniforms[i + 3], 6});
+        };
 
-    for (auto& thread : pool) {
-        thread.join();
+        StorageDescriptor storageDescriptors[] = {{*m_storageBuffer, 7}};
+
+        std::vector<DescriptorSet>& descriptorSets = instance.descriptorSets.descriptorSets();
+        for (uint32 i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            descriptorSets[i].bindResources({uniformDescriptors, storageDescriptors, textureDescriptors});
+        }
     }
+
+    // running may have been set while the model was pending
+    model.skeleton = resource->skeleton;
+    model.animation.maxTime = resource->duration;
+    model.animation.keyFrames = resource->keyFrames;
+    model.resource = std::move(resource);
 }
 
 } // namespace R3
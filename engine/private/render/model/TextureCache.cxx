@@ -0,0 +1,116 @@
+#include "render/model/TextureCache.hpp"
+
+#include <bit>
+#include <cstring>
+#include "api/Hash.hpp"
+
+namespace R3 {
+
+namespace local {
+
+// FNV-1a over 8 byte words with a final avalanche, fast enough to key textures on every load
+static uint64 hash(uint64 seed, const std::byte* data, usize size) {
+    uint64 h = seed ^ (size * FNV_PRIME);
+
+    usize i = 0;
+    for (; i + sizeof(uint64) <= size; i += sizeof(uint64)) {
+        uint64 word = 0;
+        std::memcpy(&word, data + i, sizeof(word));
+        h = fnv1aMix(h, word);
+        h ^= h >> 29;
+    }
+    for (; i < size; i++) {
+        h = fnv1aMix(h, std::to_integer<uint64>(data[i]));
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51'afd7'ed55'8ccd;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace local
+
+uint64 TextureCache::key(const std::filesystem::path& path) {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    if (ec) {
+        canonical = path.lexically_normal();
+    }
+
+    const std::string name = canonical.generic_string();
+    // paths and contents are hashed from different seeds so they never share a key by construction
+    return local::hash(~FNV_OFFSET, std::bit_cast<const std::byte*>(name.data()), name.size());
+}
+
+uint64 TextureCache::key(std::span<const std::byte> bytes, uint64 seed) {
+    return local::hash(FNV_OFFSET ^ seed, bytes.data(), bytes.size());
+}
+
+std::shared_ptr<TextureBuffer> TextureCache::acquire(uint64 key, const std::function<TextureBuffer()>& create) {
+    std::shared_ptr<Slot> slot;
+    {
+        std::scoped_lock lock(m_mutex);
+        std::shared_ptr<Slot>& entry = m_slots[key];
+        if (!entry) {
+            entry = std::make_shared<Slot>();
+        }
+        slot = entry;
+    }
+
+    std::scoped_lock lock(slot->mutex);
+    if (std::shared_ptr<TextureBuffer> texture = slot->texture.lock()) {
+        std::scoped_lock counters(m_mutex);
+        m_hits++;
+        return texture;
+    }
+
+    // uploaded without holding m_mutex, acquires of other keys proceed meanwhile
+    auto texture = std::make_shared<TextureBuffer>(create());
+
+    std::scoped_lock counters(m_mutex);
+    slot->texture = texture;
+    slot->size = texture->size();
+    m_misses++;
+    return texture;
+}
+
+std::shared_ptr<TextureBuffer> TextureCache::find(uint64 key) {
+    std::scoped_lock lock(m_mutex);
+
+    // slot fields are also written under m_mutex, an upload in progress is simply not resident yet
+    const auto it = m_slots.find(key);
+    std::shared_ptr<TextureBuffer> texture = it != m_slots.end() ? it->second->texture.lock() : nullptr;
+    if (texture) {
+        m_hits++;
+    }
+    return texture;
+}
+
+TextureCacheStats TextureCache::stats() {
+    std::scoped_lock lock(m_mutex);
+
+    TextureCacheStats stats = {
+        .hits = m_hits,
+        .misses = m_misses,
+        .residentCount = 0,
+        .residentBytes = 0,
+    };
+
+    for (auto it = m_slots.begin(); it != m_slots.end();) {
+        // a slot still shared is being acquired, keep it even though its texture may not exist yet
+        if (it->second->texture.expired() && it->second.use_count() == 1) {
+            it = m_slots.erase(it);
+            continue;
+        }
+        if (!it->second->texture.expired()) {
+            stats.residentCount++;
+            stats.residentBytes += it->second->size;
+        }
+        ++it;
+    }
+
+    return stats;
+}
+
+} // namespace R3
@@ -0,0 +1,241 @@
+#include "render/model/TexturePipeline.hxx"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <algorithm>
+#include "api/Ensure.hpp"
+#include "api/Log.hpp"
+#include "media/ktx2/Ktx2.hxx"
+#include "media/mip/MipChain.hxx"
+#include "render/PhysicalDevice.hpp"
+
+namespace R3 {
+
+TexturePipeline::TexturePipeline(const TexturePipelineSpecification& spec)
+    : m_physicalDevice(&spec.physicalDevice),
+      m_logicalDevice(&spec.logicalDevice),
+      m_threadPool(&spec.threadPool),
+      m_textureCache(&spec.textureCache),
+      m_slots(std::ptrdiff_t(spec.capacity)),
+      m_readQueue(spec.capacity),
+      m_decodeQueue(spec.capacity),
+      m_uploadQueue(spec.capacity),
+      m_uploadContext({
+          .logicalDevice = spec.logicalDevice,
+          .swapchain = spec.swapchain,
+          .stagingRing = spec.stagingRing,
+      }) {
+    m_uploader = std::thread([this]() { upload(); });
+}
+
+TexturePipeline::~TexturePipeline() {
+    {
+        std::unique_lock lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_scheduled == 0; });
+    }
+
+    m_readQueue.close();
+    m_decodeQueue.close();
+    m_uploadQueue.close();
+    m_uploader.join();
+}
+
+std::future<std::shared_ptr<TextureBuffer>> TexturePipeline::submit(uint64 key, const TextureData& texture) {
+    m_slots.acquire();
+
+    Job job;
+    job.key = key;
+    job.texture = &texture;
+    std::future<std::shared_ptr<TextureBuffer>> future = job.promise.get_future();
+
+    m_readQueue.push(std::move(job));
+    schedule(&TexturePipeline::read);
+    return future;
+}
+
+void TexturePipeline::schedule(void (TexturePipeline::*stage)()) {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_scheduled++;
+    }
+
+    // every task pops the oldest job of its stage, so jobs leave a stage in the order they entered it
+    m_threadPool->enqueue([this, stage]() {
+        (this->*stage)();
+
+        std::scoped_lock lock(m_mutex);
+        if (--m_scheduled == 0) {
+            m_idle.notify_all();
+        }
+    });
+}
+
+void TexturePipeline::read() {
+    std::optional<Job> job = m_readQueue.pop();
+    if (!job) {
+        return;
+    }
+
+    try {
+        const TextureData& texture = *job->texture;
+        if (!texture.path.empty()) {
+            job->file = MappedFile(texture.path);
+            job->encoded = job->file.bytes();
+        } else {
+            job->encoded = texture.encoded;
+        }
+    } catch (...) {
+        fail(*job);
+        return;
+    }
+
+    m_decodeQueue.push(std::move(*job));
+    schedule(&TexturePipeline::decode);
+}
+
+void TexturePipeline::decode() {
+    std::optional<Job> job = m_decodeQueue.pop();
+    if (!job) {
+        return;
+    }
+
+    try {
+        const TextureData& texture = *job->texture;
+
+        // a KTX2 format the GPU cannot sample is replaced by the glTF fallback image, decoded like any other image
+        if (ktx2::isKtx2(job->encoded) && (!texture.fallbackPath.empty() || !texture.fallbackEncoded.empty())) {
+            const std::optional<ktx2::Texture> stored = ktx2::read(job->encoded);
+            if (stored && !m_physicalDevice->sampledFormat(stored->format)) {
+                LOG(Info, "texture", texture.path, "cannot be sampled on this GPU, decoding its fallback image");
+                if (!texture.fallbackPath.empty()) {
+                    job->file = MappedFile(texture.fallbackPath);
+                    job->encoded = job->file.bytes();
+                } else {
+                    job->encoded = texture.fallbackEncoded;
+                }
+            }
+        }
+
+        if (!texture.pixels.empty()) {
+            // baked levels are uploaded straight from the asset
+            job->levels = texture.pixels;
+            job->width = texture.width;
+            job->height = texture.height;
+            job->format = texture.format;
+            job->mipLevels = texture.mipLevels;
+        } else if (ktx2::isKtx2(job->encoded)) {
+            std::optional<ktx2::Texture> stored = ktx2::read(job->encoded);
+            if (!stored) {
+                LOG(Error, "unsupported KTX2 texture", texture.path);
+                ENSURE(false);
+            }
+            for (const std::span<const std::byte> level : stored->levels) {
+                job->decoded.insert(job->decoded.end(), level.begin(), level.end());
+            }
+            job->levels = job->decoded;
+            job->width = stored->width;
+            job->height = stored->height;
+            job->format = stored->format;
+            job->mipLevels = uint32(stored->levels.size());
+        } else {
+            int32 w = 0;
+            int32 h = 0;
+            int32 channels = 0;
+            stbi_uc* pixels = stbi_load_from_memory(std::bit_cast<const stbi_uc*>(job->encoded.data()),
+                                                    int32(job->encoded.size()),
+                                                    &w,
+                                                    &h,
+                                                    &channels,
+                                                    STBI_rgb_alpha);
+            if (pixels == nullptr) {
+                LOG(Error, "failed to decode texture", texture.path, stbi_failure_reason());
+                ENSURE(false);
+            }
+
+            const std::byte* bytes = std::bit_cast<const std::byte*>(pixels);
+            job->decoded.assign(bytes, bytes + usize(w) * usize(h) * 4); // missing channels are filled
+            stbi_image_free(pixels);
+
+            // the chain is filtered here so the upload thread only copies, instead of blitting on the GPU
+            job->width = uint32(w);
+            job->height = uint32(h);
+            job->format = Format::R8G8B8A8Srgb;
+            job->mipLevels = mip::generate(job->decoded, job->width, job->height, true);
+            job->levels = job->decoded;
+        }
+    } catch (...) {
+        fail(*job);
+        return;
+    }
+
+    job->file = MappedFile();
+    job->encoded = {};
+    m_uploadQueue.push(std::move(*job));
+}
+
+void TexturePipeline::upload() {
+    std::vector<Job> batch;
+    std::vector<std::optional<TextureBuffer>> textures;
+    std::vector<std::exception_ptr> errors;
+
+    while (std::optional<Job> job = m_uploadQueue.pop()) {
+        // every texture decoded meanwhile shares the submission
+        batch.push_back(std::move(*job));
+        while (std::optional<Job> next = m_uploadQueue.tryPop()) {
+            batch.push_back(std::move(*next));
+        }
+
+        textures.resize(batch.size());
+        errors.resize(batch.size());
+        for (usize i = 0; i < batch.size(); i++) {
+            try {
+                const TextureBufferSpecification spec = {
+                    .physicalDevice = *m_physicalDevice,
+                    .logicalDevice = *m_logicalDevice,
+                    .uploadContext = m_uploadContext,
+                    .width = batch[i].width,
+                    .height = batch[i].height,
+                    .raw = batch[i].levels.data(),
+                    .type = batch[i].texture->type,
+                    .format = batch[i].format,
+                    .mipLevels = batch[i].mipLevels,
+                };
+                textures[i].emplace(spec);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+
+        try {
+            m_uploadContext.flush();
+        } catch (...) {
+            std::ranges::fill(errors, std::current_exception());
+        }
+
+        // published only once copied, so a texture taken from the cache is always complete
+        for (usize i = 0; i < batch.size(); i++) {
+            try {
+                if (errors[i]) {
+                    std::rethrow_exception(errors[i]);
+                }
+                // another model may have uploaded the same texture while this one was decoded
+                batch[i].promise.set_value(
+                    m_textureCache->acquire(batch[i].key, [&]() { return std::move(*textures[i]); }));
+            } catch (...) {
+                batch[i].promise.set_exception(std::current_exception());
+            }
+        }
+
+        m_slots.release(std::ptrdiff_t(batch.size()));
+        batch.clear();
+        textures.clear();
+        errors.clear();
+    }
+}
+
+void TexturePipeline::fail(Job& job) {
+    job.promise.set_exception(std::current_exception());
+    m_slots.release();
+}
+
+} // namespace R3
@@ -0,0 +1,96 @@
+#pragma once
+
+/// @file TexturePipeline.hxx
+/// @brief Streams model textures through three stages linked by bounded queues
+/// Files are read and images decoded on the engine ThreadPool, the decoded levels are uploaded by a single thread
+/// which records every texture waiting for it into one transfer submission
+
+#include <future>
+#include <memory>
+#include <semaphore>
+#include <thread>
+#include "core/BoundedQueue.hxx"
+#include "core/ThreadPool.hpp"
+#include "media/MappedFile.hxx"
+#include "render/UploadContext.hpp"
+#include "render/model/ModelData.hxx"
+#include "render/model/TextureCache.hpp"
+
+namespace R3 {
+
+/// @brief Texture Pipeline Specification
+struct TexturePipelineSpecification {
+    const PhysicalDevice& physicalDevice;
+    const LogicalDevice& logicalDevice;
+    const Swapchain& swapchain;
+    StagingRing& stagingRing;
+    ThreadPool& threadPool;     ///< runs the read and decode stages
+    TextureCache& textureCache; ///< uploads are deduplicated against every resident texture
+    usize capacity = 16;        ///< textures between submit and upload, bounds the decoded bytes held in memory
+};
+
+/// @brief Texture loading pipeline, owned by the ModelLoader
+class TexturePipeline {
+public:
+    NO_COPY(TexturePipeline);
+    NO_MOVE(TexturePipeline);
+
+    /// @brief Construct TexturePipeline from spec and start the upload thread
+    /// @param spec
+    TexturePipeline(const TexturePipelineSpecification& spec);
+
+    /// @brief Stop the upload thread, every submitted texture must have completed
+    ~TexturePipeline();
+
+    /// @brief Queue a texture for loading, thread safe
+    /// Blocks while capacity textures are in flight, so it must not be called from a ThreadPool task
+    /// @param key TextureCache key of texture
+    /// @param texture image source, must outlive the returned future
+    /// @return texture once uploaded, or the exception that stopped it
+    [[nodiscard]] std::future<std::shared_ptr<TextureBuffer>> submit(uint64 key, const TextureData& texture);
+
+private:
+    struct Job {
+        uint64 key = 0;
+        const TextureData* texture = nullptr;
+        MappedFile file;                    // read stage, released once decoded
+        std::span<const std::byte> encoded; // read stage, file or embedded bytes
+        std::vector<std::byte> decoded;     // decode stage, owns levels unless the source was already decoded
+        std::span<const std::byte> levels;  // decode stage, every level back to back, largest first
+        uint32 width = 0;
+        uint32 height = 0;
+        uint32 mipLevels = 1;
+        Format format = Format::R8G8B8A8Srgb;
+        std::promise<std::shared_ptr<TextureBuffer>> promise;
+    };
+
+    void schedule(void (TexturePipeline::*stage)());
+
+    void read();
+
+    void decode();
+
+    void upload();
+
+    void fail(Job& job);
+
+private:
+    Ref<const PhysicalDevice> m_physicalDevice;
+    Ref<const LogicalDevice> m_logicalDevice;
+    Ref<ThreadPool> m_threadPool;
+    Ref<TextureCache> m_textureCache;
+
+    std::counting_semaphore<> m_slots; // released once a texture leaves the pipeline, the queues never fill up
+    BoundedQueue<Job> m_readQueue;
+    BoundedQueue<Job> m_decodeQueue;
+    BoundedQueue<Job> m_uploadQueue;
+
+    std::mutex m_mutex;
+    std::condition_variable m_idle;
+    usize m_scheduled = 0; // stage tasks queued on the ThreadPool, they reference this
+
+    UploadContext m_uploadContext; // upload thread only
+    std::thread m_uploader;
+};
+
+} // namespace R3
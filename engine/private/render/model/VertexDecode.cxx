@@ -0,0 +1,329 @@
+#include "render/model/VertexDecode.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define R3_DECODE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define R3_TARGET_AVX2
+#else
+#define R3_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace R3::decode {
+
+// the SSE assembly kernel writes a Vertex as 5 x 16 byte stores and one 8 byte store
+static_assert(offsetof(Vertex, position) == 0);
+static_assert(offsetof(Vertex, normal) == 12);
+static_assert(offsetof(Vertex, tangent) == 24);
+static_assert(offsetof(Vertex, bitangent) == 36);
+static_assert(offsetof(Vertex, textureCoords) == 48);
+static_assert(offsetof(Vertex, boneIDs) == 56);
+static_assert(offsetof(Vertex, weights) == 72);
+static_assert(sizeof(Vertex) == 88);
+
+//--- Scalar
+
+static void widenU8Scalar(const uint8* src, uint32* dst, usize count) {
+    std::copy_n(src, count, dst);
+}
+
+static void widenU16Scalar(const uint16* src, uint32* dst, usize count) {
+    std::copy_n(src, count, dst);
+}
+
+static void unormU8Scalar(const uint8* src, float* dst, usize count) {
+    std::transform(src, src + count, dst, [](uint8 x) { return float(x) * (1.0f / 255.0f); });
+}
+
+static void unormU16Scalar(const uint16* src, float* dst, usize count) {
+    std::transform(src, src + count, dst, [](uint16 x) { return float(x) * (1.0f / 65535.0f); });
+}
+
+static void assembleScalar(const VertexStreams& streams, Vertex* dst) {
+    for (usize i = 0; i < streams.count; i++) {
+        Vertex& vertex = dst[i];
+        vertex.position = streams.positions[i];
+        vertex.normal = streams.normals ? streams.normals[i] : vec3(0);
+        vertex.tangent = vec3(0);
+        vertex.bitangent = vec3(0);
+        vertex.textureCoords = streams.texCoords ? streams.texCoords[i] : vec2(0);
+        vertex.boneIDs = streams.joints ? streams.joints[i] : ivec4(-1);
+        vertex.weights = streams.weights ? streams.weights[i] : vec4(0.0f);
+    }
+}
+
+#if R3_DECODE_X86
+
+//--- SSE2
+
+static void widenU8SSE2(const uint8* src, uint32* dst, usize count) {
+    const __m128i zero = _mm_setzero_si128();
+
+    usize i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+        _mm_storeu_si128((__m128i*)(dst + i + 0), _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+
+    widenU8Scalar(src + i, dst + i, count - i);
+}
+
+static void widenU16SSE2(const uint16* src, uint32* dst, usize count) {
+    const __m128i zero = _mm_setzero_si128();
+
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i + 0), _mm_unpacklo_epi16(v, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(v, zero));
+    }
+
+    widenU16Scalar(src + i, dst + i, count - i);
+}
+
+static void unormU8SSE2(const uint8* src, float* dst, usize count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+    auto store = [&](float* out, __m128i x) { _mm_storeu_ps(out, _mm_mul_ps(_mm_cvtepi32_ps(x), scale)); };
+
+    usize i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+        store(dst + i + 0, _mm_unpacklo_epi16(lo, zero));
+        store(dst + i + 4, _mm_unpackhi_epi16(lo, zero));
+        store(dst + i + 8, _mm_unpacklo_epi16(hi, zero));
+        store(dst + i + 12, _mm_unpackhi_epi16(hi, zero));
+    }
+
+    unormU8Scalar(src + i, dst + i, count - i);
+}
+
+static void unormU16SSE2(const uint16* src, float* dst, usize count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(1.0f / 65535.0f);
+
+    usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_ps(dst + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), scale));
+    }
+
+    unormU16Scalar(src + i, dst + i, count - i);
+}
+
+static void assembleSSE2(const VertexStreams& streams, Vertex* dst) {
+    if (streams.count == 0) {
+        return;
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 noJoints = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    // vec3 streams are read with a 16 byte load, which reads one float into the next element
+    // so the last vertex is always assembled by the scalar kernel
+    const usize count = streams.count - 1;
+
+    for (usize i = 0; i < count; i++) {
+        const __m128 p = _mm_loadu_ps(&streams.positions[i].x);
+        const __m128 n = streams.normals ? _mm_loadu_ps(&streams.normals[i].x) : zero;
+        const __m128 uv =
+            streams.texCoords ? _mm_castpd_ps(_mm_load_sd((const double*)&streams.texCoords[i].x)) : zero;
+        const __m128 j = streams.joints ? _mm_loadu_ps((const float*)&streams.joints[i].x) : noJoints;
+        const __m128 w = streams.weights ? _mm_loadu_ps(&streams.weights[i].x) : zero;
+
+        // [p.x p.y p.z n.x] [n.y n.z 0 0] [0 0 0 0] [uv.x uv.y j.x j.y] [j.z j.w w.x w.y] [w.z w.w]
+        const __m128 pzNx = _mm_shuffle_ps(p, n, _MM_SHUFFLE(0, 0, 2, 2));
+        const __m128 lane0 = _mm_shuffle_ps(p, pzNx, _MM_SHUFFLE(2, 0, 1, 0));
+        const __m128 lane1 = _mm_shuffle_ps(n, zero, _MM_SHUFFLE(0, 0, 2, 1));
+        const __m128 lane3 = _mm_movelh_ps(uv, j);
+        const __m128 lane4 = _mm_shuffle_ps(j, w, _MM_SHUFFLE(1, 0, 3, 2));
+        const __m128 lane5 = _mm_movehl_ps(w, w);
+
+        float* out = (float*)&dst[i];
+        _mm_storeu_ps(out + 0, lane0);
+        _mm_storeu_ps(out + 4, lane1);
+        _mm_storeu_ps(out + 8, zero);
+        _mm_storeu_ps(out + 12, lane3);
+        _mm_storeu_ps(out + 16, lane4);
+        _mm_storel_pi((__m64*)(out + 20), lane5);
+    }
+
+    VertexStreams tail = streams;
+    tail.positions += count;
+    tail.normals = streams.normals ? streams.normals + count : nullptr;
+    tail.texCoords = streams.texCoords ? streams.texCoords + count : nullptr;
+    tail.joints = streams.joints ? streams.joints + count : nullptr;
+    tail.weights = streams.weights ? streams.weights + count : nullptr;
+    tail.count = 1;
+    assembleScalar(tail, dst + count);
+}
+
+//--- AVX2
+
+R3_TARGET_AVX2 static void widenU8AVX2(const uint8* src, uint32* dst, usize count) {
+    usize i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i + 0), _mm256_cvtepu8_epi32(v));
+        _mm256_storeu_si256((__m256i*)(dst + i + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+    }
+
+    widenU8Scalar(src + i, dst + i, count - i);
+}
+
+R3_TARGET_AVX2 static void widenU16AVX2(const uint16* src, uint32* dst, usize count) {
+    usize i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i + 0), _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)));
+        _mm256_storeu_si256((__m256i*)(dst + i + 8), _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)));
+    }
+
+    widenU16Scalar(src + i, dst + i, count - i);
+}
+
+R3_TARGET_AVX2 static void unormU8AVX2(const uint8* src, float* dst, usize count) {
+    const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+    usize i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        const __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v));
+        const __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+        _mm256_storeu_ps(dst + i + 0, _mm256_mul_ps(lo, scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(hi, scale));
+    }
+
+    unormU8Scalar(src + i, dst + i, count - i);
+}
+
+R3_TARGET_AVX2 static void unormU16AVX2(const uint16* src, float* dst, usize count) {
+    const __m256 scale = _mm256_set1_ps(1.0f / 65535.0f);
+
+    usize i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        const __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)));
+        const __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)));
+        _mm256_storeu_ps(dst + i + 0, _mm256_mul_ps(lo, scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(hi, scale));
+    }
+
+    unormU16Scalar(src + i, dst + i, count - i);
+}
+
+static bool supportsAVX2() {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // AVX2 needs the OS to save ymm state, OSXSAVE + AVX and XCR0 bits 1 and 2
+    __cpuid(info, 1);
+    const bool osxsave = info[2] & (1 << 27);
+    const bool avx = info[2] & (1 << 28);
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static bool supportsSSE2() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true; // baseline of x86-64
+#elif defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 1);
+    return info[3] & (1 << 26);
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif // R3_DECODE_X86
+
+static constexpr Kernels SCALAR_KERNELS = {
+    .isa = Isa::Scalar,
+    .name = "Scalar",
+    .widenU8 = widenU8Scalar,
+    .widenU16 = widenU16Scalar,
+    .unormU8 = unormU8Scalar,
+    .unormU16 = unormU16Scalar,
+    .assemble = assembleScalar,
+};
+
+#if R3_DECODE_X86
+static constexpr Kernels SSE2_KERNELS = {
+    .isa = Isa::SSE2,
+    .name = "SSE2",
+    .widenU8 = widenU8SSE2,
+    .widenU16 = widenU16SSE2,
+    .unormU8 = unormU8SSE2,
+    .unormU16 = unormU16SSE2,
+    .assemble = assembleSSE2,
+};
+
+// AoS assembly is shuffle bound, 256 bit lanes do not help so it shares the SSE2 kernel
+static constexpr Kernels AVX2_KERNELS = {
+    .isa = Isa::AVX2,
+    .name = "AVX2",
+    .widenU8 = widenU8AVX2,
+    .widenU16 = widenU16AVX2,
+    .unormU8 = unormU8AVX2,
+    .unormU16 = unormU16AVX2,
+    .assemble = assembleSSE2,
+};
+#endif // R3_DECODE_X86
+
+const Kernels& kernels(Isa isa) {
+#if R3_DECODE_X86
+    if (isa == Isa::AVX2 && supportsAVX2()) {
+        return AVX2_KERNELS;
+    }
+    if (isa == Isa::SSE2 && supportsSSE2()) {
+        return SSE2_KERNELS;
+    }
+#else
+    (void)isa;
+#endif // R3_DECODE_X86
+    return SCALAR_KERNELS;
+}
+
+const Kernels& kernels() {
+    static const Kernels& selected = []() -> const Kernels& {
+#if R3_DECODE_X86
+        if (supportsAVX2()) {
+            return AVX2_KERNELS;
+        }
+        if (supportsSSE2()) {
+            return SSE2_KERNELS;
+        }
+#endif // R3_DECODE_X86
+        return SCALAR_KERNELS;
+    }();
+    return selected;
+}
+
+} // namespace R3::decode
@@ -0,0 +1,54 @@
+#pragma once
+
+/// @file VertexDecode.hxx
+/// @brief SIMD kernels used to decode glTF accessor streams into engine vertex/index data
+/// Kernels are selected once at runtime from what the CPU supports, AVX2 > SSE2 > Scalar
+
+#include "api/Types.hpp"
+#include "render/RenderSpecification.hpp"
+#include "render/ShaderObjects.hpp"
+
+namespace R3::decode {
+
+/// @brief Instruction set a kernel table is implemented with
+enum class Isa {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+/// @brief Tightly packed vertex attribute streams to assemble into Vertex
+/// positions is required, every other stream may be nullptr and is then filled with its default
+struct VertexStreams {
+    const vec3* positions = nullptr; ///< required
+    const vec3* normals = nullptr;   ///< default vec3(0)
+    const vec2* texCoords = nullptr; ///< default vec2(0)
+    const ivec4* joints = nullptr;   ///< default ivec4(-1)
+    const vec4* weights = nullptr;   ///< default vec4(0)
+    usize count = 0;                 ///< number of vertices in every stream
+};
+
+/// @brief Table of decode kernels for a single instruction set
+/// All sources and destinations are tightly packed and need no particular alignment
+struct R3_API Kernels {
+    Isa isa;         ///< instruction set the kernels are implemented with
+    const char* name; ///< printable instruction set name
+
+    void (*widenU8)(const uint8* src, uint32* dst, usize count);   ///< zero extend uint8 -> uint32
+    void (*widenU16)(const uint16* src, uint32* dst, usize count); ///< zero extend uint16 -> uint32
+    void (*unormU8)(const uint8* src, float* dst, usize count);    ///< normalized uint8 -> float [0, 1]
+    void (*unormU16)(const uint16* src, float* dst, usize count);  ///< normalized uint16 -> float [0, 1]
+    void (*assemble)(const VertexStreams& streams, Vertex* dst);   ///< interleave streams into AoS Vertex
+};
+
+/// @brief Query the fastest kernels supported by the running CPU
+/// @return kernel table, selected on first call
+R3_API const Kernels& kernels();
+
+/// @brief Query the kernels of a specific instruction set, used for benchmarking and validation
+/// @note falls back to Scalar if isa is not supported by the running CPU
+/// @param isa
+/// @return kernel table
+R3_API const Kernels& kernels(Isa isa);
+
+} // namespace R3::decode
@@ -0,0 +1,158 @@
+#include "render/model/VertexPack.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/gtc/matrix_transform.hpp>
+#include "api/Check.hpp"
+
+namespace R3::pack {
+
+namespace local {
+
+// joint index of unused influences, >= MAX_BONES so pbr.vert skips skinning like it does for -1
+static constexpr uint8 NO_JOINT = 255;
+
+static bool skinned(const Vertex& vertex) {
+    return vertex.boneIDs[0] >= 0;
+}
+
+template <typename T>
+static void serialize(std::span<const Vertex> vertices, PackedVertices& packed, auto&& convert) {
+    packed.stride = sizeof(T);
+    packed.bytes.resize(vertices.size() * sizeof(T));
+
+    for (usize i = 0; i < vertices.size(); i++) {
+        const T vertex = convert(vertices[i]);
+        std::memcpy(packed.bytes.data() + i * sizeof(T), &vertex, sizeof(T));
+    }
+}
+
+} // namespace local
+
+VertexLayout choose(std::span<const Vertex> vertices) {
+    if (!std::any_of(vertices.begin(), vertices.end(), local::skinned)) {
+        return VertexLayout::PackedStatic;
+    }
+
+    const bool narrow = std::all_of(vertices.begin(), vertices.end(), [](const Vertex& vertex) {
+        for (usize i = 0; i < 4; i++) {
+            if (vertex.boneIDs[i] >= local::NO_JOINT) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    return narrow ? VertexLayout::PackedSkinned : VertexLayout::Full;
+}
+
+PackedVertices pack(std::span<const Vertex> vertices, VertexLayout layout) {
+    PackedVertices packed;
+    packed.layout = layout;
+
+    switch (layout) {
+        case VertexLayout::Full: {
+            const std::span<const std::byte> bytes = std::as_bytes(vertices);
+            packed.bytes.assign(bytes.begin(), bytes.end());
+            packed.stride = sizeof(Vertex);
+            break;
+        }
+        case VertexLayout::PackedStatic: {
+            // uniform scale over the bounding cube so the dequantized model matrix keeps normals correct
+            vec3 lo = vec3(0.0f);
+            vec3 hi = vec3(0.0f);
+            if (!vertices.empty()) {
+                lo = hi = vertices.front().position;
+            }
+            for (const Vertex& vertex : vertices) {
+                for (int32 k = 0; k < 3; k++) {
+                    lo[k] = std::min(lo[k], vertex.position[k]);
+                    hi[k] = std::max(hi[k], vertex.position[k]);
+                }
+            }
+
+            float extent = std::max({hi.x - lo.x, hi.y - lo.y, hi.z - lo.z});
+            if (extent <= 0.0f) {
+                extent = 1.0f;
+            }
+            packed.dequantize = glm::scale(glm::translate(mat4(1.0f), lo), vec3(extent));
+
+            local::serialize<PackedStaticVertex>(vertices, packed, [&](const Vertex& vertex) {
+                PackedStaticVertex result = {};
+                for (int32 k = 0; k < 3; k++) {
+                    const float unorm = std::clamp((vertex.position[k] - lo[k]) / extent, 0.0f, 1.0f);
+                    result.position[k] = uint16(std::lround(unorm * float(UINT16_MAX)));
+                }
+                result.normal = octahedral(vertex.normal);
+                result.textureCoords = glm::packHalf2x16(vertex.textureCoords);
+                return result;
+            });
+            break;
+        }
+        case VertexLayout::PackedSkinned: {
+            local::serialize<PackedSkinnedVertex>(vertices, packed, [&](const Vertex& vertex) {
+                PackedSkinnedVertex result = {};
+                result.position = vertex.position;
+                result.normal = octahedral(vertex.normal);
+                result.textureCoords = glm::packHalf2x16(vertex.textureCoords);
+                for (usize k = 0; k < 4; k++) {
+                    const int32 joint = vertex.boneIDs[k];
+                    CHECK(joint < local::NO_JOINT);
+                    result.boneIDs[k] = joint < 0 ? local::NO_JOINT : uint8(joint);
+                }
+                weights(vertex.weights, result.weights);
+                return result;
+            });
+            break;
+        }
+    }
+
+    return packed;
+}
+
+uint32 octahedral(vec3 direction) {
+    const float l1 = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (l1 == 0.0f) {
+        return glm::packSnorm2x16(vec2(0.0f));
+    }
+
+    // project onto the octahedron, fold the lower hemisphere over the diagonals
+    vec2 p = vec2(direction.x / l1, direction.y / l1);
+    if (direction.z < 0.0f) {
+        const vec2 folded = vec2(1.0f - std::abs(p.y), 1.0f - std::abs(p.x));
+        p = vec2(p.x >= 0.0f ? folded.x : -folded.x, p.y >= 0.0f ? folded.y : -folded.y);
+    }
+
+    return glm::packSnorm2x16(p);
+}
+
+void weights(vec4 weights, uint8 dst[4]) {
+    float sum = 0.0f;
+    for (int32 k = 0; k < 4; k++) {
+        weights[k] = std::max(weights[k], 0.0f);
+        sum += weights[k];
+    }
+    if (sum <= 0.0f) {
+        std::fill_n(dst, 4, uint8(0));
+        return;
+    }
+
+    // round down, then hand the remaining units to the largest remainders
+    float remainders[4];
+    int32 total = 0;
+    for (int32 k = 0; k < 4; k++) {
+        const float scaled = std::min(weights[k] / sum * 255.0f, 255.0f);
+        dst[k] = uint8(std::floor(scaled));
+        remainders[k] = scaled - float(dst[k]);
+        total += dst[k];
+    }
+
+    for (; total < 255; total++) {
+        const int32 k = int32(std::max_element(remainders, remainders + 4) - remainders);
+        dst[k]++;
+        remainders[k] = -1.0f;
+    }
+}
+
+} // namespace R3::pack
@@ -0,0 +1,44 @@
+#pragma once
+
+/// @file VertexPack.hxx
+/// @brief Packs decoded Vertex data into the compact layouts of ShaderObjects.hpp before upload
+/// pbr.vert has a decode variant for every VertexLayout, see ModelLoader
+
+#include <span>
+#include <vector>
+#include "api/Types.hpp"
+#include "render/RenderSpecification.hpp"
+#include "render/ShaderObjects.hpp"
+
+namespace R3::pack {
+
+/// @brief Vertices of a mesh serialized in a single layout
+struct PackedVertices {
+    VertexLayout layout = VertexLayout::Full; ///< layout of bytes
+    std::vector<std::byte> bytes;             ///< serialized vertices
+    uint32 stride = sizeof(Vertex);           ///< size of a single vertex
+    mat4 dequantize = mat4(1.0f);             ///< maps packed positions to model space
+};
+
+/// @brief Choose the smallest layout that represents vertices without visible loss
+/// @param vertices
+/// @return PackedSkinned if any vertex is skinned, Full if joint indices do not fit 8 bits, else PackedStatic
+VertexLayout choose(std::span<const Vertex> vertices);
+
+/// @brief Pack vertices into layout
+/// @param vertices
+/// @param layout
+/// @return packed vertices
+PackedVertices pack(std::span<const Vertex> vertices, VertexLayout layout);
+
+/// @brief Octahedral encode a direction into snorm16x2
+/// @param direction need not be normalized, the zero vector encodes +Z
+/// @return packed snorm16x2
+uint32 octahedral(vec3 direction);
+
+/// @brief Quantize joint weights to unorm8 that sum to exactly 255
+/// @param weights
+/// @param[out] dst
+void weights(vec4 weights, uint8 dst[4]);
+
+} // namespace R3::pack
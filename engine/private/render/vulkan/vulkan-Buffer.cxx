@@ -3,17 +3,18 @@
 #include "render/Buffer.hpp"
 
 #include <vulkan/vulkan.hpp>
-#include "render/CommandPool.hpp"
 #include "render/LogicalDevice.hpp"
 #include "render/PhysicalDevice.hpp"
 
 namespace R3 {
 
-std::tuple<NativeRenderObject, NativeRenderObject> Buffer::allocate(const BufferAllocateSpecification& spec) {
+std::tuple<NativeRenderObject, MemoryAllocation> Buffer::allocate(const BufferAllocateSpecification& spec) {
+    // uploads are written by the transfer family and read by the graphics family, without ownership transfers
     const uint32 indices[] = {
         spec.logicalDevice.graphicsQueue().index(),
-        spec.logicalDevice.presentationQueue().index(),
+        spec.logicalDevice.transferQueue().index(),
     };
+    const bool concurrent = (spec.bufferFlags & BufferUsage::TransferDst) && indices[0] != indices[1];
 
     const vk::BufferCreateInfo bufferCreateInfo = {
         .sType = vk::StructureType::eBufferCreateInfo,
@@ -21,7 +22,7 @@ std::tuple<NativeRenderObject, NativeRenderObject> Buffer::allocate(const Buffer
         .flags = {},
         .size = spec.size,
         .usage = vk::BufferUsageFlags(spec.bufferFlags),
-        .sharingMode = vk::SharingMode::eExclusive,
+        .sharingMode = concurrent ? vk::SharingMode::eConcurrent : vk::SharingMode::eExclusive,
         .queueFamilyIndexCount = 2,
         .pQueueFamilyIndices = indices,
     };
@@ -29,34 +30,17 @@ std::tuple<NativeRenderObject, NativeRenderObject> Buffer::allocate(const Buffer
 
     const auto memoryRequirements = spec.logicalDevice.as<vk::Device>().getBufferMemoryRequirements(buffer);
 
-    const vk::MemoryAllocateInfo memoryAllocateInfo = {
-        .sType = vk::StructureType::eMemoryAllocateInfo,
-        .pNext = nullptr,
-        .allocationSize = memoryRequirements.size,
-        .memoryTypeIndex = spec.physicalDevice.queryMemoryType(memoryRequirements.memoryTypeBits, spec.memoryFlags),
-    };
-    const auto memory = spec.logicalDevice.as<vk::Device>().allocateMemory(memoryAllocateInfo);
+    const MemoryAllocation memory = spec.logicalDevice.memoryAllocator().allocate({
+        .size = memoryRequirements.size,
+        .alignment = memoryRequirements.alignment,
+        .memoryType = spec.physicalDevice.queryMemoryType(memoryRequirements.memoryTypeBits, spec.memoryFlags),
+        .image = false,
+    });
 
-    spec.logicalDevice.as<vk::Device>().bindBufferMemory(buffer, memory, 0);
-
-    return {static_cast<VkBuffer>(buffer), static_cast<VkDeviceMemory>(memory)};
-}
-
-void Buffer::copy(const BufferCopySpecification& spec) {
-    spec.commandBuffer.beginCommandBuffer(CommandBufferUsage::OneTimeSubmit);
-    spec.commandBuffer.as<vk::CommandBuffer>().copyBuffer(
-        spec.stagingBuffer.as<vk::Buffer>(), spec.buffer.as<vk::Buffer>(), {{.size = spec.size}});
-    spec.commandBuffer.endCommandBuffer();
-
-    const vk::CommandBuffer buffers[] = {spec.commandBuffer.as<vk::CommandBuffer>()};
-    const vk::SubmitInfo submitInfo = {
-        .sType = vk::StructureType::eSubmitInfo,
-        .commandBufferCount = 1,
-        .pCommandBuffers = buffers,
-    };
+    spec.logicalDevice.as<vk::Device>().bindBufferMemory(
+        buffer, static_cast<VkDeviceMemory>(memory.memory), memory.offset);
 
-    spec.logicalDevice.graphicsQueue().as<vk::Queue>().submit(submitInfo);
-    spec.logicalDevice.graphicsQueue().as<vk::Queue>().waitIdle();
+    return {static_cast<VkBuffer>(buffer), memory};
 }
 
 } // namespace R3
@@ -30,7 +30,7 @@ ColorBuffer::ColorBuffer(const ColorBufferSpecification& spec)
     auto&& [image, memory] = Image::allocate(imageAllocateSpecification);
 
     setHandle(image.handle());
-    setDeviceMemory(memory.handle());
+    setDeviceMemory(memory);
 
     m_imageView = ImageView({
         .logicalDevice = *m_logicalDevice,
@@ -44,7 +44,7 @@ ColorBuffer::ColorBuffer(const ColorBufferSpecification& spec)
 ColorBuffer::~ColorBuffer() {
     if (validHandle()) {
         m_logicalDevice->as<vk::Device>().destroyImage(as<vk::Image>());
-        m_logicalDevice->as<vk::Device>().freeMemory(deviceMemoryAs<vk::DeviceMemory>());
+        m_logicalDevice->memoryAllocator().free(allocation());
     }
 }
 
@@ -232,9 +232,17 @@ int32 CommandBuffer::present(const CommandBufferPresentSpecification& spec) cons
         .pResults = nullptr,
     };
 
+    // the presentation queue is usually the graphics queue, which uploads share on GPUs without a transfer family
+    const Queue& queue = m_logicalDevice->presentationQueue().index() == m_logicalDevice->graphicsQueue().index()
+                             ? m_logicalDevice->graphicsQueue()
+                             : m_logicalDevice->presentationQueue();
+
     // use C api because vulkan.hpp is too strict
     VkPresentInfoKHR cPresentInfo = presentInfo;
-    return vkQueuePresentKHR(m_logicalDevice->presentationQueue().as<VkQueue>(), &cPresentInfo);
+    queue.lock();
+    const int32 result = vkQueuePresentKHR(queue.as<VkQueue>(), &cPresentInfo);
+    queue.unlock();
+    return result;
 }
 
 } // namespace R3
@@ -36,7 +36,8 @@ CommandPool::CommandPool(const CommandPoolSpecification& spec)
         .sType = vk::StructureType::eCommandPoolCreateInfo,
         .pNext = nullptr,
         .flags = local::CommandPoolFlagsToVkFlags(spec.type),
-        .queueFamilyIndex = m_logicalDevice->graphicsQueue().index(),
+        .queueFamilyIndex = spec.queueType == QueueType::Transfer ? m_logicalDevice->transferQueue().index()
+                                                                  : m_logicalDevice->graphicsQueue().index(),
     };
 
     setHandle(m_logicalDevice->as<vk::Device>().createCommandPool(commandPoolCreateInfo));
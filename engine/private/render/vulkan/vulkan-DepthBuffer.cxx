@@ -34,7 +34,7 @@ DepthBuffer::DepthBuffer(const DepthBufferSpecification& spec)
     auto&& [image, memory] = Image::allocate(imageAllocateSpecification);
 
     setHandle(image.handle());
-    setDeviceMemory(memory.handle());
+    setDeviceMemory(memory);
 
     m_imageView = ImageView({
         .logicalDevice = *m_logicalDevice,
@@ -48,7 +48,7 @@ DepthBuffer::DepthBuffer(const DepthBufferSpecification& spec)
 DepthBuffer::~DepthBuffer() {
     if (validHandle()) {
         m_logicalDevice->as<vk::Device>().destroyImage(as<vk::Image>());
-        m_logicalDevice->as<vk::Device>().freeMemory(deviceMemoryAs<vk::DeviceMemory>());
+        m_logicalDevice->memoryAllocator().free(allocation());
     }
 }
 
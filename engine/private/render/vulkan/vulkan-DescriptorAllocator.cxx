@@ -0,0 +1,154 @@
+#if R3_VULKAN
+
+#include "render/DescriptorAllocator.hpp"
+
+#include <vulkan/vulkan.hpp>
+#include <algorithm>
+#include <utility>
+#include "api/Check.hpp"
+#include "api/Log.hpp"
+#include "render/LogicalDevice.hpp"
+
+namespace R3 {
+
+DescriptorAllocation::DescriptorAllocation(DescriptorAllocation&& src) noexcept
+    : m_allocator(std::exchange(src.m_allocator, nullptr)),
+      m_signature(std::exchange(src.m_signature, 0)),
+      m_pool(std::exchange(src.m_pool, nullptr)),
+      m_descriptorSets(std::move(src.m_descriptorSets)) {}
+
+DescriptorAllocation& DescriptorAllocation::operator=(DescriptorAllocation&& src) noexcept {
+    if (this != &src) {
+        release();
+        m_allocator = std::exchange(src.m_allocator, nullptr);
+        m_signature = std::exchange(src.m_signature, 0);
+        m_pool = std::exchange(src.m_pool, nullptr);
+        m_descriptorSets = std::move(src.m_descriptorSets);
+    }
+    return *this;
+}
+
+DescriptorAllocation::~DescriptorAllocation() {
+    release();
+}
+
+void DescriptorAllocation::release() {
+    if (m_allocator != nullptr) {
+        std::exchange(m_allocator, nullptr)->free(*this);
+        m_descriptorSets.clear();
+    }
+}
+
+DescriptorAllocator::DescriptorAllocator(const DescriptorAllocatorSpecification& spec)
+    : m_logicalDevice(&spec.logicalDevice),
+      m_setsPerPage(spec.setsPerPage) {
+    CHECK(m_setsPerPage > 0);
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+    for (const auto& [signature, layout] : m_layouts) {
+        for (const Page& page : layout->pages) {
+            if (page.free != m_setsPerPage) {
+                LOG(Warning, m_setsPerPage - page.free, "descriptor sets leaked in layout", signature);
+            }
+        }
+    }
+}
+
+const DescriptorLayout& DescriptorAllocator::layout(std::span<const DescriptorSetLayoutBinding> layoutBindings) {
+    const uint64 signature = DescriptorSetLayout::signature(layoutBindings);
+
+    std::scoped_lock lock(m_mutex);
+    std::unique_ptr<Layout>& layout = m_layouts[signature];
+    if (!layout) {
+        layout = std::make_unique<Layout>();
+        layout->bindings.assign(layoutBindings.begin(), layoutBindings.end());
+        layout->layout.descriptorSetLayout = DescriptorSetLayout({
+            .logicalDevice = *m_logicalDevice,
+            .layoutBindings = layout->bindings,
+        });
+        layout->layout.pipelineLayout = PipelineLayout({
+            .logicalDevice = *m_logicalDevice,
+            .descriptorSetLayout = layout->layout.descriptorSetLayout,
+        });
+    }
+    return layout->layout;
+}
+
+DescriptorAllocation DescriptorAllocator::allocate(const DescriptorLayout& descriptorLayout, uint32 count) {
+    CHECK(count > 0 && count <= m_setsPerPage);
+    const uint64 signature = descriptorLayout.descriptorSetLayout.signature();
+
+    std::scoped_lock lock(m_mutex);
+    const auto it = m_layouts.find(signature);
+    CHECK(it != m_layouts.end() && &it->second->layout == &descriptorLayout);
+    Layout& layout = *it->second;
+
+    auto tryAllocate = [&](Page& page) -> std::vector<DescriptorSet> {
+        try {
+            return DescriptorSet::allocate({
+                .logicalDevice = *m_logicalDevice,
+                .descriptorPool = page.pool,
+                .descriptorSetLayout = layout.layout.descriptorSetLayout,
+                .descriptorSetCount = count,
+            });
+        } catch (const vk::FragmentedPoolError&) {
+            return {}; // enough sets are free but scattered, the next page is tried
+        } catch (const vk::OutOfPoolMemoryError&) {
+            return {};
+        }
+    };
+
+    DescriptorAllocation allocation;
+    for (Page& page : layout.pages) {
+        if (page.free >= count) {
+            allocation.m_descriptorSets = tryAllocate(page);
+            if (!allocation.m_descriptorSets.empty()) {
+                page.free -= count;
+                allocation.m_pool = page.pool.handle();
+                break;
+            }
+        }
+    }
+
+    if (allocation.m_descriptorSets.empty()) {
+        Page& page = layout.pages.emplace_back(Page{
+            .pool = DescriptorPool({
+                .logicalDevice = *m_logicalDevice,
+                .descriptorSetCount = m_setsPerPage,
+                .layoutBindings = layout.bindings,
+            }),
+            .free = m_setsPerPage,
+        });
+        allocation.m_descriptorSets = tryAllocate(page);
+        CHECK(!allocation.m_descriptorSets.empty());
+        page.free -= count;
+        allocation.m_pool = page.pool.handle();
+    }
+
+    allocation.m_allocator = this;
+    allocation.m_signature = signature;
+    return allocation;
+}
+
+void DescriptorAllocator::free(DescriptorAllocation& allocation) {
+    std::scoped_lock lock(m_mutex);
+    Layout& layout = *m_layouts.at(allocation.m_signature);
+
+    auto page = std::ranges::find_if(layout.pages, [&](const Page& candidate) {
+        return candidate.pool.handle() == allocation.m_pool;
+    });
+    CHECK(page != layout.pages.end());
+
+    page->pool.free(allocation.m_descriptorSets);
+    page->free += uint32(allocation.m_descriptorSets.size());
+
+    // an emptied page is destroyed unless it is the only one left, the next allocation of the layout reuses it
+    if (page->free == m_setsPerPage && layout.pages.size() > 1) {
+        layout.pages.erase(page);
+    }
+}
+
+} // namespace R3
+
+#endif // R3_VULKAN
@@ -9,11 +9,6 @@ namespace R3 {
 
 DescriptorPool::DescriptorPool(const DescriptorPoolSpecification& spec)
     : m_logicalDevice(&spec.logicalDevice) {
-    m_layout = DescriptorSetLayout({
-        .logicalDevice = *m_logicalDevice,
-        .layoutBindings = spec.layoutBindings,
-    });
-
     std::vector<vk::DescriptorPoolSize> poolSizes;
 
     for (const auto& binding : spec.layoutBindings) {
@@ -38,13 +33,6 @@ DescriptorPool::DescriptorPool(const DescriptorPoolSpecification& spec)
     };
 
     setHandle(m_logicalDevice->as<vk::Device>().createDescriptorPool(descriptorPoolCreateInfo));
-
-    m_descriptorSets = DescriptorSet::allocate({
-        .logicalDevice = *m_logicalDevice,
-        .descriptorPool = *this,
-        .descriptorSetLayout = m_layout,
-        .descriptorSetCount = spec.descriptorSetCount,
-    });
 }
 
 DescriptorPool::~DescriptorPool() {
@@ -53,6 +41,16 @@ DescriptorPool::~DescriptorPool() {
     }
 }
 
+void DescriptorPool::free(std::span<const DescriptorSet> descriptorSets) const {
+    std::vector<vk::DescriptorSet> handles;
+    handles.reserve(descriptorSets.size());
+    for (const DescriptorSet& descriptorSet : descriptorSets) {
+        handles.push_back(descriptorSet.as<vk::DescriptorSet>());
+    }
+
+    m_logicalDevice->as<vk::Device>().freeDescriptorSets(as<vk::DescriptorPool>(), handles);
+}
+
 } // namespace R3
 
 #endif // R3_VULKAN
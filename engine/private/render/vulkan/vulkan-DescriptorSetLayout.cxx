@@ -1,13 +1,15 @@
 #if R3_VULKAN
 
 #include <vulkan/vulkan.hpp>
+#include "api/Hash.hpp"
 #include "render/DescriptorSetLayout.hpp"
 #include "render/LogicalDevice.hpp"
 
 namespace R3 {
 
 DescriptorSetLayout::DescriptorSetLayout(const DescriptorSetLayoutSpecification& spec)
-    : m_logicalDevice(&spec.logicalDevice) {
+    : m_logicalDevice(&spec.logicalDevice),
+      m_signature(signature(spec.layoutBindings)) {
     std::vector<vk::DescriptorSetLayoutBinding> descriptorSetLayoutBindings;
 
     for (const auto& binding : spec.layoutBindings) {
@@ -35,6 +37,17 @@ DescriptorSetLayout::~DescriptorSetLayout() {
     }
 }
 
+uint64 DescriptorSetLayout::signature(std::span<const DescriptorSetLayoutBinding> layoutBindings) {
+    uint64 hash = FNV_OFFSET;
+    for (const DescriptorSetLayoutBinding& binding : layoutBindings) {
+        hash = fnv1aMix(hash, binding.binding);
+        hash = fnv1aMix(hash, uint64(binding.type));
+        hash = fnv1aMix(hash, binding.count);
+        hash = fnv1aMix(hash, binding.stage);
+    }
+    return hash;
+}
+
 } // namespace R3
 
 #endif // R3_VULKAN
@@ -3,6 +3,7 @@
 #include "render/Fence.hpp"
 
 #include <vulkan/vulkan.hpp>
+#include "api/Check.hpp"
 #include "render/LogicalDevice.hpp"
 
 namespace R3 {
@@ -28,6 +29,15 @@ void Fence::reset() {
     m_logicalDevice->as<vk::Device>().resetFences(as<vk::Fence>());
 }
 
+void Fence::wait() const {
+    const vk::Result result = m_logicalDevice->as<vk::Device>().waitForFences(as<vk::Fence>(), vk::True, uint64(-1));
+    CHECK(result == vk::Result::eSuccess);
+}
+
+bool Fence::signalled() const {
+    return m_logicalDevice->as<vk::Device>().getFenceStatus(as<vk::Fence>()) == vk::Result::eSuccess;
+}
+
 } // namespace R3
 
 #endif // R3_VULKAN
@@ -6,36 +6,37 @@
 #include "api/Ensure.hpp"
 #include "render/LogicalDevice.hpp"
 #include "render/PhysicalDevice.hpp"
+#include "render/PipelineCache.hpp"
 #include "render/PipelineLayout.hpp"
 #include "render/RenderPass.hpp"
+#include "render/ShaderLibrary.hpp"
 #include "render/ShaderObjects.hpp"
 #include "render/Swapchain.hpp"
 
 namespace R3 {
 
 GraphicsPipeline::GraphicsPipeline(const GraphicsPipelineSpecification& spec)
-    : m_logicalDevice(&spec.logicalDevice) {
-    m_layout = PipelineLayout({
-        .logicalDevice = spec.logicalDevice,
-        .descriptorSetLayout = spec.descriptorSetLayout,
-    });
-
-    m_vertexShader = Shader({
-        .logicalDevice = spec.logicalDevice,
-        .path = spec.vertexShaderPath,
-    });
-
-    m_fragmentShader = Shader({
-        .logicalDevice = spec.logicalDevice,
-        .path = spec.fragmentShaderPath,
-    });
+    : m_logicalDevice(&spec.logicalDevice),
+      m_layout(&spec.pipelineLayout) {
+    // with a library every pipeline using the same shader shares its module
+    auto loadShader = [&](std::string_view path) -> std::shared_ptr<const Shader> {
+        if (spec.shaderLibrary) {
+            return spec.shaderLibrary->acquire(path);
+        }
+        return std::make_shared<const Shader>(ShaderSpecification{
+            .logicalDevice = spec.logicalDevice,
+            .path = path,
+        });
+    };
+    m_vertexShader = loadShader(spec.vertexShaderPath);
+    m_fragmentShader = loadShader(spec.fragmentShaderPath);
 
     const vk::PipelineShaderStageCreateInfo vertexShaderStageCreateInfo = {
         .sType = vk::StructureType::ePipelineShaderStageCreateInfo,
         .pNext = nullptr,
         .flags = {},
         .stage = vk::ShaderStageFlagBits::eVertex,
-        .module = m_vertexShader.as<vk::ShaderModule>(),
+        .module = m_vertexShader->as<vk::ShaderModule>(),
         .pName = "main",
         .pSpecializationInfo = nullptr,
     };
@@ -45,7 +46,7 @@ GraphicsPipeline::GraphicsPipeline(const GraphicsPipelineSpecification& spec)
         .pNext = nullptr,
         .flags = {},
         .stage = vk::ShaderStageFlagBits::eFragment,
-        .module = m_fragmentShader.as<vk::ShaderModule>(),
+        .module = m_fragmentShader->as<vk::ShaderModule>(),
         .pName = "main",
         .pSpecializationInfo = nullptr,
     };
@@ -202,14 +203,15 @@ GraphicsPipeline::GraphicsPipeline(const GraphicsPipelineSpecification& spec)
         .pDepthStencilState = &depthStencilCreateInfo,
         .pColorBlendState = &colorBlendStateCreateInfo,
         .pDynamicState = &dynamicStateCreateInfo,
-        .layout = m_layout.as<vk::PipelineLayout>(),
+        .layout = m_layout->as<vk::PipelineLayout>(),
         .renderPass = spec.renderPass.as<vk::RenderPass>(),
         .subpass = 0,
         .basePipelineHandle = VK_NULL_HANDLE,
         .basePipelineIndex = -1,
     };
 
-    const auto r = m_logicalDevice->as<vk::Device>().createGraphicsPipeline(nullptr, graphicsPipelineCreateInfo);
+    const vk::PipelineCache pipelineCache = spec.pipelineCache ? spec.pipelineCache->as<vk::PipelineCache>() : nullptr;
+    const auto r = m_logicalDevice->as<vk::Device>().createGraphicsPipeline(pipelineCache, graphicsPipelineCreateInfo);
     ENSURE(r.result == vk::Result::eSuccess);
     setHandle(r.value);
 }
@@ -3,9 +3,9 @@
 #include "render/IndexBuffer.hpp"
 
 #include <vulkan/vulkan.hpp>
-#include "render/CommandPool.hpp"
 #include "render/LogicalDevice.hpp"
 #include "render/PhysicalDevice.hpp"
+#include "render/UploadContext.hpp"
 
 namespace R3 {
 
@@ -13,23 +13,7 @@ template <std::integral T>
 IndexBuffer<T>::IndexBuffer(const IndexBufferSpecification<T>& spec)
     : m_logicalDevice(&spec.logicalDevice),
       m_indexCount(static_cast<uint32>(spec.indices.size())) {
-    // staging buffer, CPU writable
-    const BufferAllocateSpecification stagingAllocateSpecification = {
-        .physicalDevice = spec.physicalDevice,
-        .logicalDevice = *m_logicalDevice,
-        .size = spec.indices.size_bytes(),
-        .bufferFlags = BufferUsage::TransferSrc,
-        .memoryFlags = MemoryProperty::HostVisible | MemoryProperty::HostCoherent,
-    };
-    auto&& [stagingBuffer, stagingMemory] = Buffer::allocate(stagingAllocateSpecification);
-
-    // copy data to staging buffer
-    void* data =
-        m_logicalDevice->template as<vk::Device>().mapMemory(stagingMemory.as<vk::DeviceMemory>(), 0, m_indexCount, {});
-    memcpy(data, spec.indices.data(), spec.indices.size_bytes());
-    m_logicalDevice->template as<vk::Device>().unmapMemory(stagingMemory.as<vk::DeviceMemory>());
-
-    // real buffer, copy staging buffer to this GPU buffer
+    // real buffer, the copy is recorded and staged by the UploadContext
     const BufferAllocateSpecification bufferAllocateSpecification = {
         .physicalDevice = spec.physicalDevice,
         .logicalDevice = *m_logicalDevice,
@@ -39,27 +23,17 @@ IndexBuffer<T>::IndexBuffer(const IndexBufferSpecification<T>& spec)
     };
     auto&& [buffer, memory] = Buffer::allocate(bufferAllocateSpecification);
 
-    const BufferCopySpecification bufferCopySpecification = {
-        .logicalDevice = *m_logicalDevice,
-        .commandBuffer = spec.commandBuffer,
-        .buffer = buffer,
-        .stagingBuffer = stagingBuffer,
-        .size = spec.indices.size_bytes(),
-    };
-    Buffer::copy(bufferCopySpecification);
-
-    m_logicalDevice->template as<vk::Device>().destroyBuffer(stagingBuffer.as<vk::Buffer>());
-    m_logicalDevice->template as<vk::Device>().freeMemory(stagingMemory.as<vk::DeviceMemory>());
+    spec.uploadContext.copy(buffer, std::as_bytes(spec.indices));
 
     setHandle(buffer.handle());
-    setDeviceMemory(memory.handle());
+    setDeviceMemory(memory);
 }
 
 template <std::integral T>
 IndexBuffer<T>::~IndexBuffer() {
     if (validHandle()) {
         m_logicalDevice->template as<vk::Device>().destroyBuffer(as<vk::Buffer>());
-        m_logicalDevice->template as<vk::Device>().freeMemory(deviceMemoryAs<vk::DeviceMemory>());
+        m_logicalDevice->memoryAllocator().free(allocation());
     }
 }
 
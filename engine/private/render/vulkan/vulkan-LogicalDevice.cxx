@@ -15,10 +15,13 @@ LogicalDevice::LogicalDevice(const LogicalDeviceSpecification& spec) {
     const auto queueFamilyIndices = QueueFamilyIndices::query(spec.physicalDevice.handle(), spec.surface.handle());
     CHECK(queueFamilyIndices.isValid());
 
-    const std::set<int32> uniqueQueueIndices = {
+    std::set<int32> uniqueQueueIndices = {
         queueFamilyIndices.graphics,
         queueFamilyIndices.presentation,
     };
+    if (queueFamilyIndices.transfer >= 0) {
+        uniqueQueueIndices.insert(queueFamilyIndices.transfer);
+    }
 
     float queuePriority = 1.0f;
 
@@ -34,9 +37,11 @@ LogicalDevice::LogicalDevice(const LogicalDeviceSpecification& spec) {
         });
     }
 
+    // BCn textures are only uploaded on GPUs supporting them, see TextureBuffer
     const vk::PhysicalDeviceFeatures physicalDeviceFeatures = {
         .sampleRateShading = vk::True,
         .samplerAnisotropy = vk::True,
+        .textureCompressionBC = spec.physicalDevice.as<vk::PhysicalDevice>().getFeatures().textureCompressionBC,
     };
 
     const std::span<const char* const> deviceExtensions = spec.physicalDevice.extensions();
@@ -66,10 +71,43 @@ LogicalDevice::LogicalDevice(const LogicalDeviceSpecification& spec) {
         .queueType = QueueType::Presentation,
         .queueIndex = static_cast<uint32>(queueFamilyIndices.presentation),
     });
+
+    // without a dedicated family uploads go to the graphics queue, sharing its lock
+    const bool dedicatedTransfer = queueFamilyIndices.transfer >= 0;
+    const int32 transferIndex = dedicatedTransfer ? queueFamilyIndices.transfer : queueFamilyIndices.graphics;
+    m_transferQueue.acquire({
+        .logicalDevice = this,
+        .queueType = dedicatedTransfer ? QueueType::Transfer : QueueType::Graphics,
+        .queueIndex = static_cast<uint32>(transferIndex),
+    });
+
+    m_memoryAllocator = std::make_unique<MemoryAllocator>(MemoryAllocatorSpecification{
+        .physicalDevice = spec.physicalDevice,
+        .logicalDevice = *this,
+    });
+}
+
+void LogicalDevice::waitIdle() const {
+    // vkDeviceWaitIdle requires every queue externally synchronized, loaders submit to the transfer queue meanwhile
+    // queues are locked in a fixed order, the transfer queue is the graphics queue without a transfer family
+    m_graphicsQueue.lock();
+    if (m_transferQueue.type() == QueueType::Transfer) {
+        m_transferQueue.lock();
+    }
+    m_presentationQueue.lock();
+
+    as<vk::Device>().waitIdle();
+
+    m_presentationQueue.unlock();
+    if (m_transferQueue.type() == QueueType::Transfer) {
+        m_transferQueue.unlock();
+    }
+    m_graphicsQueue.unlock();
 }
 
 LogicalDevice::~LogicalDevice() {
     if (validHandle()) {
+        m_memoryAllocator.reset();
         as<vk::Device>().destroy();
     }
 }
@@ -0,0 +1,239 @@
+#if R3_VULKAN
+
+#include "render/MemoryAllocator.hpp"
+
+#include <vulkan/vulkan.hpp>
+#include <algorithm>
+#include <bit>
+#include "api/Check.hpp"
+#include "api/Log.hpp"
+#include "render/LogicalDevice.hpp"
+#include "render/PhysicalDevice.hpp"
+
+namespace R3 {
+
+MemoryAllocator::MemoryAllocator(const MemoryAllocatorSpecification& spec)
+    : m_device(spec.logicalDevice.handle()) {
+    CHECK(std::has_single_bit(spec.blockSize) && spec.blockSize >= MIN_SIZE);
+
+    const auto gpu = spec.physicalDevice.as<vk::PhysicalDevice>();
+    const vk::PhysicalDeviceMemoryProperties memoryProperties = gpu.getMemoryProperties();
+    m_maxDeviceAllocations = gpu.getProperties().limits.maxMemoryAllocationCount;
+
+    for (uint32 i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        m_heaps.push_back({
+            .size = memoryProperties.memoryHeaps[i].size,
+            .deviceLocal = bool(memoryProperties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal),
+        });
+    }
+
+    // integrated GPUs and BAR memory can have heaps of a few hundred MiB, a block must not take most of them
+    m_pools.resize(usize(memoryProperties.memoryTypeCount) * 2);
+    for (uint32 i = 0; i < m_pools.size(); i++) {
+        const vk::MemoryType& memoryType = memoryProperties.memoryTypes[i / 2];
+        Pool& pool = m_pools[i];
+        pool.memoryType = i / 2;
+        pool.heap = memoryType.heapIndex;
+        pool.hostVisible = bool(memoryType.propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible);
+        pool.blockSize = std::clamp(std::bit_floor(usize(m_heaps[pool.heap].size / 8)), MIN_SIZE, spec.blockSize);
+    }
+}
+
+MemoryAllocator::~MemoryAllocator() {
+    for (const Pool& pool : m_pools) {
+        if (pool.dedicated != 0) {
+            LOG(Warning, pool.dedicated, "dedicated allocations leaked in memory type", pool.memoryType);
+        }
+        for (const Block& block : pool.blocks) {
+            if (block.allocations != 0) {
+                LOG(Warning, block.allocations, "allocations leaked in memory type", pool.memoryType);
+            }
+            freeMemory(block.memory);
+        }
+    }
+}
+
+MemoryAllocation MemoryAllocator::allocate(const MemoryAllocateSpecification& spec) {
+    CHECK(spec.size > 0);
+    CHECK(std::has_single_bit(spec.alignment));
+
+    const uint32 poolIndex = spec.memoryType * 2 + uint32(spec.image);
+    const usize size = std::bit_ceil(std::max({spec.size, spec.alignment, MIN_SIZE}));
+
+    std::scoped_lock lock(m_mutex);
+    CHECK(poolIndex < m_pools.size());
+    Pool& pool = m_pools[poolIndex];
+
+    // a range of a power of two size is aligned to its size, which covers the resource alignment
+    if (size > pool.blockSize / 2) {
+        const auto [memory, mapped] = allocateMemory(pool, spec.size);
+        pool.dedicated++;
+        pool.dedicatedBytes += spec.size;
+        return {
+            .memory = memory,
+            .offset = 0,
+            .size = spec.size,
+            .mapped = mapped,
+            .pool = poolIndex,
+            .dedicated = true,
+        };
+    }
+
+    const uint32 order = uint32(std::countr_zero(size / MIN_SIZE));
+    usize offset = 0;
+    auto block = std::ranges::find_if(pool.blocks, [&](Block& candidate) { return take(candidate, order, offset); });
+
+    if (block == pool.blocks.end()) {
+        const auto [memory, mapped] = allocateMemory(pool, pool.blockSize);
+        Block& created = pool.blocks.emplace_back(Block{
+            .memory = memory,
+            .mapped = mapped,
+        });
+        const uint32 orders = uint32(std::countr_zero(pool.blockSize / MIN_SIZE)) + 1;
+        created.free.resize(orders);
+        created.free.back().push_back(0);
+
+        block = std::prev(pool.blocks.end());
+        CHECK(take(*block, order, offset));
+    }
+
+    block->used += size;
+    block->allocations++;
+    return {
+        .memory = block->memory,
+        .offset = offset,
+        .size = size,
+        .mapped = block->mapped ? block->mapped + offset : nullptr,
+        .pool = poolIndex,
+        .dedicated = false,
+    };
+}
+
+void MemoryAllocator::free(const MemoryAllocation& allocation) {
+    if (allocation.memory == nullptr) {
+        return;
+    }
+
+    std::scoped_lock lock(m_mutex);
+    Pool& pool = m_pools[allocation.pool];
+
+    if (allocation.dedicated) {
+        freeMemory(allocation.memory);
+        pool.dedicated--;
+        pool.dedicatedBytes -= allocation.size;
+        return;
+    }
+
+    auto block = std::ranges::find(pool.blocks, allocation.memory, &Block::memory);
+    CHECK(block != pool.blocks.end());
+
+    give(*block, uint32(std::countr_zero(allocation.size / MIN_SIZE)), allocation.offset);
+    block->used -= allocation.size;
+    block->allocations--;
+
+    // one empty block is kept per pool, so a resource recreated every frame does not reallocate memory
+    if (block->allocations == 0 && pool.blocks.size() > 1) {
+        freeMemory(block->memory);
+        pool.blocks.erase(block);
+    }
+}
+
+MemoryStats MemoryAllocator::stats() const {
+    MemoryStats stats = {
+        .heaps = m_heaps,
+        .maxDeviceAllocations = m_maxDeviceAllocations,
+    };
+
+    std::scoped_lock lock(m_mutex);
+    stats.deviceAllocations = m_deviceAllocations;
+
+    for (const Pool& pool : m_pools) {
+        MemoryHeapStats& heap = stats.heaps[pool.heap];
+        heap.reserved += pool.blocks.size() * pool.blockSize + pool.dedicatedBytes;
+        heap.used += pool.dedicatedBytes;
+        heap.blocks += uint32(pool.blocks.size()) + pool.dedicated;
+        heap.allocations += pool.dedicated;
+
+        for (const Block& block : pool.blocks) {
+            heap.used += block.used;
+            heap.allocations += block.allocations;
+
+            const auto largest = std::ranges::find_if(block.free.rbegin(), block.free.rend(), [](const auto& offsets) {
+                return !offsets.empty();
+            });
+            if (largest != block.free.rend()) {
+                const usize order = usize(std::distance(largest, block.free.rend()) - 1);
+                heap.largestFree = std::max(heap.largestFree, MIN_SIZE << order);
+            }
+        }
+    }
+
+    return stats;
+}
+
+std::tuple<NativeRenderObject::Handle, std::byte*> MemoryAllocator::allocateMemory(const Pool& pool, usize size) {
+    const auto device = static_cast<vk::Device>(static_cast<VkDevice>(m_device));
+
+    const vk::MemoryAllocateInfo memoryAllocateInfo = {
+        .sType = vk::StructureType::eMemoryAllocateInfo,
+        .pNext = nullptr,
+        .allocationSize = size,
+        .memoryTypeIndex = pool.memoryType,
+    };
+    const vk::DeviceMemory memory = device.allocateMemory(memoryAllocateInfo);
+    m_deviceAllocations++;
+
+    // NOTE HostVisible memory stays mapped, every resource placed in it writes through its own range
+    std::byte* mapped = nullptr;
+    if (pool.hostVisible) {
+        mapped = static_cast<std::byte*>(device.mapMemory(memory, 0, vk::WholeSize, {}));
+    }
+
+    return {static_cast<VkDeviceMemory>(memory), mapped};
+}
+
+void MemoryAllocator::freeMemory(NativeRenderObject::Handle memory) {
+    // mapped memory is implicitly unmapped once freed
+    const auto device = static_cast<vk::Device>(static_cast<VkDevice>(m_device));
+    device.freeMemory(static_cast<vk::DeviceMemory>(static_cast<VkDeviceMemory>(memory)));
+    m_deviceAllocations--;
+}
+
+bool MemoryAllocator::take(Block& block, uint32 order, usize& offset) {
+    // smallest free range that fits, split in halves down to order
+    uint32 found = order;
+    while (found < block.free.size() && block.free[found].empty()) {
+        found++;
+    }
+    if (found >= block.free.size()) {
+        return false;
+    }
+
+    offset = block.free[found].back();
+    block.free[found].pop_back();
+    while (found > order) {
+        found--;
+        block.free[found].push_back(offset + (MIN_SIZE << found));
+    }
+    return true;
+}
+
+void MemoryAllocator::give(Block& block, uint32 order, usize offset) {
+    // merge with the buddy range while it is free as well
+    while (order + 1 < block.free.size()) {
+        std::vector<usize>& free = block.free[order];
+        const auto buddy = std::ranges::find(free, offset ^ (MIN_SIZE << order));
+        if (buddy == free.end()) {
+            break;
+        }
+        offset = std::min(offset, *buddy);
+        *buddy = free.back();
+        free.pop_back();
+        order++;
+    }
+    block.free[order].push_back(offset);
+}
+
+} // namespace R3
+
+#endif // R3_VULKAN
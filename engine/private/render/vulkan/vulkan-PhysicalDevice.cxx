@@ -85,6 +85,11 @@ uint32 PhysicalDevice::queryMemoryType(uint32 typeFilter, uint64 propertyFlags)
     ENSURE(false); /* unable to find suitable memory type */
 }
 
+bool PhysicalDevice::sampledFormat(Format format) const {
+    const vk::FormatProperties properties = as<vk::PhysicalDevice>().getFormatProperties(vk::Format(format));
+    return bool(properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImage);
+}
+
 bool PhysicalDevice::checkExtensionSupport(const NativeRenderObject& deviceHandle) const {
     auto deviceExtensions = deviceHandle.as<vk::PhysicalDevice>().enumerateDeviceExtensionProperties();
 
@@ -0,0 +1,126 @@
+#if R3_VULKAN
+
+#include "render/PipelineCache.hpp"
+
+#include <vulkan/vulkan.hpp>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include "api/Hash.hpp"
+#include "api/Log.hpp"
+#include "render/DescriptorSetLayout.hpp"
+#include "render/LogicalDevice.hpp"
+#include "render/PhysicalDevice.hpp"
+#include "render/RenderPass.hpp"
+#include "render/ShaderObjects.hpp"
+
+namespace R3 {
+
+namespace local {
+
+// length first, so consecutive strings cannot shift characters between each other
+static uint64 mix(uint64 hash, std::string_view text) {
+    return fnv1a(text, fnv1aMix(hash, text.size()));
+}
+
+// data written by another GPU or driver is not passed to the driver, some crash instead of ignoring it
+static bool compatible(std::span<const std::byte> data, const vk::PhysicalDeviceProperties& properties) {
+    vk::PipelineCacheHeaderVersionOne header;
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    return header.headerSize >= sizeof(header) && header.headerVersion == vk::PipelineCacheHeaderVersion::eOne &&
+           header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+           header.pipelineCacheUUID == properties.pipelineCacheUUID;
+}
+
+} // namespace local
+
+PipelineCache::PipelineCache(const PipelineCacheSpecification& spec)
+    : m_logicalDevice(&spec.logicalDevice),
+      m_shaderLibrary(&spec.shaderLibrary),
+      m_path(spec.path) {
+    std::vector<std::byte> data;
+    if (std::ifstream ifs(m_path, std::ios::ate | std::ios::binary); ifs.is_open()) {
+        data.resize(usize(ifs.tellg()));
+        ifs.seekg(0);
+        ifs.read(reinterpret_cast<char*>(data.data()), std::streamsize(data.size()));
+    }
+
+    if (!data.empty() && !local::compatible(data, spec.physicalDevice.as<vk::PhysicalDevice>().getProperties())) {
+        LOG(Info, "pipeline cache", m_path.string(), "was written by another GPU or driver, rebuilding it");
+        data.clear();
+    }
+
+    const vk::PipelineCacheCreateInfo pipelineCacheCreateInfo = {
+        .sType = vk::StructureType::ePipelineCacheCreateInfo,
+        .pNext = nullptr,
+        .flags = {},
+        .initialDataSize = data.size(),
+        .pInitialData = data.empty() ? nullptr : data.data(),
+    };
+
+    setHandle(m_logicalDevice->as<vk::Device>().createPipelineCache(pipelineCacheCreateInfo));
+}
+
+PipelineCache::~PipelineCache() {
+    if (validHandle()) {
+        save();
+        m_logicalDevice->as<vk::Device>().destroyPipelineCache(as<vk::PipelineCache>());
+    }
+}
+
+uint64 PipelineCache::key(const GraphicsPipelineSpecification& spec) {
+    uint64 hash = FNV_OFFSET;
+    hash = fnv1aMix(hash, uint64(reinterpret_cast<std::uintptr_t>(spec.renderPass.handle())));
+    hash = fnv1aMix(hash, spec.descriptorSetLayout.signature());
+
+    hash = fnv1aMix(hash, spec.vertexBindingSpecification.binding);
+    hash = fnv1aMix(hash, spec.vertexBindingSpecification.stride);
+    hash = fnv1aMix(hash, uint64(spec.vertexBindingSpecification.inputRate));
+    for (const VertexAttributeSpecification& attribute : spec.vertexAttributeSpecification) {
+        hash = fnv1aMix(hash, attribute.location);
+        hash = fnv1aMix(hash, attribute.binding);
+        hash = fnv1aMix(hash, uint64(attribute.format));
+        hash = fnv1aMix(hash, attribute.offset);
+    }
+
+    hash = local::mix(hash, spec.vertexShaderPath);
+    hash = local::mix(hash, spec.fragmentShaderPath);
+    hash = fnv1aMix(hash, uint64(spec.msaa));
+    return hash;
+}
+
+std::shared_ptr<const GraphicsPipeline> PipelineCache::acquire(const GraphicsPipelineSpecification& spec) {
+    const uint64 pipelineKey = key(spec);
+
+    std::scoped_lock lock(m_mutex);
+    std::weak_ptr<const GraphicsPipeline>& entry = m_pipelines[pipelineKey];
+    if (std::shared_ptr<const GraphicsPipeline> pipeline = entry.lock()) {
+        return pipeline;
+    }
+
+    GraphicsPipelineSpecification cached = spec;
+    cached.pipelineCache = this;
+    cached.shaderLibrary = m_shaderLibrary.get();
+    auto pipeline = std::make_shared<const GraphicsPipeline>(cached);
+    entry = pipeline;
+    return pipeline;
+}
+
+void PipelineCache::save() const {
+    const std::vector<uint8> data = m_logicalDevice->as<vk::Device>().getPipelineCacheData(as<vk::PipelineCache>());
+
+    std::ofstream ofs(m_path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        LOG(Warning, "failed to save pipeline cache", m_path.string());
+        return;
+    }
+    ofs.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+}
+
+} // namespace R3
+
+#endif // R3_VULKAN
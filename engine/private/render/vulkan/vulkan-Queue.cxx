@@ -10,6 +10,7 @@ namespace R3 {
 
 static std::mutex s_graphicsMutex;
 static std::mutex s_presentationMutex;
+static std::mutex s_transferMutex;
 
 QueueFamilyIndices QueueFamilyIndices::query(NativeRenderObject&& physicalDeviceHandle,
                                              NativeRenderObject&& surfaceHandle) {
@@ -37,6 +38,17 @@ QueueFamilyIndices QueueFamilyIndices::query(NativeRenderObject&& physicalDevice
         i++;
     }
 
+    // a family without graphics and compute is a DMA engine, copying alongside rendering instead of between it
+    for (uint32 i = 0; const auto& queueFamily : queueFamilies) {
+        const vk::QueueFlags flags = queueFamily.queueFlags;
+        if ((flags & vk::QueueFlagBits::eTransfer) && !(flags & vk::QueueFlagBits::eGraphics) &&
+            !(flags & vk::QueueFlagBits::eCompute) && int32(i) != queueFamilyIndices.presentation) {
+            queueFamilyIndices.transfer = i;
+            break;
+        }
+        i++;
+    }
+
     return queueFamilyIndices;
 }
 
@@ -49,6 +61,8 @@ void Queue::acquire(const QueueSpecification& spec) {
 void Queue::lock() const {
     if (m_queueType == QueueType::Graphics) {
         s_graphicsMutex.lock();
+    } else if (m_queueType == QueueType::Transfer) {
+        s_transferMutex.lock();
     } else {
         s_presentationMutex.lock();
     }
@@ -57,6 +71,8 @@ void Queue::lock() const {
 void Queue::unlock() const {
     if (m_queueType == QueueType::Graphics) {
         s_graphicsMutex.unlock();
+    } else if (m_queueType == QueueType::Transfer) {
+        s_transferMutex.unlock();
     } else {
         s_presentationMutex.unlock();
     }
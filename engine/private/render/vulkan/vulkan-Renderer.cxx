@@ -19,6 +19,24 @@ namespace R3 {
 
 static constexpr auto DEPTH_ARRAY_SCALE = 2048;
 
+// coarsest level whose error projects to at most the threshold, switching coarser has to clear it by the hysteresis
+static uint32 selectLod(const Mesh& mesh, uint32 current, const LodSettings& settings, float pixelsPerUnit) {
+    const uint32 levels = uint32(mesh.lods.size());
+    if (settings.forced >= 0) {
+        return std::min(uint32(settings.forced), levels - 1);
+    }
+
+    uint32 lod = std::min(current, levels - 1);
+    while (lod > 0 && mesh.lods[lod].error * pixelsPerUnit > settings.threshold) {
+        lod--;
+    }
+    while (lod + 1 < levels &&
+           mesh.lods[lod + 1].error * pixelsPerUnit <= settings.threshold * (1.0f - settings.hysteresis)) {
+        lod++;
+    }
+    return lod;
+}
+
 Renderer::Renderer(const RendererSpecification& spec)
     : m_window(spec.window) {
     //--- Instance Extensions
@@ -146,14 +164,41 @@ Renderer::Renderer(const RendererSpecification& spec)
         .renderPass = m_renderPass,
     });
 
+    //--- Staging Ring
+    m_stagingRing = std::make_unique<StagingRing>(StagingRingSpecification{
+        .physicalDevice = m_physicalDevice,
+        .logicalDevice = m_logicalDevice,
+    });
+
+    //--- Shader Library
+    m_shaderLibrary = std::make_unique<ShaderLibrary>(ShaderLibrarySpecification{
+        .logicalDevice = m_logicalDevice,
+    });
+
+    //--- Descriptor Allocator
+    m_descriptorAllocator = std::make_unique<DescriptorAllocator>(DescriptorAllocatorSpecification{
+        .logicalDevice = m_logicalDevice,
+    });
+
+    //--- Pipeline Cache
+    m_pipelineCache = std::make_unique<PipelineCache>(PipelineCacheSpecification{
+        .physicalDevice = m_physicalDevice,
+        .logicalDevice = m_logicalDevice,
+        .shaderLibrary = *m_shaderLibrary,
+    });
+
     //--- Model Loader
-    m_modelLoader = ModelLoader({
+    m_modelLoader = std::make_unique<ModelLoader>(ModelLoaderSpecification{
         .physicalDevice = m_physicalDevice,
         .logicalDevice = m_logicalDevice,
         .swapchain = m_swapchain,
         .renderPass = m_renderPass,
-        .commandPool = m_commandPool,
         .storageBuffer = m_storageBuffer,
+        .stagingRing = *m_stagingRing,
+        .pipelineCache = *m_pipelineCache,
+        .descriptorAllocator = *m_descriptorAllocator,
+        .textureCache = m_textureCache,
+        .threadPool = spec.threadPool,
     });
 
     //--- Shader View Projection
@@ -264,15 +309,43 @@ void Renderer::render() {
 
     //*************************************** RENDER PASS BEGIN ***************************************//
 
+    // pixels covered by one unit of model space at distance 1
+    const float pixelsPerUnit = std::abs(m_viewProjection.projection[1][1]) * float(m_swapchain.extent().y) * 0.5f;
+    const vec3 cameraPosition = Scene::cameraPosition();
+    m_frameStats = {};
+    const GraphicsPipeline* boundPipeline = nullptr;
+
     // draw every mesh of every model
     auto draw = [&](auto entity, const TransformComponent& transform, ModelComponent& model) {
-        for (Mesh& mesh : model.meshes) {
-            auto& uniform = mesh.material.uniforms[m_currentFrame];
-            auto& lightUniform = mesh.material.uniforms[m_currentFrame + MAX_FRAMES_IN_FLIGHT];
-            const auto& descriptorSet = mesh.material.descriptorPool.descriptorSets()[m_currentFrame];
+        const float scale = std::max(
+            {glm::length(vec3(transform[0])), glm::length(vec3(transform[1])), glm::length(vec3(transform[2]))});
 
-            cmd.bindPipeline(mesh.pipeline);
-            cmd.bindDescriptorSet(mesh.pipeline.layout(), descriptorSet);
+        if (model.status != ModelStatus::Ready || !model.resource) {
+            return; // pending or failed
+        }
+
+        for (usize m = 0; m < model.meshes.size(); m++) {
+            const Mesh& mesh = model.resource->meshes[m];
+            MeshInstance& instance = model.meshes[m];
+            if (mesh.lods.empty()) {
+                continue;
+            }
+
+            const vec3 center = vec3(transform * vec4(vec3(mesh.bounds), 1.0f));
+            const float distance = std::max(glm::length(center - cameraPosition) - mesh.bounds.w * scale, 0.001f);
+            instance.lod = selectLod(mesh, instance.lod, model.lodSettings, pixelsPerUnit * scale / distance);
+
+            auto& uniform = instance.uniforms[m_currentFrame];
+            auto& lightUniform = instance.uniforms[m_currentFrame + MAX_FRAMES_IN_FLIGHT];
+            const auto& descriptorSet = instance.descriptorSets.descriptorSets()[m_currentFrame];
+
+            // meshes of identical state share a pipeline, it is only bound when it changes
+            if (mesh.pipeline.get() != boundPipeline) {
+                cmd.bindPipeline(*mesh.pipeline);
+                boundPipeline = mesh.pipeline.get();
+                m_frameStats.pipelineBinds++;
+            }
+            cmd.bindDescriptorSet(mesh.pipeline->layout(), descriptorSet);
 
             FragmentPushConstant fragmentPushConstant = {
                 .cursorPosition = m_cursorPosition,
@@ -280,10 +353,10 @@ void Renderer::render() {
                 .selected = m_editor.currentEntity(),
             };
             cmd.pushConstants(
-                mesh.pipeline.layout(), ShaderStage::Fragment, &fragmentPushConstant, sizeof(fragmentPushConstant));
+                mesh.pipeline->layout(), ShaderStage::Fragment, &fragmentPushConstant, sizeof(fragmentPushConstant));
 
             VertexUniformBufferObject vubo = {
-                .model = transform,
+                .model = transform * mesh.dequantize,
                 .view = m_viewProjection.view,
                 .projection = m_viewProjection.projection,
                 .finalBoneTransforms = {},
@@ -294,7 +367,7 @@ void Renderer::render() {
             uniform.write(&vubo, sizeof(vubo));
 
             FragmentUniformBufferObject fubo = {
-                .cameraPosition = Scene::cameraPosition(),
+                .cameraPosition = cameraPosition,
                 .pbrFlags = mesh.material.pbrFlags,
                 .lightCount = static_cast<uint32>(m_pointLights.size()),
                 .pointLights = {},
@@ -303,8 +376,15 @@ void Renderer::render() {
             lightUniform.write(&fubo, sizeof(fubo));
 
             cmd.bindVertexBuffer(mesh.vertexBuffer);
-            cmd.bindIndexBuffer(mesh.indexBuffer);
-            cmd.as<vk::CommandBuffer>().drawIndexed(mesh.indexBuffer.count(), 1, 0, 0, 0);
+            std::visit(
+                [&](const auto& indexBuffer) {
+                    cmd.bindIndexBuffer(indexBuffer);
+                    cmd.as<vk::CommandBuffer>().drawIndexed(indexBuffer.count(), 1, 0, 0, 0);
+                    m_frameStats.triangles += indexBuffer.count() / 3;
+                },
+                mesh.lods[instance.lod].indexBuffer);
+            m_frameStats.draws++;
+            m_frameStats.lodDraws[instance.lod]++;
         }
     };
     Entity::componentView<TransformComponent, ModelComponent>().each(draw);
@@ -373,6 +453,9 @@ void Renderer::renderEditorInterface(double dt) {
     m_editor.displayProperties();
     m_editor.displaySceneManager();
     m_editor.displayDeltaTime(dt);
+    m_editor.displayFrameStats(m_frameStats);
+    m_editor.displayTextureCache(m_textureCache.stats());
+    m_editor.displayMemory(m_logicalDevice.memoryAllocator().stats());
     m_editor.endFrame();
 }
 
@@ -392,7 +475,7 @@ void Renderer::updateLighting() {
 }
 
 void Renderer::waitIdle() const {
-    m_logicalDevice.as<vk::Device>().waitIdle();
+    m_logicalDevice.waitIdle();
 }
 
 } // namespace R3
@@ -11,20 +11,25 @@ namespace R3 {
 
 Shader::Shader(const ShaderSpecification& spec)
     : m_logicalDevice(&spec.logicalDevice) {
-    std::ifstream ifs(spec.path.data(), std::ios::ate | std::ios::binary);
-    CHECK(ifs.is_open());
-
-    std::vector<char> bytes(ifs.tellg());
-    ifs.seekg(0);
-    ifs.read(bytes.data(), bytes.size());
-    ifs.close();
+    std::vector<std::byte> bytes;
+    std::span<const std::byte> code = spec.code;
+    if (code.empty()) {
+        std::ifstream ifs(spec.path.data(), std::ios::ate | std::ios::binary);
+        CHECK(ifs.is_open());
+
+        bytes.resize(ifs.tellg());
+        ifs.seekg(0);
+        ifs.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+        ifs.close();
+        code = bytes;
+    }
 
     const vk::ShaderModuleCreateInfo shaderModuleCreateInfo = {
         .sType = vk::StructureType::eShaderModuleCreateInfo,
         .pNext = nullptr,
         .flags = {},
-        .codeSize = static_cast<uint32>(bytes.size()),
-        .pCode = reinterpret_cast<const uint32*>(bytes.data()),
+        .codeSize = static_cast<uint32>(code.size()),
+        .pCode = reinterpret_cast<const uint32*>(code.data()),
     };
 
     setHandle(m_logicalDevice->as<vk::Device>().createShaderModule(shaderModuleCreateInfo));
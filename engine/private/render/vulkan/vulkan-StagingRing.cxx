@@ -0,0 +1,115 @@
+#if R3_VULKAN
+
+#include "render/StagingRing.hpp"
+
+#include <vulkan/vulkan.hpp>
+#include <algorithm>
+#include "api/Check.hpp"
+#include "render/LogicalDevice.hpp"
+#include "render/PhysicalDevice.hpp"
+
+namespace R3 {
+
+namespace local {
+
+// regions start aligned for the largest texel block
+static constexpr usize ALIGNMENT = 16;
+
+} // namespace local
+
+StagingRing::StagingRing(const StagingRingSpecification& spec)
+    : m_logicalDevice(&spec.logicalDevice),
+      m_size(spec.size),
+      m_chunkSize(spec.chunkSize) {
+    CHECK(m_chunkSize > 0 && m_chunkSize <= m_size);
+
+    const BufferAllocateSpecification bufferAllocateSpecification = {
+        .physicalDevice = spec.physicalDevice,
+        .logicalDevice = *m_logicalDevice,
+        .size = m_size,
+        .bufferFlags = BufferUsage::TransferSrc,
+        .memoryFlags = MemoryProperty::HostVisible | MemoryProperty::HostCoherent,
+    };
+    auto&& [buffer, memory] = Buffer::allocate(bufferAllocateSpecification);
+
+    // NOTE mapped by the MemoryAllocator for the lifetime of the ring, every upload writes to it
+    m_mappedMemory = memory.mapped;
+    CHECK(m_mappedMemory != nullptr);
+
+    setHandle(buffer.handle());
+    setDeviceMemory(memory);
+}
+
+StagingRing::~StagingRing() {
+    CHECK(m_live.empty());
+
+    if (validHandle()) {
+        m_logicalDevice->as<vk::Device>().destroyBuffer(as<vk::Buffer>());
+        m_logicalDevice->memoryAllocator().free(allocation());
+    }
+}
+
+std::optional<StagingRegion> StagingRing::tryAllocate(usize size) {
+    CHECK(size > 0 && size <= m_chunkSize);
+
+    std::scoped_lock lock(m_mutex);
+    const std::optional<usize> offset = fit(size);
+    if (!offset) {
+        return std::nullopt;
+    }
+
+    m_live.push_back({*offset, size, false});
+    return StagingRegion{*offset, size, m_mappedMemory + *offset};
+}
+
+StagingRegion StagingRing::allocate(usize size) {
+    CHECK(size > 0 && size <= m_chunkSize);
+
+    std::unique_lock lock(m_mutex);
+    std::optional<usize> offset;
+    m_released.wait(lock, [&]() { return (offset = fit(size)).has_value(); });
+
+    m_live.push_back({*offset, size, false});
+    return StagingRegion{*offset, size, m_mappedMemory + *offset};
+}
+
+void StagingRing::release(const StagingRegion& region) {
+    {
+        std::scoped_lock lock(m_mutex);
+        auto it = std::ranges::find(m_live, region.offset, &Live::offset);
+        CHECK(it != m_live.end());
+        it->released = true;
+
+        // uploads complete out of order, memory is only reclaimed from the oldest region on
+        while (!m_live.empty() && m_live.front().released) {
+            m_live.pop_front();
+        }
+    }
+    m_released.notify_all();
+}
+
+std::optional<usize> StagingRing::fit(usize size) const {
+    if (m_live.empty()) {
+        return 0;
+    }
+
+    const usize head = (m_live.back().offset + m_live.back().size + local::ALIGNMENT - 1) & ~(local::ALIGNMENT - 1);
+    const usize tail = m_live.front().offset;
+
+    // free memory is [head, end) and [0, tail) until the newest region wraps around, then [head, tail)
+    if (m_live.back().offset >= tail) {
+        if (head + size <= m_size) {
+            return head;
+        }
+        if (size <= tail) {
+            return 0;
+        }
+    } else if (head + size <= tail) {
+        return head;
+    }
+    return std::nullopt;
+}
+
+} // namespace R3
+
+#endif // R3_VULKAN
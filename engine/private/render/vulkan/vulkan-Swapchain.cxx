@@ -85,7 +85,7 @@ Swapchain::Swapchain(const SwapchainSpecification& spec)
 
 void Swapchain::recreate(const SwapchainRecreationSpecification& spec) {
     CHECK(spec.framebuffers.size() == m_imageViews.size());
-    m_logicalDevice->as<vk::Device>().waitIdle();
+    m_logicalDevice->waitIdle();
 
     vk::PhysicalDevice vkPhysicalDevice = m_physicalDevice->as<vk::PhysicalDevice>();
     vk::SurfaceKHR vkSurface = m_surface->as<vk::SurfaceKHR>();
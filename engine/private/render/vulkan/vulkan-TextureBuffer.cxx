@@ -2,150 +2,89 @@
 
 #include "render/TextureBuffer.hpp"
 
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
 #include <vulkan/vulkan.hpp>
+#include <algorithm>
 #include "api/Check.hpp"
-#include "render/CommandPool.hpp"
+#include "api/Ensure.hpp"
+#include "api/Log.hpp"
+#include "media/ktx2/Ktx2.hxx"
+#include "media/mip/MipChain.hxx"
 #include "render/Image.hpp"
 #include "render/LogicalDevice.hpp"
 #include "render/PhysicalDevice.hpp"
-#include "render/Queue.hpp"
-#include "render/Swapchain.hpp"
+#include "render/UploadContext.hpp"
 
 namespace R3 {
 
 TextureBuffer::TextureBuffer(const TextureBufferSpecification& spec)
     : m_logicalDevice(&spec.logicalDevice),
       m_type(spec.type) {
-    CHECK((spec.path != nullptr) ^ (spec.data != nullptr) ^ (spec.raw != nullptr));
-
-    // check for blitting capability
-    [[maybe_unused]] const auto& gpu = spec.physicalDevice.as<vk::PhysicalDevice>();
-    CHECK(gpu.getFormatProperties(vk::Format::eR8G8B8A8Srgb).optimalTilingFeatures &
-          vk::FormatFeatureFlagBits::eSampledImageFilterLinear);
-
-    // defaults
-    int32 w = spec.width;
-    int32 h = spec.height;
-    int32 channels = 4;
-    const int32 len = spec.height ? spec.width * spec.height : spec.width;
-
-    const std::byte* bytes = nullptr;
-
-    if (spec.path) {
-        // modifies defaults
-        bytes = std::bit_cast<const std::byte*>(stbi_load(spec.path, &w, &h, &channels, 0));
-    } else if (spec.data) {
-        // modifies defaults
-        bytes = std::bit_cast<const std::byte*>(
-            stbi_load_from_memory(std::bit_cast<const stbi_uc*>(spec.data), len, &w, &h, &channels, 0));
-    } else if (spec.raw) {
-        bytes = spec.raw;
+    CHECK(spec.raw != nullptr && spec.mipLevels > 0);
+
+    m_format = spec.format;
+    const uint32 w = spec.width;
+    const uint32 h = spec.height;
+    std::vector<std::span<const std::byte>> levels; // stored levels, largest first
+    usize offset = 0;
+    for (uint32 level = 0; level < spec.mipLevels; level++) {
+        const usize size = ktx2::levelSize(m_format, std::max(w >> level, 1u), std::max(h >> level, 1u));
+        levels.emplace_back(spec.raw + offset, size);
+        offset += size;
     }
 
-    CHECK(bytes != nullptr);
-    const usize imageSize = usize(w * h * 4);
-    auto mipLevels = static_cast<uint32>(std::floor(std::log2(std::max(w, h)))) + 1;
+    // the TexturePipeline already swapped in the glTF fallback image, if the source had one
+    if (!spec.physicalDevice.sampledFormat(m_format)) {
+        LOG(Error, "texture format", uint32(m_format), "cannot be sampled on this GPU");
+        ENSURE(false);
+    }
 
-    // staging buffer for wriring
-    const BufferAllocateSpecification bufferAllocateSpecification = {
-        .physicalDevice = spec.physicalDevice,
-        .logicalDevice = *m_logicalDevice,
-        .size = imageSize,
-        .bufferFlags = BufferUsage::TransferSrc,
-        .memoryFlags = MemoryProperty::HostVisible | MemoryProperty::HostCoherent,
-    };
-    auto&& [stagingBuffer, stagingMemory] = Buffer::allocate(bufferAllocateSpecification);
-
-    // copy image data to buffer
-    void* data = m_logicalDevice->as<vk::Device>().mapMemory(stagingMemory.as<vk::DeviceMemory>(), 0, imageSize, {});
-    {
-        // no Alpha channel
-        if (channels == 3) {
-            uint32* rgba = reinterpret_cast<uint32*>(data);
-            static constexpr uint32 OPAQUE_MASK = 0xFF00'0000;
-            const uint32 rgbSize = w * h * 3;
-
-            for (uint32 i = 0, j = 0; i < rgbSize; i += 3, j++) {
-                // we overide the alpha channel with opaque mask 0xFF
-                rgba[j] = (*(reinterpret_cast<const uint32*>(&bytes[i])) | OPAQUE_MASK);
-            }
-        }
-        // has Alpha Channel
-        else {
-            memcpy(data, bytes, imageSize);
+    // a single level is filtered into a full chain here, transfer queues cannot blit
+    // block compressed levels cannot be filtered, their mip chain is only what was stored
+    std::vector<std::byte> chain;
+    if (levels.size() == 1 && !ktx2::blockCompressed(m_format)) {
+        CHECK(m_format == Format::R8G8B8A8Srgb || m_format == Format::R8G8B8A8Unorm);
+        chain.assign(levels.front().begin(), levels.front().end());
+        const uint32 count = mip::generate(chain, w, h, m_format == Format::R8G8B8A8Srgb);
+
+        levels.clear();
+        offset = 0;
+        for (uint32 level = 0; level < count; level++) {
+            const usize size = ktx2::levelSize(m_format, std::max(w >> level, 1u), std::max(h >> level, 1u));
+            levels.emplace_back(chain.data() + offset, size);
+            offset += size;
         }
     }
-    m_logicalDevice->as<vk::Device>().unmapMemory(stagingMemory.as<vk::DeviceMemory>());
+    const uint32 mipLevels = uint32(levels.size());
 
-    if (!spec.raw) {
-        stbi_image_free((void*)bytes);
-    }
+    m_size = ktx2::chainSize(m_format, w, h, mipLevels);
 
     // real image we use to store data
     const ImageAllocateSpecification imageAllocateSpecification = {
         .physicalDevice = spec.physicalDevice,
         .logicalDevice = *m_logicalDevice,
-        .size = imageSize,
-        .format = Format::R8G8B8A8Srgb,
-        .width = static_cast<uint32>(w),
-        .height = static_cast<uint32>(h),
+        .size = m_size,
+        .format = m_format,
+        .width = w,
+        .height = h,
         .mipLevels = mipLevels,
         .samples = 1,
-        .imageFlags = ImageUsage::TransferSrc | ImageUsage::TransferDst | ImageUsage::Sampled,
+        .imageFlags = ImageUsage::TransferDst | ImageUsage::Sampled,
         .memoryFlags = MemoryProperty::DeviceLocal,
     };
 
     auto&& [img, memory] = Image::allocate(imageAllocateSpecification);
     Image image(img.handle());
 
-    // transition image layout in pipeline
-    const ImageLayoutTransitionSpecification imageLayoutTransitionSpecificationWrite = {
-        .commandBuffer = spec.commandBuffer,
-        .image = image,
-        .srcAccessor = {},
-        .dstAccessor = MemoryAccessor::TransferWrite,
-        .oldLayout = ImageLayout::Undefined,
-        .newLayout = ImageLayout::TransferDstOptimal,
-        .aspectMask = ImageAspect::Color,
-        .mipLevels = mipLevels,
-        .srcStageMask = PipelineStage::TopOfPipe,
-        .dstStageMask = PipelineStage::Transfer,
-    };
-    Image::transition(imageLayoutTransitionSpecificationWrite);
-
-    const ImageCopySpecification imageCopySpecification = {
-        .logicalDevice = *m_logicalDevice,
-        .commandBuffer = spec.commandBuffer,
-        .dst = image,
-        .src = stagingBuffer,
-        .size = imageSize,
-        .width = static_cast<uint32>(w),
-        .height = static_cast<uint32>(h),
-        .copyType = ImageCopyType::BufferToImage,
-    };
-    Image::copy(imageCopySpecification);
-
-    const ImageMipmapSpecification imageMipmapSpecification = {
-        .commandBuffer = spec.commandBuffer,
-        .image = image,
-        .mipLevels = mipLevels,
-        .width = w,
-        .height = h,
-    };
-    Image::generateMipMaps(imageMipmapSpecification);
-
-    m_logicalDevice->as<vk::Device>().destroyBuffer(stagingBuffer.as<vk::Buffer>());
-    m_logicalDevice->as<vk::Device>().freeMemory(stagingMemory.as<vk::DeviceMemory>());
+    // staged and left in ShaderReadOnlyOptimal by the UploadContext
+    spec.uploadContext.copy(image, m_format, w, h, levels);
 
     setHandle(image.handle());
-    setDeviceMemory(memory.handle());
+    setDeviceMemory(memory);
 
     m_imageView = ImageView({
         .logicalDevice = *m_logicalDevice,
         .image = image,
-        .format = Format::R8G8B8A8Srgb,
+        .format = m_format,
         .mipLevels = mipLevels,
         .aspectMask = ImageAspect::Color,
     });
@@ -160,7 +99,7 @@ TextureBuffer::TextureBuffer(const TextureBufferSpecification& spec)
 TextureBuffer::~TextureBuffer() {
     if (validHandle()) {
         m_logicalDevice->as<vk::Device>().destroyImage(as<vk::Image>());
-        m_logicalDevice->as<vk::Device>().freeMemory(deviceMemoryAs<vk::DeviceMemory>());
+        m_logicalDevice->memoryAllocator().free(allocation());
     }
 }
 
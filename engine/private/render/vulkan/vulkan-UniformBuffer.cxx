@@ -20,18 +20,18 @@ UniformBuffer::UniformBuffer(const UniformBufferSpecification& spec)
     };
     auto&& [buffer, memory] = Buffer::allocate(bufferAllocateSpecification);
 
-    // NOTE we DON'T unmap this memory because mapping isn't free and we write to it every frame
-    m_mappedMemory = m_logicalDevice->as<vk::Device>().mapMemory(memory.as<vk::DeviceMemory>(), 0, m_bufferSize, {});
+    // NOTE HostVisible memory is mapped by the MemoryAllocator for its whole lifetime, we write to it every frame
+    m_mappedMemory = memory.mapped;
+    CHECK(m_mappedMemory != nullptr);
 
     setHandle(buffer.handle());
-    setDeviceMemory(memory.handle());
+    setDeviceMemory(memory);
 }
 
 UniformBuffer::~UniformBuffer() {
     if (validHandle()) {
-        m_logicalDevice->as<vk::Device>().unmapMemory(deviceMemoryAs<vk::DeviceMemory>());
         m_logicalDevice->as<vk::Device>().destroyBuffer(as<vk::Buffer>());
-        m_logicalDevice->as<vk::Device>().freeMemory(deviceMemoryAs<vk::DeviceMemory>());
+        m_logicalDevice->memoryAllocator().free(allocation());
     }
 }
 
@@ -0,0 +1,218 @@
+#if R3_VULKAN
+
+#include "render/UploadContext.hpp"
+
+#include <vulkan/vulkan.hpp>
+#include <algorithm>
+#include <cstring>
+#include "api/Check.hpp"
+#include "media/ktx2/Ktx2.hxx"
+#include "render/LogicalDevice.hpp"
+#include "render/Swapchain.hpp"
+
+namespace R3 {
+
+UploadContext::UploadContext(const UploadContextSpecification& spec)
+    : m_logicalDevice(&spec.logicalDevice),
+      m_stagingRing(&spec.stagingRing),
+      m_commandPool({
+          .logicalDevice = spec.logicalDevice,
+          .swapchain = spec.swapchain,
+          .type = CommandPoolType::Transient | CommandPoolType::Reset,
+          .commandBufferCount = BATCHES,
+          .queueType = QueueType::Transfer,
+      }) {
+    for (Batch& batch : m_batches) {
+        batch.fence = Fence({*m_logicalDevice});
+    }
+}
+
+UploadContext::~UploadContext() {
+    submit();
+
+    for (Batch& batch : m_batches) {
+        batch.fence.wait();
+        release(batch);
+    }
+}
+
+void UploadContext::copy(const NativeRenderObject& buffer, std::span<const std::byte> bytes) {
+    const usize chunkSize = m_stagingRing->chunkSize();
+    for (usize offset = 0; offset < bytes.size(); offset += chunkSize) {
+        const StagingRegion region = stage(bytes.subspan(offset, std::min(chunkSize, bytes.size() - offset)));
+
+        const vk::BufferCopy bufferCopy = {
+            .srcOffset = region.offset,
+            .dstOffset = offset,
+            .size = region.size,
+        };
+        record().as<vk::CommandBuffer>().copyBuffer(
+            m_stagingRing->as<vk::Buffer>(), buffer.as<vk::Buffer>(), bufferCopy);
+    }
+}
+
+void UploadContext::copy(const Image& image,
+                         Format format,
+                         uint32 width,
+                         uint32 height,
+                         std::span<const std::span<const std::byte>> levels) {
+    CHECK(!levels.empty());
+
+    const auto barrier = [&](vk::AccessFlags srcAccess,
+                             vk::AccessFlags dstAccess,
+                             vk::ImageLayout oldLayout,
+                             vk::ImageLayout newLayout,
+                             vk::PipelineStageFlags srcStage,
+                             vk::PipelineStageFlags dstStage) {
+        const vk::ImageMemoryBarrier imageMemoryBarrier = {
+            .sType = vk::StructureType::eImageMemoryBarrier,
+            .pNext = nullptr,
+            .srcAccessMask = srcAccess,
+            .dstAccessMask = dstAccess,
+            .oldLayout = oldLayout,
+            .newLayout = newLayout,
+            .srcQueueFamilyIndex = vk::QueueFamilyIgnored,
+            .dstQueueFamilyIndex = vk::QueueFamilyIgnored,
+            .image = image.as<vk::Image>(),
+            .subresourceRange =
+                {
+                    .aspectMask = vk::ImageAspectFlagBits::eColor,
+                    .baseMipLevel = 0,
+                    .levelCount = uint32(levels.size()),
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+        };
+        record().as<vk::CommandBuffer>().pipelineBarrier(srcStage, dstStage, {}, {}, {}, {imageMemoryBarrier});
+    };
+
+    barrier({},
+            vk::AccessFlagBits::eTransferWrite,
+            vk::ImageLayout::eUndefined,
+            vk::ImageLayout::eTransferDstOptimal,
+            vk::PipelineStageFlagBits::eTopOfPipe,
+            vk::PipelineStageFlagBits::eTransfer);
+
+    // a level larger than a chunk is copied in bands of whole block rows
+    const uint32 blockHeight = ktx2::blockCompressed(format) ? 4 : 1;
+    for (uint32 level = 0; level < levels.size(); level++) {
+        const uint32 w = std::max(width >> level, 1u);
+        const uint32 h = std::max(height >> level, 1u);
+        const usize rowSize = ktx2::levelSize(format, w, blockHeight);
+        CHECK(rowSize <= m_stagingRing->chunkSize());
+        const uint32 bandHeight = uint32(m_stagingRing->chunkSize() / rowSize) * blockHeight;
+
+        for (uint32 y = 0; y < h; y += bandHeight) {
+            const uint32 rows = std::min(bandHeight, h - y);
+            const usize offset = usize(y / blockHeight) * rowSize;
+            const StagingRegion region = stage(levels[level].subspan(offset, ktx2::levelSize(format, w, rows)));
+
+            const vk::BufferImageCopy bufferImageCopy = {
+                .bufferOffset = region.offset,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource =
+                    {
+                        .aspectMask = vk::ImageAspectFlagBits::eColor,
+                        .mipLevel = level,
+                        .baseArrayLayer = 0,
+                        .layerCount = 1,
+                    },
+                .imageOffset = {0, int32(y), 0},
+                .imageExtent = {w, rows, 1},
+            };
+            record().as<vk::CommandBuffer>().copyBufferToImage(m_stagingRing->as<vk::Buffer>(),
+                                                               image.as<vk::Image>(),
+                                                               vk::ImageLayout::eTransferDstOptimal,
+                                                               bufferImageCopy);
+        }
+    }
+
+    // a transfer queue has no fragment stage, readers are ordered after the copy by waiting for the fence
+    barrier(vk::AccessFlagBits::eTransferWrite,
+            {},
+            vk::ImageLayout::eTransferDstOptimal,
+            vk::ImageLayout::eShaderReadOnlyOptimal,
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eBottomOfPipe);
+}
+
+uint64 UploadContext::submit() {
+    if (!m_recording) {
+        return m_submitted;
+    }
+
+    Batch& batch = m_batches[m_current];
+    const CommandBuffer& commandBuffer = m_commandPool.commandBuffers()[m_current];
+    commandBuffer.endCommandBuffer();
+
+    const auto vkCommandBuffer = commandBuffer.as<vk::CommandBuffer>();
+    const vk::SubmitInfo submitInfo = {
+        .sType = vk::StructureType::eSubmitInfo,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &vkCommandBuffer,
+    };
+
+    batch.fence.reset();
+
+    const Queue& queue = m_logicalDevice->transferQueue();
+    queue.lock();
+    queue.as<vk::Queue>().submit(submitInfo, batch.fence.as<vk::Fence>());
+    queue.unlock();
+
+    batch.ticket = ++m_submitted;
+    m_current = (m_current + 1) % BATCHES;
+    m_recording = false;
+    return batch.ticket;
+}
+
+void UploadContext::wait(uint64 ticket) {
+    // a ticket no batch holds anymore was waited for before its batch was recorded again
+    for (Batch& batch : m_batches) {
+        if (batch.ticket != 0 && batch.ticket <= ticket) {
+            batch.fence.wait();
+            release(batch);
+        }
+    }
+}
+
+const CommandBuffer& UploadContext::record() {
+    const CommandBuffer& commandBuffer = m_commandPool.commandBuffers()[m_current];
+    if (m_recording) {
+        return commandBuffer;
+    }
+
+    Batch& batch = m_batches[m_current];
+    batch.fence.wait();
+    release(batch);
+
+    commandBuffer.resetCommandBuffer();
+    commandBuffer.beginCommandBuffer(CommandBufferUsage::OneTimeSubmit);
+    m_recording = true;
+    return commandBuffer;
+}
+
+StagingRegion UploadContext::stage(std::span<const std::byte> bytes) {
+    std::optional<StagingRegion> region = m_stagingRing->tryAllocate(bytes.size());
+    if (!region) {
+        // the ring may be full of this context's own copies, which are only released once they completed
+        flush();
+        region = m_stagingRing->allocate(bytes.size());
+    }
+
+    std::memcpy(region->data, bytes.data(), bytes.size());
+    record();
+    m_batches[m_current].staging.push_back(*region);
+    return *region;
+}
+
+void UploadContext::release(Batch& batch) {
+    for (const StagingRegion& region : batch.staging) {
+        m_stagingRing->release(region);
+    }
+    batch.staging.clear();
+}
+
+} // namespace R3
+
+#endif // R3_VULKAN
@@ -7,7 +7,12 @@ namespace R3 {
 void AnimationSystem::tick(double dt) {
     // apply keyframe animations to all models
     auto animate = [&](ModelComponent& model) {
-        if (model.animation.running) {
+        // pending and failed models have no keyframes or skeleton yet
+        if (model.status != ModelStatus::Ready) {
+            return;
+        }
+
+        if (model.animation.running && !model.animation.keyFrames.empty()) {
             model.animation.currentTime += float(dt);
             if (model.animation.currentTime >= model.animation.maxTime) {
                 model.animation.currentTime = 0;
@@ -1,9 +1,12 @@
 #pragma once
 
 /// @file Hash.hpp
-/// @brief Provides means of hashing at compile time
-/// Uses crc32 and crc64 hashing algorithms which are `consteval`ed
+/// @brief Provides means of hashing at compile time and at runtime
+/// Uses crc32 and crc64 hashing algorithms which are `consteval`ed, and 64 bit FNV-1a for runtime keys
 
+#include <cstddef>
+#include <span>
+#include <string_view>
 #include "Types.hpp"
 
 namespace R3 {
@@ -125,4 +128,40 @@ consteval uuid64 HASH64(const char (&s)[N]) {
     return ~crc;
 }
 
+/// @brief FNV-1a 64 bit offset basis, the hash of no bytes
+inline constexpr uint64 FNV_OFFSET = 0xcbf2'9ce4'8422'2325;
+
+/// @brief FNV-1a 64 bit prime
+inline constexpr uint64 FNV_PRIME = 0x0000'0100'0000'01b3;
+
+/// @brief Mix one value into an FNV-1a hash
+/// @param hash running hash
+/// @param value
+/// @return hash
+constexpr uint64 fnv1aMix(uint64 hash, uint64 value) {
+    return (hash ^ value) * FNV_PRIME;
+}
+
+/// @brief FNV-1a of bytes, matches scripts/compile_shaders.py
+/// @param bytes
+/// @param hash running hash, FNV_OFFSET to start a new one
+/// @return hash
+constexpr uint64 fnv1a(std::span<const std::byte> bytes, uint64 hash = FNV_OFFSET) {
+    for (std::byte b : bytes) {
+        hash = fnv1aMix(hash, std::to_integer<uint64>(b));
+    }
+    return hash;
+}
+
+/// @brief FNV-1a of the characters of text
+/// @param text
+/// @param hash running hash, FNV_OFFSET to start a new one
+/// @return hash
+constexpr uint64 fnv1a(std::string_view text, uint64 hash = FNV_OFFSET) {
+    for (char c : text) {
+        hash = fnv1aMix(hash, uint8(c));
+    }
+    return hash;
+}
+
 } // namespace R3
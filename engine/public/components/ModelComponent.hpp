@@ -5,24 +5,48 @@
 #include <R3>
 #include "render/model/Animation.hpp"
 #include "render/model/Mesh.hpp"
+#include "render/model/ModelResource.hpp"
 #include "render/model/Skeleton.hpp"
 
 namespace R3 {
 
+/// @brief Level of detail selection of every Mesh of a ModelComponent, tunable from the editor Properties panel
+struct R3_API LodSettings {
+    float threshold = 1.0f;   ///< largest geometric error on screen in pixels before a finer LOD is drawn
+    float hysteresis = 0.25f; ///< fraction below threshold a coarser LOD needs, keeps LODs from flickering
+    int32 forced = -1;        ///< draw this LOD regardless of distance, -1 selects per frame
+};
+
+/// @brief Loading state of a ModelComponent
+enum class R3_API ModelStatus : uint8 {
+    Pending, ///< loading on another thread, not drawn yet
+    Ready,   ///< loaded and drawn
+    Failed,  ///< could not be loaded, never drawn
+};
+
+struct ModelLoad; ///< @private
+
 /// @brief ModelComponent holds Mesh data
 /// A ModelComponent is constructed through the ModelLoader owned by the Renderer
+/// Geometry and materials are shared with every ModelComponent of the same file, only draw state, skeleton pose and
+/// animation time belong to the entity
 struct R3_API ModelComponent {
     DEFAULT_CONSTRUCT(ModelComponent);
     NO_COPY(ModelComponent);
     DEFAULT_MOVE(ModelComponent);
 
-    /// @brief Create Model by filepath
+    /// @brief Create Model by filepath, returns at once and loads in the background
+    /// The model is Pending until a later frame completes it and pushes a ModelLoadedEvent
     /// @param path
     ModelComponent(const std::string& path);
 
-    std::vector<Mesh> meshes;
-    Skeleton skeleton;
+    ModelStatus status = ModelStatus::Ready;       ///< the remaining members are empty unless Ready
+    std::shared_ptr<ModelLoad> load;               ///< load in flight while Pending
+    std::shared_ptr<const ModelResource> resource; ///< shared geometry and materials
+    std::vector<MeshInstance> meshes;              ///< draw state of every resource->meshes
+    Skeleton skeleton;                             ///< pose of this entity
     Animation animation;
+    LodSettings lodSettings;
 };
 
 } // namespace R3
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <R3>
+#include "core/ThreadPool.hpp"
 #include "render/Renderer.hpp"
 #include "render/Window.hpp"
 
@@ -17,20 +18,28 @@ enum class R3_API EngineStatusCode {
     DlOutOfDate = 1,
 };
 
+/// @brief Engine Specification
+struct R3_API EngineSpecification {
+    uint32 workerThreads = 0; ///< ThreadPool workers, 0 picks from the hardware threads
+};
+
 class R3_API Engine final {
 public:
-    HIDDEN_CONSTRUCT(Engine);
+    HIDDEN_CONSTRUCT(Engine, const EngineSpecification& spec = {});
 
     [[nodiscard]] constexpr Window& window() { return m_window; }
 
     [[nodiscard]] constexpr Renderer& renderer() { return m_renderer; }
 
+    [[nodiscard]] constexpr ThreadPool& threadPool() { return m_threadPool; }
+
     [[nodiscard]] EngineStatusCode loop(const char* dlName);
 
     [[nodiscard]] double deltaTime();
 
 private:
     Window m_window;
+    ThreadPool m_threadPool; // outlives the Renderer, whose ModelLoader queues work on it
     Renderer m_renderer;
 };
 
@@ -0,0 +1,49 @@
+#pragma once
+
+/// Owned by Engine and shared by every system that offloads work from the main thread
+
+#include <R3>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace R3 {
+
+/// @brief Fixed set of worker threads running tasks in submission order
+/// Tasks must not block on other tasks of the same pool, every worker could be the one waiting
+class R3_API ThreadPool {
+public:
+    NO_COPY(ThreadPool);
+    NO_MOVE(ThreadPool);
+
+    /// @brief Start the worker threads
+    /// @param threadCount worker count, 0 picks one less than the hardware threads so the main thread keeps a core
+    explicit ThreadPool(uint32 threadCount = 0);
+
+    /// @brief Run every task still queued, then join the worker threads
+    ~ThreadPool();
+
+    /// @brief Queue a task, thread safe
+    /// Exceptions escaping task are logged and dropped
+    /// @param task
+    void enqueue(std::function<void()> task);
+
+    /// @brief Query the worker count
+    /// @return threads
+    [[nodiscard]] uint32 threadCount() const { return uint32(m_threads.size()); }
+
+private:
+    void work();
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stopping = false;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace R3
@@ -2,6 +2,9 @@
 
 #include <R3>
 #include "render/CommandBuffer.hpp"
+#include "render/FrameStats.hpp"
+#include "render/MemoryAllocator.hpp"
+#include "render/model/TextureCache.hpp"
 
 namespace R3::editor {
 
@@ -33,6 +36,12 @@ public:
 
     void displayDeltaTime(double dt);
 
+    void displayFrameStats(const FrameStats& stats);
+
+    void displayTextureCache(const TextureCacheStats& stats);
+
+    void displayMemory(const MemoryStats& stats);
+
     void initializeDocking();
 
     void displayHierarchy();
@@ -0,0 +1,21 @@
+#pragma once
+
+/// @file ModelEvent.hpp
+/// @brief Provides Model Event Types for Events and Listeners
+
+#include "api/Types.hpp"
+#include "input/Event.hpp"
+
+namespace R3 {
+
+/// @brief Model Loaded Payload
+struct ModelLoadedPayload {
+    uuid32 entity; ///< Entity whose ModelComponent finished loading
+    bool success;  ///< false if the file could not be loaded, the ModelComponent is then ModelStatus::Failed
+};
+
+/// @brief Model Loaded Event "on-model-loaded"
+/// Pushed once a ModelComponent is ready to be drawn or failed to load
+using ModelLoadedEvent = EVENT("on-model-loaded", ModelLoadedPayload);
+
+} // namespace R3
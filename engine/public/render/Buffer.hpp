@@ -16,15 +16,6 @@ struct R3_API BufferAllocateSpecification {
     MemoryProperty::Flags memoryFlags;    ///< Memory property flags
 };
 
-/// @brief Spec for copying a buffer of memory, either on CPU or GPU
-struct R3_API BufferCopySpecification {
-    const LogicalDevice& logicalDevice;      ///< LogicalDevice
-    const CommandBuffer& commandBuffer;      ///< CommandBuffer, a pool, used for one-time-command
-    NativeRenderObject& buffer;              ///< Desination Buffer
-    const NativeRenderObject& stagingBuffer; ///< Source Buffer
-    usize size;                              ///< Buffer size in bytes
-};
-
 /// @brief Buffer abstraction, Contains a Buffer Handle and a DeviceMemory handle,
 /// The Buffer handle is typically used for manipulation while the DeviceMemory handle is for allocation details
 class R3_API Buffer : public DeviceMemory {
@@ -35,13 +26,9 @@ protected:
 
     /// @brief Allocate a Buffer with given flags
     /// @param spec
-    /// @return (Buffer object, DeviceMemory object)
+    /// @return (Buffer object, memory range from LogicalDevice::memoryAllocator)
     [[nodiscard]] static auto allocate(const BufferAllocateSpecification& spec)
-        -> std::tuple<NativeRenderObject, NativeRenderObject>;
-
-    /// @brief Copy stagingBuffer to buffer
-    /// @param spec
-    void static copy(const BufferCopySpecification& spec);
+        -> std::tuple<NativeRenderObject, MemoryAllocation>;
 };
 
 } // namespace R3
\ No newline at end of file
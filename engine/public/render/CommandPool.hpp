@@ -5,6 +5,7 @@
 
 #include "api/Flag.hpp"
 #include "render/CommandBuffer.hpp"
+#include "render/Queue.hpp"
 #include "render/RenderApi.hpp"
 
 namespace R3 {
@@ -20,10 +21,11 @@ struct R3_API CommandPoolType : public Flag {
 
 /// @brief Command Pool Specification
 struct R3_API CommandPoolSpecification {
-    const LogicalDevice& logicalDevice; ///< Logical Device
-    const Swapchain& swapchain;         ///< Swapchain
-    CommandPoolType::Flags type;        ///< CommandPool type
-    uint32 commandBufferCount;          ///< CommandBuffer count
+    const LogicalDevice& logicalDevice;        ///< Logical Device
+    const Swapchain& swapchain;                ///< Swapchain
+    CommandPoolType::Flags type;               ///< CommandPool type
+    uint32 commandBufferCount;                 ///< CommandBuffer count
+    QueueType queueType = QueueType::Graphics; ///< Queue the CommandBuffers are submitted to, Graphics or Transfer
 };
 
 /// @brief CommandPool is used to allocate CommandBuffers from
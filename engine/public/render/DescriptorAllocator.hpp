@@ -0,0 +1,109 @@
+#pragma once
+
+/// @brief Allocates DescriptorSets from pages of pools and shares layouts between identical bindings
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "render/DescriptorPool.hpp"
+#include "render/DescriptorSet.hpp"
+#include "render/DescriptorSetLayout.hpp"
+#include "render/PipelineLayout.hpp"
+#include "render/RenderApi.hpp"
+
+namespace R3 {
+
+/// @brief Descriptor Allocator Specification
+struct R3_API DescriptorAllocatorSpecification {
+    const LogicalDevice& logicalDevice; ///< LogicalDevice
+    uint32 setsPerPage = 256;           ///< DescriptorSets of a pool, pages are added when every pool is full
+};
+
+/// @brief Layouts shared by every user of identical bindings, alive as long as the DescriptorAllocator
+struct R3_API DescriptorLayout {
+    DescriptorSetLayout descriptorSetLayout; ///< Layout sets are allocated with
+    PipelineLayout pipelineLayout;           ///< Layout of pipelines binding a single set of descriptorSetLayout
+};
+
+/// @brief DescriptorSets allocated from a DescriptorAllocator, freed back to it on destruction
+class R3_API DescriptorAllocation {
+public:
+    DEFAULT_CONSTRUCT(DescriptorAllocation);
+    NO_COPY(DescriptorAllocation);
+
+    DescriptorAllocation(DescriptorAllocation&& src) noexcept;
+    DescriptorAllocation& operator=(DescriptorAllocation&& src) noexcept;
+
+    /// @brief Free the sets
+    ~DescriptorAllocation();
+
+    /// @brief Query DescriptorSets
+    /// @return sets
+    [[nodiscard]] constexpr std::vector<DescriptorSet>& descriptorSets() { return m_descriptorSets; }
+
+    /// @brief Query DescriptorSets
+    /// @return sets
+    [[nodiscard]] constexpr const std::vector<DescriptorSet>& descriptorSets() const { return m_descriptorSets; }
+
+private:
+    friend class DescriptorAllocator;
+
+    void release();
+
+private:
+    DescriptorAllocator* m_allocator = nullptr; // null once freed or moved from
+    uint64 m_signature = 0;
+    NativeRenderObject::Handle m_pool = nullptr;
+    std::vector<DescriptorSet> m_descriptorSets;
+};
+
+/// @brief Descriptor allocator, owned by the Renderer
+/// Every layout signature has its own pages, each a DescriptorPool sized for setsPerPage sets of the layout. A page
+/// is added once none can fit an allocation, and freed once empty unless it is the last of its layout, thread safe
+class R3_API DescriptorAllocator {
+public:
+    NO_COPY(DescriptorAllocator);
+    NO_MOVE(DescriptorAllocator);
+
+    /// @brief Construct DescriptorAllocator from spec, no pool is created until the first allocation
+    /// @param spec
+    DescriptorAllocator(const DescriptorAllocatorSpecification& spec);
+
+    /// @brief Destroy every pool and layout, every allocation must have been freed
+    ~DescriptorAllocator();
+
+    /// @brief Get the layouts of bindings, created on first use and shared by every later caller
+    /// @param layoutBindings
+    /// @return layouts, keyed by DescriptorSetLayout::signature
+    [[nodiscard]] const DescriptorLayout& layout(std::span<const DescriptorSetLayoutBinding> layoutBindings);
+
+    /// @brief Allocate DescriptorSets of a layout
+    /// @param layout returned by layout()
+    /// @param count number of sets, at most setsPerPage
+    /// @return sets, freed when the allocation is destroyed
+    [[nodiscard]] DescriptorAllocation allocate(const DescriptorLayout& layout, uint32 count);
+
+private:
+    struct Page {
+        DescriptorPool pool;
+        uint32 free = 0;
+    };
+
+    struct Layout {
+        DescriptorLayout layout;
+        std::vector<DescriptorSetLayoutBinding> bindings;
+        std::vector<Page> pages;
+    };
+
+    void free(DescriptorAllocation& allocation);
+
+private:
+    Ref<const LogicalDevice> m_logicalDevice;
+    uint32 m_setsPerPage = 0;
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64, std::unique_ptr<Layout>> m_layouts; // stable addresses, handed out by layout()
+};
+
+} // namespace R3
@@ -9,12 +9,12 @@ namespace R3 {
 /// @brief Descriptor Pool Specification
 struct R3_API DescriptorPoolSpecification {
     const LogicalDevice& logicalDevice;                         ///< LogicalDevice
-    uint32 descriptorSetCount;                                  ///< Number of DescriptorSets to allocate
-    std::span<const DescriptorSetLayoutBinding> layoutBindings; ///< DescriptorSetLayoutBinding
+    uint32 descriptorSetCount;                                  ///< Number of DescriptorSets the pool holds
+    std::span<const DescriptorSetLayoutBinding> layoutBindings; ///< Bindings of every set, sizes the pool
 };
 
-/// @brief DescriptorPool owns and manages DescriptorSets
-/// DescriptorPools are allocated by GlobalResourceManager
+/// @brief DescriptorPool holds the memory of DescriptorSets, sets are allocated and freed individually
+/// DescriptorPools are the pages of the DescriptorAllocator
 class R3_API DescriptorPool : public NativeRenderObject {
 public:
     DEFAULT_CONSTRUCT(DescriptorPool);
@@ -25,25 +25,15 @@ public:
     /// @param spec
     DescriptorPool(const DescriptorPoolSpecification& spec);
 
-    /// @brief Free pool and DescriptorSets
+    /// @brief Free pool and every DescriptorSet allocated from it
     ~DescriptorPool();
 
-    /// @brief Query DesciptorSetLayout used by this pool
-    /// @return Layout
-    [[nodiscard]] constexpr const DescriptorSetLayout& layout() const { return m_layout; }
-
-    /// @brief Query DescriptorSets owned by this pool
-    /// @return sets
-    [[nodiscard]] constexpr std::vector<DescriptorSet>& descriptorSets() { return m_descriptorSets; }
-
-    /// @brief Query DescriptorSets owned by this pool
-    /// @return sets
-    [[nodiscard]] constexpr const std::vector<DescriptorSet>& descriptorSets() const { return m_descriptorSets; }
+    /// @brief Return DescriptorSets to the pool
+    /// @param descriptorSets allocated from this pool
+    void free(std::span<const DescriptorSet> descriptorSets) const;
 
 private:
     Ref<const LogicalDevice> m_logicalDevice;
-    DescriptorSetLayout m_layout;
-    std::vector<DescriptorSet> m_descriptorSets;
 };
 
 } // namespace R3
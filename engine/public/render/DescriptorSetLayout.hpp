@@ -34,8 +34,18 @@ public:
     /// @brief Destroy Layout
     ~DescriptorSetLayout();
 
+    /// @brief Hash of layoutBindings, layouts of equal signature are identically defined and so compatible
+    /// @param layoutBindings
+    /// @return signature
+    [[nodiscard]] static uint64 signature(std::span<const DescriptorSetLayoutBinding> layoutBindings);
+
+    /// @brief Query the signature of the bindings the layout was created with
+    /// @return signature
+    [[nodiscard]] constexpr uint64 signature() const { return m_signature; }
+
 private:
     Ref<const LogicalDevice> m_logicalDevice;
+    uint64 m_signature = 0;
 };
 
 } // namespace R3
\ No newline at end of file
@@ -3,12 +3,13 @@
 /// @brief Base for classes that need to allocate GPU memory
 
 #include "NativeRenderObject.hpp"
+#include "render/MemoryAllocator.hpp"
 
 namespace R3 {
 
 /// @brief DeviceMemory base class
 /// derived classes can store both their own Handle and a Memory handle (see VertexBuffer for example implementation)
-/// it holds a Handle to the VAO itself and a handle to the device memory in the buffer
+/// it holds a Handle to the VAO itself and the range of device memory it is bound to
 /// @note DeviceMemory does not handle clean up in anyway as it does not know implementation details
 class R3_API DeviceMemory : public NativeRenderObject {
 protected:
@@ -18,14 +19,14 @@ protected:
 
     /// @brief Query is device memory is null
     /// @return true if null
-    [[nodiscard]] constexpr bool validDeviceMemory() const { return m_deviceMemory != nullptr; }
+    [[nodiscard]] constexpr bool validDeviceMemory() const { return m_allocation.memory != nullptr; }
 
     /// @brief Retrieve opaque buffer const handle
     /// @tparam T cast to T type
     /// @return buffer handle
     template <typename T>
     [[nodiscard]] constexpr T deviceMemory() const {
-        return reinterpret_cast<T>(m_deviceMemory.get());
+        return reinterpret_cast<T>(m_allocation.memory);
     }
 
     /// @brief Return buffer as a new type, used for C -> C++ bindings
@@ -34,26 +35,23 @@ protected:
     template <typename T>
     [[nodiscard]] constexpr T deviceMemoryAs() const {
         if constexpr (IsWrapper<T>) {
-            return static_cast<T>(reinterpret_cast<typename T::NativeType>(m_deviceMemory.get()));
+            return static_cast<T>(reinterpret_cast<typename T::NativeType>(m_allocation.memory));
         } else {
-            return static_cast<T>(m_deviceMemory.get());
+            return static_cast<T>(m_allocation.memory);
         }
     }
 
-    /// @brief Set Buffer handle
-    /// @param bufferHandle
-    template <typename T = Handle>
-    constexpr void setDeviceMemory(const T& bufferHandle) {
-        if constexpr (IsWrapper<T>) {
-            m_deviceMemory = reinterpret_cast<Handle>(static_cast<typename T::NativeType>(bufferHandle));
-        } else {
-            m_deviceMemory = reinterpret_cast<Handle>(bufferHandle);
-        }
-    }
+    /// @brief Retrieve the range of the device memory block the handle is bound to
+    /// @return allocation, to be returned to MemoryAllocator::free
+    [[nodiscard]] constexpr const MemoryAllocation& allocation() const { return m_allocation; }
+
+    /// @brief Set device memory
+    /// @param allocation
+    constexpr void setDeviceMemory(const MemoryAllocation& allocation) { m_allocation = allocation; }
 
 private:
-    // points to device (GPU) memory allocated for buffer
-    HandleRef m_deviceMemory;
+    // range of a device (GPU) memory block shared with other buffers, see MemoryAllocator
+    MemoryAllocation m_allocation;
 };
 
 } // namespace R3
@@ -29,6 +29,13 @@ public:
     /// @brief Reset the signal of the fence
     void reset();
 
+    /// @brief Block until the fence is signalled
+    void wait() const;
+
+    /// @brief Query the signal without blocking
+    /// @return true if signalled
+    [[nodiscard]] bool signalled() const;
+
 private:
     Ref<const LogicalDevice> m_logicalDevice;
 };
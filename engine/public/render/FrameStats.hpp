@@ -0,0 +1,18 @@
+#pragma once
+
+/// @brief Counters the Renderer gathers while recording a frame, displayed by the Editor
+
+#include "api/Types.hpp"
+#include "render/RenderSpecification.hpp"
+
+namespace R3 {
+
+/// @brief Frame Statistics
+struct R3_API FrameStats {
+    uint32 draws = 0;               ///< draw calls recorded
+    uint64 triangles = 0;           ///< triangles submitted
+    uint32 lodDraws[MAX_LODS] = {}; ///< draw calls per level of detail
+    uint32 pipelineBinds = 0;       ///< pipelines bound, consecutive draws of a shared pipeline bind it once
+};
+
+} // namespace R3
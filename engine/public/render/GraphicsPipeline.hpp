@@ -2,6 +2,7 @@
 
 /// GraphicsPipeline Describes the all stages of the Render Pipeline
 
+#include <memory>
 #include "render/PipelineLayout.hpp"
 #include "render/RenderApi.hpp"
 #include "render/Shader.hpp"
@@ -15,11 +16,14 @@ struct R3_API GraphicsPipelineSpecification {
     const Swapchain& swapchain;
     const RenderPass& renderPass;
     const DescriptorSetLayout& descriptorSetLayout;
+    const PipelineLayout& pipelineLayout; ///< Created from descriptorSetLayout, outlives the pipeline
     const VertexBindingSpecification& vertexBindingSpecification;
     std::span<const VertexAttributeSpecification> vertexAttributeSpecification;
     std::string_view vertexShaderPath;
     std::string_view fragmentShaderPath;
-    bool msaa; ///< Multisample enable
+    bool msaa;                                    ///< Multisample enable
+    const PipelineCache* pipelineCache = nullptr; ///< Native cache the pipeline is compiled through, optional
+    ShaderLibrary* shaderLibrary = nullptr;       ///< Library sharing the shader modules, optional
 };
 
 /// @brief GraphicsPipeline created Pipeline from DescriptorLayout and genrates Shader Modules
@@ -39,13 +43,13 @@ public:
 
     /// @brief Query PipelineLayout
     /// @return Layout
-    [[nodiscard]] constexpr const PipelineLayout& layout() const { return m_layout; }
+    [[nodiscard]] constexpr const PipelineLayout& layout() const { return *m_layout; }
 
 private:
     Ref<const LogicalDevice> m_logicalDevice;
-    PipelineLayout m_layout;
-    Shader m_vertexShader;
-    Shader m_fragmentShader;
+    Ref<const PipelineLayout> m_layout;
+    std::shared_ptr<const Shader> m_vertexShader;
+    std::shared_ptr<const Shader> m_fragmentShader;
 };
 
 } // namespace R3
@@ -1,7 +1,8 @@
 #pragma once
 
-/// @brief Encompasses all Image operations like allocateion, copy, transition etc
+/// @brief Encompasses Image acquisition and allocation, copies and transitions are recorded by UploadContext
 
+#include "render/MemoryAllocator.hpp"
 #include "render/RenderApi.hpp"
 
 namespace R3 {
@@ -26,44 +27,6 @@ struct R3_API ImageAllocateSpecification {
     MemoryProperty::Flags memoryFlags;    ///< Memory flags
 };
 
-/// @brief Image Copy Specification
-struct R3_API ImageCopySpecification {
-    const LogicalDevice& logicalDevice; ///< LogicalDevice
-    const CommandBuffer& commandBuffer; ///< CommandBuffer
-    NativeRenderObject& dst;            ///< NativeRenderObject
-    const NativeRenderObject& src;      ///< NativeRenderObject
-    usize size;                         ///< Image size in bytes
-    uint32 width;                       ///< Image width
-    uint32 height;                      ///< Image height
-    ImageCopyType copyType;             ///< Image copy details
-};
-
-/// @brief Image Layout Transition Specification
-/// Transition the Image Layout, this is recorded by the CommandBuffer and performed in the Pipeline Stages
-/// The CommandBuffer will perform a blocking one-time submit on copy
-struct R3_API ImageLayoutTransitionSpecification {
-    const CommandBuffer& commandBuffer; ///< CommandBuffer
-    Image& image;                       ///< Mutable Image
-    MemoryAccessor::Flags srcAccessor;  ///< Source Accessor
-    MemoryAccessor::Flags dstAccessor;  ///< Destination Accessor
-    ImageLayout oldLayout;              ///< Old ImageLayout
-    ImageLayout newLayout;              ///< New ImageLayout
-    ImageAspect::Flags aspectMask;      ///< Aspect
-    uint32 mipLevels = 1;               ///< Mipmap levels
-    uint32 baseMipLevel = 0;            ///< Base mipmap level (default=0)
-    PipelineStage::Flags srcStageMask;  ///< Source Stage Mask
-    PipelineStage::Flags dstStageMask;  ///< Destination Stage Mask
-};
-
-/// @brief Image Mipmap Specification
-struct R3_API ImageMipmapSpecification {
-    const CommandBuffer& commandBuffer; ///< CommandBuffer
-    Image& image;                       ///< Mutable Image
-    uint32 mipLevels;                   ///< Mipmap levels
-    int32 width;                        ///< Image width
-    int32 height;                       ///< Image height
-};
-
 /// @brief Image represents an allocated Image. Images can only be accessed with ImageViews
 class R3_API Image : public NativeRenderObject {
 public:
@@ -83,21 +46,9 @@ public:
 
     /// @brief Allocate a Image with given flags
     /// @param spec
-    /// @return tuple<Image::Handle, DeviceMemory::Handle>
+    /// @return tuple<Image::Handle, memory range from LogicalDevice::memoryAllocator>
     [[nodiscard]] static auto allocate(const ImageAllocateSpecification& spec)
-        -> std::tuple<NativeRenderObject, NativeRenderObject>;
-
-    /// @brief Copy Image from dst to src using given spec
-    /// @param spec
-    static void copy(const ImageCopySpecification& spec);
-
-    /// @brief Transition ImageLayout from spec
-    /// @param spec
-    static void transition(const ImageLayoutTransitionSpecification& spec);
-
-    /// @brief Generate Mipmaps with CommandBuffer blitting
-    /// @param spec
-    static void generateMipMaps(const ImageMipmapSpecification& spec);
+        -> std::tuple<NativeRenderObject, MemoryAllocation>;
 };
 
 } // namespace R3
\ No newline at end of file
@@ -13,7 +13,7 @@ template <std::integral T>
 struct R3_API IndexBufferSpecification {
     const PhysicalDevice& physicalDevice; ///< PhysicalDevice
     const LogicalDevice& logicalDevice;   ///< LogicalDevice
-    const CommandBuffer& commandBuffer;   ///< CommandPool
+    UploadContext& uploadContext;         ///< Records the copy, see UploadContext::wait
     std::span<const T> indices;           ///< Array of indices
 };
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include "render/MemoryAllocator.hpp"
 #include "render/Queue.hpp"
 #include "render/RenderApi.hpp"
 
@@ -26,7 +28,7 @@ public:
     /// @param spec
     LogicalDevice(const LogicalDeviceSpecification& spec);
 
-    /// @brief Free LogicalDevice and Queues
+    /// @brief Free LogicalDevice, Queues and every block of the MemoryAllocator
     ~LogicalDevice();
 
     /// @brief Get Graphics Queue
@@ -37,9 +39,22 @@ public:
     /// @return Queue
     [[nodiscard]] constexpr const Queue& presentationQueue() const { return m_presentationQueue; }
 
+    /// @brief Get Transfer Queue, the Graphics Queue itself when the GPU has no dedicated transfer family
+    /// @return Queue
+    [[nodiscard]] constexpr const Queue& transferQueue() const { return m_transferQueue; }
+
+    /// @brief Wait until every queue is idle, locking each queue first since other threads submit to them
+    void waitIdle() const;
+
+    /// @brief Get the allocator every Buffer and Image memory comes from, thread safe
+    /// @return MemoryAllocator
+    [[nodiscard]] MemoryAllocator& memoryAllocator() const { return *m_memoryAllocator; }
+
 private:
     Queue m_graphicsQueue;
     Queue m_presentationQueue;
+    Queue m_transferQueue;
+    std::unique_ptr<MemoryAllocator> m_memoryAllocator;
 };
 
 } // namespace R3
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+/// @brief Sub-allocates GPU memory, so resources share a few large DeviceMemory blocks
+
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "render/RenderApi.hpp"
+
+namespace R3 {
+
+/// @brief Memory Allocator Specification
+struct R3_API MemoryAllocatorSpecification {
+    const PhysicalDevice& physicalDevice; ///< PhysicalDevice
+    const LogicalDevice& logicalDevice;   ///< LogicalDevice
+    usize blockSize = 64 * 1024 * 1024;   ///< Bytes of a block, a power of two, clamped to an eighth of small heaps
+};
+
+/// @brief Memory Allocate Specification
+struct R3_API MemoryAllocateSpecification {
+    usize size;        ///< Bytes required by the resource
+    usize alignment;   ///< Offset alignment required by the resource, a power of two
+    uint32 memoryType; ///< Memory type index, see PhysicalDevice::queryMemoryType
+    bool image;        ///< Optimal tiling Image, placed in other blocks than buffers (bufferImageGranularity)
+};
+
+/// @brief Range of DeviceMemory a resource is bound to
+struct R3_API MemoryAllocation {
+    NativeRenderObject::Handle memory = nullptr; ///< DeviceMemory block
+    usize offset = 0;                            ///< Byte offset of the resource in memory
+    usize size = 0;                              ///< Bytes reserved, at least the requested size
+    std::byte* mapped = nullptr;                 ///< Host address of offset, null unless memory is HostVisible
+    uint32 pool = 0;                             ///< @private
+    bool dedicated = false;                      ///< memory holds only this resource
+};
+
+/// @brief Usage of a memory heap, displayed by the Editor
+struct R3_API MemoryHeapStats {
+    usize size = 0;           ///< Heap size in bytes
+    bool deviceLocal = false; ///< Heap is GPU memory
+    usize reserved = 0;       ///< Bytes of every DeviceMemory allocated from the heap
+    usize used = 0;           ///< Bytes handed out to resources
+    usize largestFree = 0;    ///< Largest range a resource can be placed in without allocating a block
+    uint32 blocks = 0;        ///< DeviceMemory allocations, shared blocks and dedicated ones
+    uint32 allocations = 0;   ///< Resources bound to the heap
+};
+
+/// @brief Usage of every memory heap
+struct R3_API MemoryStats {
+    std::vector<MemoryHeapStats> heaps; ///< Indexed like the GPU heaps
+    uint32 deviceAllocations = 0;       ///< Live DeviceMemory allocations
+    uint32 maxDeviceAllocations = 0;    ///< Driver limit of deviceAllocations
+};
+
+/// @brief Device memory allocator, owned by the LogicalDevice
+/// Every memory type has a pool of buffer blocks and a pool of image blocks, each block is split by a buddy allocator
+/// into power of two ranges. Resources larger than half a block get a dedicated DeviceMemory. HostVisible blocks are
+/// mapped once for their lifetime, thread safe
+class R3_API MemoryAllocator {
+public:
+    NO_COPY(MemoryAllocator);
+    NO_MOVE(MemoryAllocator);
+
+    /// @brief Construct MemoryAllocator from spec, no memory is allocated until the first resource is
+    /// @param spec
+    MemoryAllocator(const MemoryAllocatorSpecification& spec);
+
+    /// @brief Free every block, every allocation must have been freed
+    ~MemoryAllocator();
+
+    /// @brief Reserve memory for a resource
+    /// @param spec
+    /// @return allocation, bind the resource at its memory and offset
+    [[nodiscard]] MemoryAllocation allocate(const MemoryAllocateSpecification& spec);
+
+    /// @brief Return memory once the resource bound to it was destroyed
+    /// @param allocation
+    void free(const MemoryAllocation& allocation);
+
+    /// @brief Query usage of every heap
+    /// @return stats
+    [[nodiscard]] MemoryStats stats() const;
+
+private:
+    static constexpr usize MIN_SIZE = 256; // smallest range, allocations are rounded up to a power of two above it
+
+    struct Block {
+        NativeRenderObject::Handle memory = nullptr;
+        std::byte* mapped = nullptr;
+        usize used = 0;
+        uint32 allocations = 0;
+        std::vector<std::vector<usize>> free; // free offsets by order, a range of order n is MIN_SIZE << n bytes
+    };
+
+    struct Pool {
+        uint32 memoryType = 0;
+        uint32 heap = 0;
+        bool hostVisible = false;
+        usize blockSize = 0;
+        std::vector<Block> blocks;
+        uint32 dedicated = 0;
+        usize dedicatedBytes = 0;
+    };
+
+    [[nodiscard]] std::tuple<NativeRenderObject::Handle, std::byte*> allocateMemory(const Pool& pool, usize size);
+
+    void freeMemory(NativeRenderObject::Handle memory);
+
+    [[nodiscard]] static bool take(Block& block, uint32 order, usize& offset);
+
+    static void give(Block& block, uint32 order, usize offset);
+
+private:
+    NativeRenderObject::Handle m_device = nullptr;
+    std::vector<MemoryHeapStats> m_heaps; // size and deviceLocal only
+    uint32 m_maxDeviceAllocations = 0;
+
+    mutable std::mutex m_mutex;
+    std::vector<Pool> m_pools; // memory type * 2 + image
+    uint32 m_deviceAllocations = 0;
+};
+
+} // namespace R3
@@ -39,6 +39,11 @@ public:
     /// @return Number of Samples
     [[nodiscard]] constexpr uint8 sampleCount() const { return m_sampleCount; }
 
+    /// @brief Query if optimally tiled images of format can be sampled, block compressed formats are optional
+    /// @param format
+    /// @return true if textures of format can be created
+    [[nodiscard]] bool sampledFormat(Format format) const;
+
 private:
     // ranks GPU based on several factor to determine best fit
     [[nodiscard]] int32 evaluateDevice(const NativeRenderObject& deviceHandle) const;
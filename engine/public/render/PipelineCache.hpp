@@ -0,0 +1,58 @@
+#pragma once
+
+/// @brief Shares GraphicsPipelines of identical state and keeps the driver's compiled pipelines across runs
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "render/GraphicsPipeline.hpp"
+#include "render/RenderApi.hpp"
+
+namespace R3 {
+
+/// @brief Pipeline Cache Specification
+struct R3_API PipelineCacheSpecification {
+    const PhysicalDevice& physicalDevice;          ///< PhysicalDevice
+    const LogicalDevice& logicalDevice;            ///< LogicalDevice
+    ShaderLibrary& shaderLibrary;                  ///< Library the shader modules of every pipeline come from
+    std::filesystem::path path = "pipeline.cache"; ///< Driver cache loaded at startup and saved on destruction
+};
+
+/// @brief Registry of GraphicsPipelines keyed by a hash of their whole state, backed by a native pipeline cache
+/// Like the TextureCache it only holds weak references, a pipeline is destroyed with the last mesh using it
+class R3_API PipelineCache : public NativeRenderObject {
+public:
+    NO_COPY(PipelineCache);
+    NO_MOVE(PipelineCache);
+
+    /// @brief Create the native cache, seeded from spec.path when it was written by the same GPU and driver
+    /// @param spec
+    PipelineCache(const PipelineCacheSpecification& spec);
+
+    /// @brief Save and destroy the native cache
+    ~PipelineCache();
+
+    /// @brief Key of a pipeline, equal for specifications creating identical pipelines
+    /// @param spec
+    /// @return key
+    [[nodiscard]] static uint64 key(const GraphicsPipelineSpecification& spec);
+
+    /// @brief Get the pipeline created with an identical spec, or create it, thread safe
+    /// @param spec
+    /// @return pipeline shared with every other holder of key(spec)
+    [[nodiscard]] std::shared_ptr<const GraphicsPipeline> acquire(const GraphicsPipelineSpecification& spec);
+
+    /// @brief Write the native cache to the path it was loaded from
+    void save() const;
+
+private:
+    Ref<const LogicalDevice> m_logicalDevice;
+    Ref<ShaderLibrary> m_shaderLibrary;
+    std::filesystem::path m_path;
+
+    std::mutex m_mutex; // held while creating, pipelines are few once shared
+    std::unordered_map<uint64, std::weak_ptr<const GraphicsPipeline>> m_pipelines;
+};
+
+} // namespace R3
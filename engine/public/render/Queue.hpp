@@ -11,6 +11,7 @@ enum class R3_API QueueType {
     Graphics,     ///< Graphics Queue
     Presentation, ///< Presentation Queue
     Compute,      ///< Compute Queue
+    Transfer,     ///< Transfer Queue, only copies
 };
 
 /// @brief Queue Family Indice wrapper for the querying of queue indices
@@ -21,6 +22,7 @@ private:
 public:
     int32 graphics = -1;     ///< graphics queue index
     int32 presentation = -1; ///< presentation queue index
+    int32 transfer = -1;     ///< dedicated transfer queue index, -1 if there is no transfer only family
 
     /// @brief Query whether all queue indices are valid
     /// @return valid/invalid
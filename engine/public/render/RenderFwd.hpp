@@ -15,11 +15,14 @@ class R3_API Image;
 class R3_API ImageView;
 class R3_API RenderPass;
 class R3_API DescriptorPool;
+class R3_API DescriptorAllocator;
 class R3_API DescriptorSetLayout;
 class R3_API DescriptorSet;
 class R3_API PipelineLayout;
 class R3_API GraphicsPipeline;
+class R3_API PipelineCache;
 class R3_API Shader;
+class R3_API ShaderLibrary;
 class R3_API Framebuffer;
 class R3_API CommandPool;
 class R3_API CommandBuffer;
@@ -39,5 +42,8 @@ class R3_API TextureBuffer;
 class R3_API Sampler;
 class R3_API ColorBuffer;
 class R3_API DepthBuffer;
+class R3_API UploadContext;
+class R3_API StagingRing;
+class R3_API MemoryAllocator;
 
 } // namespace R3
\ No newline at end of file
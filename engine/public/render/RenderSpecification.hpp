@@ -9,6 +9,7 @@ namespace R3 {
 
 static constexpr auto PBR_TEXTURE_COUNT = 5;    ///< Number of Textures used for PBR Renderering
 static constexpr auto MAX_FRAMES_IN_FLIGHT = 3; ///< Maximum frames in queue at one time
+static constexpr auto MAX_LODS = 8;             ///< Maximum levels of detail of a Mesh, including the full mesh
 
 /// @brief Flags for Image Usage
 struct R3_API ImageUsage : public Flag {
@@ -192,6 +193,25 @@ enum class R3_API Format {
     X8D24UnormPack32 = 125,
     D32Sfloat = 126,
     S8Uint = 127,
+    D16UnormS8Uint = 128,
+    D24UnormS8Uint = 129,
+    D32SfloatS8Uint = 130,
+    BC1RgbUnormBlock = 131,
+    BC1RgbSrgbBlock = 132,
+    BC1RgbaUnormBlock = 133,
+    BC1RgbaSrgbBlock = 134,
+    BC2UnormBlock = 135,
+    BC2SrgbBlock = 136,
+    BC3UnormBlock = 137,
+    BC3SrgbBlock = 138,
+    BC4UnormBlock = 139,
+    BC4SnormBlock = 140,
+    BC5UnormBlock = 141,
+    BC5SnormBlock = 142,
+    BC6HUfloatBlock = 143,
+    BC6HSfloatBlock = 144,
+    BC7UnormBlock = 145,
+    BC7SrgbBlock = 146,
 };
 
 /// @brief Presentation Modes
@@ -12,29 +12,37 @@
 /// - Create Render CommandPool and Local CommandPool
 /// - Build Synchronization Resources
 
+#include "core/ThreadPool.hpp"
 #include "editor/Editor.hpp"
 #include "render/ColorBuffer.hpp"
 #include "render/CommandPool.hpp"
 #include "render/DepthBuffer.hpp"
+#include "render/DescriptorAllocator.hpp"
 #include "render/Fence.hpp"
+#include "render/FrameStats.hpp"
 #include "render/Framebuffer.hpp"
 #include "render/Instance.hpp"
 #include "render/LogicalDevice.hpp"
 #include "render/PhysicalDevice.hpp"
+#include "render/PipelineCache.hpp"
 #include "render/RenderPass.hpp"
 #include "render/Semaphore.hpp"
+#include "render/ShaderLibrary.hpp"
 #include "render/ShaderObjects.hpp"
+#include "render/StagingRing.hpp"
 #include "render/StorageBuffer.hpp"
 #include "render/Surface.hpp"
 #include "render/Swapchain.hpp"
 #include "render/Window.hpp"
 #include "render/model/ModelLoader.hpp"
+#include "render/model/TextureCache.hpp"
 
 namespace R3 {
 
 /// @brief Renderer Specification
 struct R3_API RendererSpecification {
     Window& window;
+    ThreadPool& threadPool; ///< used by the ModelLoader to read and decode textures
 };
 
 /// @brief Main R3 Renderer
@@ -80,7 +88,11 @@ public:
 
     /// @brief Get ModelLoader
     /// @return loader
-    [[nodiscard]] constexpr ModelLoader& modelLoader() { return m_modelLoader; }
+    [[nodiscard]] ModelLoader& modelLoader() { return *m_modelLoader; }
+
+    /// @brief Get TextureCache
+    /// @return cache of every texture the ModelLoader uploaded
+    [[nodiscard]] constexpr TextureCache& textureCache() { return m_textureCache; }
 
     /// @brief Wait idle for synchronization
     void waitIdle() const;
@@ -115,8 +127,14 @@ private:
     vec2 m_cursorPosition = vec2(0); // normalized
     StorageBuffer m_storageBuffer;
 
+    FrameStats m_frameStats; // gathered by render, displayed by the next renderEditorInterface
     editor::Editor m_editor;
-    ModelLoader m_modelLoader; // ModelLoader needs to know certain info about renderer so it's a member
+    TextureCache m_textureCache;                                // only weak references, owned by the models using them
+    std::unique_ptr<StagingRing> m_stagingRing;                 // staging memory of every upload, outlives the loader
+    std::unique_ptr<DescriptorAllocator> m_descriptorAllocator; // layouts outlive every pipeline using them
+    std::unique_ptr<ShaderLibrary> m_shaderLibrary;             // only weak references, modules owned by pipelines
+    std::unique_ptr<PipelineCache> m_pipelineCache;             // only weak references, saved to disk on shutdown
+    std::unique_ptr<ModelLoader> m_modelLoader;                 // joins its threads before the device is destroyed
 };
 
 } // namespace R3
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <string_view>
 #include "render/RenderApi.hpp"
 
@@ -16,8 +17,9 @@ enum class R3_API ShaderType {
 
 /// @brief Shader Specification
 struct R3_API ShaderSpecification {
-    const LogicalDevice& logicalDevice; ///< LogicalDevice
-    std::string_view path;              ///< Filepath to spirv shader
+    const LogicalDevice& logicalDevice;   ///< LogicalDevice
+    std::string_view path;                ///< Filepath to spirv shader
+    std::span<const std::byte> code = {}; ///< Spirv already in memory, 4 byte aligned, path is read when empty
 };
 
 /// @brief Shader is a native shader module constructed from spirv
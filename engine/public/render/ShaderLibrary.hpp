@@ -0,0 +1,61 @@
+#pragma once
+
+/// @brief Shares Shader modules between pipelines and reads compiled shaders from one mapped bundle
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include "render/RenderApi.hpp"
+#include "render/Shader.hpp"
+
+namespace R3 {
+
+class MappedFile;
+
+/// @brief Shader Library Specification
+struct R3_API ShaderLibrarySpecification {
+    const LogicalDevice& logicalDevice;           ///< LogicalDevice
+    std::filesystem::path bundle = "spirv.bundle"; ///< Bundle packed by compile_shaders.py, optional
+};
+
+/// @brief Registry of Shader modules keyed by path and content hash
+/// Shaders come from the bundle when it holds the path, otherwise from the loose .spv file. Like the PipelineCache
+/// it only holds weak references, a module is destroyed with the last pipeline using it
+class R3_API ShaderLibrary {
+public:
+    NO_COPY(ShaderLibrary);
+    NO_MOVE(ShaderLibrary);
+
+    /// @brief Map spec.bundle and read its index, a missing bundle leaves every shader to the loose files
+    /// @param spec
+    ShaderLibrary(const ShaderLibrarySpecification& spec);
+
+    /// @brief Unmap the bundle, modules still in use are unaffected
+    ~ShaderLibrary();
+
+    /// @brief Get the module of the shader at path, or create it, thread safe
+    /// @param path spirv path relative to the working directory, e.g. "spirv/pbr.frag.spv"
+    /// @return module shared with every other holder of the same path and content
+    [[nodiscard]] std::shared_ptr<const Shader> acquire(std::string_view path);
+
+private:
+    struct Entry {
+        std::span<const std::byte> code; // within the bundle mapping
+        uint64 hash;                     // FNV-1a of code, computed by compile_shaders.py
+    };
+
+    void readIndex();
+
+private:
+    Ref<const LogicalDevice> m_logicalDevice;
+    std::unique_ptr<MappedFile> m_bundle;
+    std::unordered_map<std::string_view, Entry> m_entries; // names point into the bundle mapping
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64, std::weak_ptr<const Shader>> m_shaders; // hash of path mixed with content hash
+};
+
+} // namespace R3
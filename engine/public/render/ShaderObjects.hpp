@@ -118,6 +118,106 @@ struct R3_API Vertex {
     }
 };
 
+/// @brief Vertex layouts a Mesh can be uploaded with, chosen per mesh by ModelLoader
+enum class R3_API VertexLayout : uint8 {
+    Full,          ///< Vertex, unpacked fallback
+    PackedStatic,  ///< PackedStaticVertex, meshes without skin
+    PackedSkinned, ///< PackedSkinnedVertex, skinned meshes with fewer than 256 joints
+};
+
+/// @brief Packed Vertex of static meshes, 16 bytes
+/// Positions are unorm16 within the bounding cube of the mesh, Mesh::dequantize maps them back to model space
+/// The normal is octahedral encoded. No tangent is stored, pbr.frag derives the tangent frame from derivatives
+struct R3_API PackedStaticVertex {
+    uint16 position[4];   ///< unorm16 position within the mesh bounds, w unused
+    uint32 normal;        ///< octahedral snorm16x2 normal
+    uint32 textureCoords; ///< half float texture coordinates, UVs may tile outside [0, 1]
+
+    [[nodiscard]] static constexpr VertexBindingSpecification vertexBindingSpecification() {
+        return {
+            .binding = 0,
+            .stride = sizeof(PackedStaticVertex),
+            .inputRate = VertexInputRate::Vertex,
+        };
+    }
+
+    [[nodiscard]] static constexpr std::array<VertexAttributeSpecification, 3> vertexAttributeSpecification() {
+        return {
+            VertexAttributeSpecification{
+                .location = 0,
+                .binding = 0,
+                .format = Format::R16G16B16A16Unorm,
+                .offset = offsetof(PackedStaticVertex, position),
+            },
+            VertexAttributeSpecification{
+                .location = 1,
+                .binding = 0,
+                .format = Format::R16G16Snorm,
+                .offset = offsetof(PackedStaticVertex, normal),
+            },
+            VertexAttributeSpecification{
+                .location = 4,
+                .binding = 0,
+                .format = Format::R16G16Sfloat,
+                .offset = offsetof(PackedStaticVertex, textureCoords),
+            },
+        };
+    }
+};
+
+/// @brief Packed Vertex of skinned meshes, 28 bytes
+/// Positions stay float since skinning happens before the model matrix, see PackedStaticVertex for the rest
+struct R3_API PackedSkinnedVertex {
+    vec3 position;        ///< vertex position data
+    uint32 normal;        ///< octahedral snorm16x2 normal
+    uint32 textureCoords; ///< half float texture coordinates
+    uint8 boneIDs[4];     ///< joint indices, 255 when unused
+    uint8 weights[4];     ///< unorm8 joint weights, summing to 255
+
+    [[nodiscard]] static constexpr VertexBindingSpecification vertexBindingSpecification() {
+        return {
+            .binding = 0,
+            .stride = sizeof(PackedSkinnedVertex),
+            .inputRate = VertexInputRate::Vertex,
+        };
+    }
+
+    [[nodiscard]] static constexpr std::array<VertexAttributeSpecification, 5> vertexAttributeSpecification() {
+        return {
+            VertexAttributeSpecification{
+                .location = 0,
+                .binding = 0,
+                .format = Format::R32G32B32Sfloat,
+                .offset = offsetof(PackedSkinnedVertex, position),
+            },
+            VertexAttributeSpecification{
+                .location = 1,
+                .binding = 0,
+                .format = Format::R16G16Snorm,
+                .offset = offsetof(PackedSkinnedVertex, normal),
+            },
+            VertexAttributeSpecification{
+                .location = 4,
+                .binding = 0,
+                .format = Format::R16G16Sfloat,
+                .offset = offsetof(PackedSkinnedVertex, textureCoords),
+            },
+            VertexAttributeSpecification{
+                .location = 5,
+                .binding = 0,
+                .format = Format::R8G8B8A8Uint,
+                .offset = offsetof(PackedSkinnedVertex, boneIDs),
+            },
+            VertexAttributeSpecification{
+                .location = 6,
+                .binding = 0,
+                .format = Format::R8G8B8A8Unorm,
+                .offset = offsetof(PackedSkinnedVertex, weights),
+            },
+        };
+    }
+};
+
 #if not R3_BUILD_DIST
 /// @brief Vertex used for Object Picking
 struct R3_API ObjectPickerVertex {
@@ -0,0 +1,81 @@
+#pragma once
+
+/// @brief Persistently mapped host memory that every UploadContext stages its copies in
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include "render/Buffer.hpp"
+#include "render/RenderApi.hpp"
+
+namespace R3 {
+
+/// @brief Staging Ring Specification
+struct R3_API StagingRingSpecification {
+    const PhysicalDevice& physicalDevice; ///< PhysicalDevice
+    const LogicalDevice& logicalDevice;   ///< LogicalDevice
+    usize size = 64 * 1024 * 1024;        ///< Ring size in bytes
+    usize chunkSize = 8 * 1024 * 1024;    ///< Largest region, bigger uploads are split into chunks
+};
+
+/// @brief Part of the StagingRing, valid until released
+struct R3_API StagingRegion {
+    usize offset = 0;          ///< Byte offset in the StagingRing buffer
+    usize size = 0;            ///< Region size in bytes
+    std::byte* data = nullptr; ///< Mapped memory at offset
+};
+
+/// @brief Host visible TransferSrc buffer mapped once and handed out in regions, oldest first
+/// A region is reused once it and every region allocated before it were released, thread safe
+class R3_API StagingRing : public Buffer {
+public:
+    NO_COPY(StagingRing);
+    NO_MOVE(StagingRing);
+
+    /// @brief Allocate and map StagingRing from spec
+    /// @param spec
+    StagingRing(const StagingRingSpecification& spec);
+
+    /// @brief Free StagingRing, every region must have been released
+    ~StagingRing();
+
+    /// @brief Allocate a region if there is room
+    /// @param size bytes, at most chunkSize()
+    /// @return region, nullopt if the ring is full
+    [[nodiscard]] std::optional<StagingRegion> tryAllocate(usize size);
+
+    /// @brief Allocate a region, waiting for others to be released
+    /// @param size bytes, at most chunkSize()
+    /// @return region
+    [[nodiscard]] StagingRegion allocate(usize size);
+
+    /// @brief Return a region once the copies reading it completed
+    /// @param region
+    void release(const StagingRegion& region);
+
+    /// @brief Query the largest region
+    /// @return bytes
+    [[nodiscard]] constexpr usize chunkSize() const { return m_chunkSize; }
+
+private:
+    struct Live {
+        usize offset;
+        usize size;
+        bool released;
+    };
+
+    [[nodiscard]] std::optional<usize> fit(usize size) const;
+
+private:
+    Ref<const LogicalDevice> m_logicalDevice;
+    std::byte* m_mappedMemory = nullptr;
+    usize m_size = 0;
+    usize m_chunkSize = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+    std::deque<Live> m_live; // regions in allocation order, the front one is the oldest
+};
+
+} // namespace R3
@@ -17,17 +17,17 @@ enum class R3_API TextureType : uint8 {
 };
 
 /// @brief Texture Buffer Specification
-/// Only ONE of (data|raw|path) can present, rest must be null
+/// Decoding happens before, in the TexturePipeline, raw holds the decoded or KTX2 stored levels, see Ktx2.hxx
 struct R3_API TextureBufferSpecification {
     const PhysicalDevice& physicalDevice; ///< PhysicalDevice
     const LogicalDevice& logicalDevice;   ///< LogicalDevice
-    const CommandBuffer& commandBuffer;   ///< CommandBuffer
-    uint32 width;                         ///< Texture width (ignored if path is null)
-    uint32 height;                        ///< Texture height (ignored if path is null)
-    const std::byte* data;                ///< Texture compressed data (exclusive)
-    const std::byte* raw;                 ///< Texture raw data (exclusive)
-    const char* path;                     ///< Texture filepath (exclusive)
+    UploadContext& uploadContext;         ///< Records the copy, see UploadContext::wait
+    uint32 width;                         ///< Texture width
+    uint32 height;                        ///< Texture height
+    const std::byte* raw;                 ///< Texture raw data
     TextureType type;                     ///< TextureType
+    Format format = Format::R8G8B8A8Srgb; ///< Format of raw data
+    uint32 mipLevels = 1;                 ///< Levels stored back to back in raw data, a single level generates the rest
 };
 
 /// @brief TextureBuffer allocated from texture data
@@ -47,6 +47,8 @@ public:
     [[nodiscard]] constexpr const ImageView& textureView() const { return m_imageView; } ///< Query Texture ImageView
     [[nodiscard]] constexpr const Sampler& sampler() const { return m_sampler; }         ///< Query Texture Sampler
     [[nodiscard]] constexpr TextureType type() const { return m_type; }                  ///< Query type
+    [[nodiscard]] constexpr Format format() const { return m_format; }                   ///< Query format
+    [[nodiscard]] constexpr usize size() const { return m_size; }                        ///< Query bytes of all levels
     void setType(TextureType type) { m_type = type; }                                    ///< Type setter
 
 private:
@@ -54,6 +56,8 @@ private:
     ImageView m_imageView;
     Sampler m_sampler;
     TextureType m_type = TextureType::Nil;
+    Format m_format = Format::Undefined;
+    usize m_size = 0;
 };
 
 struct R3_API TexturePBR {
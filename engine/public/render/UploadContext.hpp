@@ -0,0 +1,90 @@
+#pragma once
+
+/// Records the CPU -> GPU copies of many resources and submits them at once to the transfer Queue
+
+#include <span>
+#include <vector>
+#include "render/CommandPool.hpp"
+#include "render/Fence.hpp"
+#include "render/Image.hpp"
+#include "render/StagingRing.hpp"
+
+namespace R3 {
+
+/// @brief Upload Context Specification
+struct R3_API UploadContextSpecification {
+    const LogicalDevice& logicalDevice; ///< LogicalDevice
+    const Swapchain& swapchain;         ///< Swapchain
+    StagingRing& stagingRing;           ///< Staging memory shared with every other UploadContext
+};
+
+/// @brief Batches uploads into one CommandBuffer submitted to LogicalDevice::transferQueue
+/// Each submission signals a Fence, the resources recorded into it may be used once wait() returned for its ticket
+/// Copies larger than StagingRing::chunkSize are split, the batch is submitted early when the ring is full
+/// Like a CommandPool, an UploadContext can only be used by one thread at a time
+class R3_API UploadContext {
+public:
+    NO_COPY(UploadContext);
+    NO_MOVE(UploadContext);
+
+    /// @brief Construct UploadContext from spec
+    /// @param spec
+    UploadContext(const UploadContextSpecification& spec);
+
+    /// @brief Submit what is still recorded, wait for every submission and release the staging memory
+    ~UploadContext();
+
+    /// @brief Stage bytes and record their copy to the start of buffer
+    /// @param buffer Buffer created with BufferUsage::TransferDst
+    /// @param bytes
+    void copy(const NativeRenderObject& buffer, std::span<const std::byte> bytes);
+
+    /// @brief Stage every level and record their copy into image, which is left in ShaderReadOnlyOptimal
+    /// @param image Image created with ImageUsage::TransferDst and levels.size() mip levels, in Undefined layout
+    /// @param format of image, levels too large for a chunk are split along block rows
+    /// @param width of the largest level
+    /// @param height of the largest level
+    /// @param levels bytes of every level, largest first
+    void copy(const Image& image,
+              Format format,
+              uint32 width,
+              uint32 height,
+              std::span<const std::span<const std::byte>> levels);
+
+    /// @brief Submit everything recorded since the last submit
+    /// @return ticket of the submission, the previous ticket if nothing was recorded
+    uint64 submit();
+
+    /// @brief Block until the submission of ticket and every earlier one completed
+    /// @param ticket returned by submit(), 0 never waits
+    void wait(uint64 ticket);
+
+    /// @brief Submit and wait for everything recorded
+    void flush() { wait(submit()); }
+
+private:
+    static constexpr usize BATCHES = 2; // one is recorded while the other may still be copying
+
+    struct Batch {
+        Fence fence;
+        uint64 ticket = 0;                  // submission the fence belongs to, 0 if never submitted
+        std::vector<StagingRegion> staging; // released to the StagingRing once the fence signalled
+    };
+
+    [[nodiscard]] const CommandBuffer& record();
+
+    [[nodiscard]] StagingRegion stage(std::span<const std::byte> bytes);
+
+    void release(Batch& batch);
+
+private:
+    Ref<const LogicalDevice> m_logicalDevice;
+    Ref<StagingRing> m_stagingRing;
+    CommandPool m_commandPool; // one CommandBuffer per Batch
+    Batch m_batches[BATCHES];
+    usize m_current = 0;      // batch being recorded
+    bool m_recording = false; // m_current's CommandBuffer has begun
+    uint64 m_submitted = 0;   // last ticket
+};
+
+} // namespace R3
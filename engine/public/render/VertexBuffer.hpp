@@ -10,8 +10,9 @@ namespace R3 {
 struct R3_API VertexBufferSpecification {
     const PhysicalDevice& physicalDevice; ///< PhysicalDevice
     const LogicalDevice& logicalDevice;   ///< LogicalDevice
-    const CommandBuffer& commandBuffer;   ///< CommandBuffer
-    std::span<const Vertex> vertices;     ///< Vertice data buffer
+    UploadContext& uploadContext;         ///< Records the copy, see UploadContext::wait
+    std::span<const std::byte> vertices;  ///< Serialized vertices of any layout, see VertexLayout
+    uint32 stride;                        ///< Size of a single vertex
 };
 
 /// @brief VertexBuffer (VAO) holds serialized vertex data on Device
@@ -8,7 +8,7 @@ namespace R3 {
 struct Animation {
     float currentTime = 0.0f;
     float maxTime = 0.0f;
-    std::vector<KeyFrame> keyFrames;
+    std::span<const KeyFrame> keyFrames; ///< owned by the ModelResource of the model
     bool running = false;
 };
 
@@ -1,17 +1,14 @@
 #pragma once
 
 #include <R3>
-#include "render/DescriptorPool.hpp"
 #include "render/TextureBuffer.hpp"
-#include "render/UniformBuffer.hpp"
 
 namespace R3 {
 
+/// @brief Textures of a Mesh, unused slots hold the ModelLoader's nil texture
 struct R3_API Material {
-    DescriptorPool descriptorPool;
-    UniformBuffer uniforms[MAX_FRAMES_IN_FLIGHT * 2];
     TexturePBR textures;
-    uint32 pbrFlags = 0;
+    uint32 pbrFlags = 0; ///< TexturePBR flags of the slots holding a real texture
 };
 
-} // namespace R3
\ No newline at end of file
+} // namespace R3
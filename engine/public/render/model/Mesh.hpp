@@ -1,18 +1,40 @@
 #pragma once
 
 #include <R3>
+#include <memory>
+#include <variant>
+#include "render/DescriptorAllocator.hpp"
 #include "render/GraphicsPipeline.hpp"
 #include "render/IndexBuffer.hpp"
+#include "render/UniformBuffer.hpp"
 #include "render/VertexBuffer.hpp"
 #include "render/model/Material.hpp"
 
 namespace R3 {
 
+/// @brief Level of detail of a Mesh, every level indexes the same VertexBuffer
+struct R3_API MeshLod {
+    std::variant<IndexBuffer<uint16>, IndexBuffer<uint32>> indexBuffer; ///< 16 bit whenever every index fits
+    float error = 0.0f;                                                 ///< deviation from the full mesh, model units
+};
+
+/// @brief Geometry and material of a mesh primitive
+/// Immutable once loaded, shared by every ModelComponent loaded from the same file, see ModelResource
 struct R3_API Mesh {
     VertexBuffer vertexBuffer;
-    IndexBuffer<uint32> indexBuffer;
-    GraphicsPipeline pipeline;
+    VertexLayout vertexLayout = VertexLayout::Full;   ///< layout of vertexBuffer
+    mat4 dequantize = mat4(1.0f);                     ///< maps packed positions to model space
+    vec4 bounds = vec4(0.0f);                         ///< bounding sphere in model space, xyz center and w radius
+    std::vector<MeshLod> lods;                        ///< lods[0] is the full mesh, coarser after
+    std::shared_ptr<const GraphicsPipeline> pipeline; ///< shared with every mesh of identical state, see PipelineCache
     Material material;
 };
 
+/// @brief Draw state of a Mesh owned by a single entity
+struct R3_API MeshInstance {
+    DescriptorAllocation descriptorSets;              ///< per frame sets binding uniforms and the Mesh textures
+    UniformBuffer uniforms[MAX_FRAMES_IN_FLIGHT * 2]; ///< vertex uniforms per frame, then fragment uniforms
+    uint32 lod = 0;                                   ///< level drawn last frame
+};
+
 } // namespace R3
@@ -2,27 +2,19 @@
 
 /// Owned by Renderer and used to load in assets
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include "components/ModelComponent.hpp"
+#include "core/ThreadPool.hpp"
+#include "render/model/TextureCache.hpp"
 
 namespace R3 {
 
-namespace glTF {
-struct Node;                 ///< @private
-struct Mesh;                 ///< @private
-struct Material;             ///< @private
-struct TextureInfo;          ///< @private
-struct NormalTextureInfo;    ///< @private
-struct OcclusionTextureInfo; ///< @private
-struct Skin;                 ///< @private
-class Model;                 ///< @private
-} // namespace glTF
-
-struct MeshPrototype {
-    VertexBuffer vertexBuffer;
-    IndexBuffer<uint32> indexBuffer;
-    std::vector<usize> textureIndices;
-};
+struct ModelData;      ///< @private
+class TexturePipeline; ///< @private
 
 /// @brief Model Loader Specification
 struct ModelLoaderSpecification {
@@ -30,56 +22,87 @@ struct ModelLoaderSpecification {
     const LogicalDevice& logicalDevice;
     const Swapchain& swapchain;
     const RenderPass& renderPass;
-    const CommandPool& commandPool;
-    const StorageBuffer& storageBuffer; ///< Storage Buffer used for mouse picking
+    const StorageBuffer& storageBuffer;       ///< Storage Buffer used for mouse picking
+    StagingRing& stagingRing;                 ///< Staging memory of every upload
+    PipelineCache& pipelineCache;             ///< Pipelines shared with every other loaded model
+    DescriptorAllocator& descriptorAllocator; ///< Descriptor sets of every instance and the layouts they share
+    TextureCache& textureCache;               ///< Textures shared with every other loaded model
+    ThreadPool& threadPool;                   ///< Reads and decodes textures and compressed glTF bufferViews
+    uint32 loaderThreads = 2;                 ///< Models loaded at once by loadAsync, each with its UploadContext
+};
+
+/// @brief Load started by ModelLoader::loadAsync, written by its loading thread and consumed on the main thread
+struct ModelLoad {
+    std::filesystem::path path;
+    std::atomic<bool> done = false;                ///< resource and error may be read once set
+    std::shared_ptr<const ModelResource> resource; ///< null if loading failed
+    std::string error;                             ///< reason loading failed
 };
 
-/// @brief ModelLoader used to load glTF Models
+/// @brief ModelLoader used to load glTF Models and baked .r3asset files
 /// Owned by renderer and will allocate all the object needed by a ModelComponent
 class ModelLoader {
 public:
-    DEFAULT_CONSTRUCT(ModelLoader);
     NO_COPY(ModelLoader);
-    DEFAULT_MOVE(ModelLoader);
+    NO_MOVE(ModelLoader);
 
     /// @brief Construct ModelLoader from spec
     /// @param spec
     ModelLoader(const ModelLoaderSpecification& spec);
 
-    /// @brief Load in a glTF Model from path
+    /// @brief Cancel the loads not started yet and wait for the others
+    ~ModelLoader();
+
+    /// @brief Load in a glTF Model or baked .r3asset from path, blocking until it is uploaded
+    /// A file still used by another ModelComponent is not loaded again, model shares its ModelResource
     /// @param path
     /// @param[out] model
     void load(const std::filesystem::path& path, ModelComponent& model);
 
+    /// @brief Queue loading a glTF Model or baked .r3asset on a loader thread and return at once
+    /// Up to loaderThreads files load concurrently, loads of the same file wait for a single upload
+    /// @param path
+    /// @return load to store in a ModelComponent, completed by update()
+    [[nodiscard]] std::shared_ptr<ModelLoad> loadAsync(const std::filesystem::path& path);
+
+    /// @brief Complete the pending ModelComponents of the current Scene whose load finished, main thread only
+    /// Every completed ModelComponent becomes Ready or Failed and pushes a ModelLoadedEvent
+    void update();
+
 private:
-    void processNode(glTF::Model& model, glTF::Node& node);
-    void processMesh(glTF::Model& model, glTF::Mesh& mesh);
-    void processAnimations(glTF::Model& model);
-    void processSkeleton(glTF::Model& model);
-    void processJoint(glTF::Model& model, usize rootIndex, usize parentJoint);
-    void processMaterial(glTF::Model& model, glTF::Material& material);
-    void processTexture(glTF::Model& model, uint8 color[4], TextureType type);
-    void processTexture(glTF::Model& model, glTF::TextureInfo& textureInfo, TextureType type);
-    void processTexture(glTF::Model& model, glTF::NormalTextureInfo& textureInfo, TextureType type);
-    void processTexture(glTF::Model& model, glTF::OcclusionTextureInfo& textureInfo, TextureType type);
-
-    void preProcessTextures(glTF::Model& model);
+    [[nodiscard]] std::shared_ptr<const ModelResource> acquire(const std::filesystem::path& path);
+
+    [[nodiscard]] std::shared_ptr<ModelResource> upload(ModelData& data) const;
+
+    void instantiate(std::shared_ptr<const ModelResource> resource, ModelComponent& model) const;
 
 private:
     Ref<const PhysicalDevice> m_physicalDevice;
     Ref<const LogicalDevice> m_logicalDevice;
     Ref<const Swapchain> m_swapchain;
     Ref<const RenderPass> m_renderPass;
-    Ref<const CommandPool> m_commandPool;
     Ref<const StorageBuffer> m_storageBuffer;
+    Ref<StagingRing> m_stagingRing;
+    Ref<PipelineCache> m_pipelineCache;
+    Ref<DescriptorAllocator> m_descriptorAllocator;
+    Ref<TextureCache> m_textureCache;
+    Ref<ThreadPool> m_threadPool;
 
-    std::vector<MeshPrototype> m_prototypes;
-    std::vector<KeyFrame> m_keyFrames;
-    Skeleton m_skeleton;
-
-    std::vector<std::shared_ptr<TextureBuffer>> m_textures;
     std::shared_ptr<TextureBuffer> m_nilTexture;
-    std::filesystem::path m_directory;
+    std::unique_ptr<TexturePipeline> m_texturePipeline;
+
+    struct Slot {
+        std::mutex mutex; // held while loading, so a file is loaded once
+        std::weak_ptr<const ModelResource> resource;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<Slot>> m_resources; // by canonical path
+    std::vector<std::shared_ptr<ModelLoad>> m_loads;                    // main thread only
+
+    // loads block on texture uploads, so they get their own small pool instead of the engine's
+    std::atomic<bool> m_stopping = false;
+    ThreadPool m_loaderPool; // last, its threads are joined before anything they use is destroyed
 };
 
 } // namespace R3
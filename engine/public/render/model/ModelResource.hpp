@@ -0,0 +1,23 @@
+#pragma once
+
+#include <R3>
+#include "render/model/KeyFrame.hpp"
+#include "render/model/Mesh.hpp"
+#include "render/model/Skeleton.hpp"
+
+namespace R3 {
+
+/// @brief Immutable data of a loaded model file, shared by every ModelComponent loaded from it
+/// The ModelLoader caches resources by path and frees one once the last ModelComponent using it is destroyed
+struct R3_API ModelResource {
+    DEFAULT_CONSTRUCT(ModelResource);
+    NO_COPY(ModelResource);
+    DEFAULT_MOVE(ModelResource);
+
+    std::vector<Mesh> meshes;
+    Skeleton skeleton;               ///< bind pose, every ModelComponent animates its own copy
+    std::vector<KeyFrame> keyFrames; ///< animation, every ModelComponent plays it at its own time
+    float duration = 0.0f;           ///< timestamp of the last key frame
+};
+
+} // namespace R3
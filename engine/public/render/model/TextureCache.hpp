@@ -0,0 +1,72 @@
+#pragma once
+
+/// Owned by Renderer and shared by every model the ModelLoader creates
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include "render/TextureBuffer.hpp"
+
+namespace R3 {
+
+/// @brief Texture Cache Statistics, displayed by the Editor
+struct R3_API TextureCacheStats {
+    uint64 hits = 0;         ///< acquires served by a resident texture
+    uint64 misses = 0;       ///< acquires that uploaded a texture
+    usize residentCount = 0; ///< textures still referenced by a model
+    usize residentBytes = 0; ///< GPU bytes of every resident level
+};
+
+/// @brief Content addressed cache of TextureBuffers
+/// Textures are keyed by canonical path or by a hash of their bytes and handed out as shared references. The cache
+/// only holds weak references, a texture is freed once the last model using it is destroyed
+class R3_API TextureCache {
+public:
+    DEFAULT_CONSTRUCT(TextureCache);
+    NO_COPY(TextureCache);
+    NO_MOVE(TextureCache);
+
+    /// @brief Key of an image file, the same file reached through different paths shares a key
+    /// @param path
+    /// @return key
+    [[nodiscard]] static uint64 key(const std::filesystem::path& path);
+
+    /// @brief Key of encoded or raw texture bytes
+    /// @param bytes
+    /// @param seed distinguishes equal bytes with a different meaning, e.g. raw pixels of another size or format
+    /// @return key
+    [[nodiscard]] static uint64 key(std::span<const std::byte> bytes, uint64 seed = 0);
+
+    /// @brief Get the resident texture of key, or upload it through create, thread safe
+    /// Concurrent acquires of the same key wait for a single upload
+    /// @param key see key()
+    /// @param create called only on a miss
+    /// @return texture shared with every other holder of key, its type() is the one it was first uploaded with
+    [[nodiscard]] std::shared_ptr<TextureBuffer> acquire(uint64 key, const std::function<TextureBuffer()>& create);
+
+    /// @brief Get the resident texture of key without uploading it, thread safe and never waits for an upload
+    /// @param key see key()
+    /// @return texture shared with every other holder of key, null if none is resident
+    [[nodiscard]] std::shared_ptr<TextureBuffer> find(uint64 key);
+
+    /// @brief Query statistics and forget textures that were freed
+    /// @return stats
+    [[nodiscard]] TextureCacheStats stats();
+
+private:
+    struct Slot {
+        std::mutex mutex; // held while uploading, so a key is uploaded once
+        std::weak_ptr<TextureBuffer> texture;
+        usize size = 0;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<uint64, std::shared_ptr<Slot>> m_slots;
+    uint64 m_hits = 0;
+    uint64 m_misses = 0;
+};
+
+} // namespace R3
@@ -2,6 +2,7 @@ import sys
 import os
 import json
 import hashlib
+import struct
 
 
 class Lock:
@@ -43,6 +44,62 @@ class Lock:
             exit(-1)
 
 
+def variants(shader: str) -> list:
+    """ defines listed on a `// variants: A B` line, every one is compiled to <shader>.<a>.spv """
+    with open(f"{shader}", mode="r") as file:
+        for line in file:
+            if line.startswith("// variants:"):
+                return line[len("// variants:"):].split()
+    return []
+
+
+def fnv1a(data: bytes) -> int:
+    """ 64 bit FNV-1a, the content hash ShaderLibrary keys modules with """
+    h = 0xcbf29ce484222325
+    for b in data:
+        h = ((h ^ b) * 0x100000001b3) & 0xffffffffffffffff
+    return h
+
+
+def bundle(out_dir: str):
+    """ pack every .spv of out_dir into <out_dir>.bundle, see ShaderLibrary for the layout """
+    out_dir = os.path.normpath(out_dir)
+    prefix = os.path.basename(out_dir)
+    shaders = sorted(name for name in os.listdir(out_dir) if name.endswith(".spv"))
+
+    names = [f"{prefix}/{name}".encode("utf-8") for name in shaders]
+    codes = []
+    for name in shaders:
+        with open(os.path.join(out_dir, name), mode="rb") as file:
+            codes.append(file.read())
+
+    # header, index, names, then the code of every shader aligned to 4 bytes
+    header = struct.pack("<4sIII", b"R3SB", 1, len(shaders), 0)
+    offset = len(header) + 24 * len(shaders)
+    name_offsets = []
+    for name in names:
+        name_offsets.append(offset)
+        offset += len(name)
+    code_offsets = []
+    for code in codes:
+        offset = (offset + 3) & ~3
+        code_offsets.append(offset)
+        offset += len(code)
+
+    data = bytearray(header)
+    for name, code, name_offset, code_offset in zip(names, codes, name_offsets, code_offsets):
+        data += struct.pack("<IIIIQ", name_offset, len(name), code_offset, len(code), fnv1a(code))
+    for name in names:
+        data += name
+    for code, code_offset in zip(codes, code_offsets):
+        data += bytes(code_offset - len(data))
+        data += code
+
+    with open(f"{out_dir}.bundle", mode="wb") as file:
+        file.write(data)
+    print(f"bundled {len(shaders)} shaders into {out_dir}.bundle")
+
+
 def main(glslc: str, in_dir: str, out_dir: str, force: bool):
     print("checking shader cache...")
     os.chdir(in_dir)
@@ -69,6 +126,11 @@ def main(glslc: str, in_dir: str, out_dir: str, force: bool):
             lock.update_hash(in_shader)
 
             os.system(f"{glslc} {in_shader} -o {out_shader}.spv")
+            for variant in variants(in_shader):
+                print(f"compiling {in_shader} {variant}...")
+                os.system(f"{glslc} -D{variant} {in_shader} -o {out_shader}.{variant.lower()}.spv")
+
+    bundle(out_dir)
 
 
 if __name__ == "__main__":
@@ -61,6 +61,11 @@ layout (push_constant) uniform FragmentPushConstant {
 vec3 calcTangentNormal() {
 	vec3 tangentNormal = texture(u_Normal, v_TexCoords).xyz * 2.0 - 1.0;
 
+	// two channel normal maps (BC5) sample z as 0, which no unit normal facing the surface encodes
+	if (tangentNormal.z == -1.0) {
+		tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
+	}
+
 	vec3 Q1 = dFdx(v_Position);
 	vec3 Q2 = dFdy(v_Position);
 	vec2 st1 = dFdx(v_TexCoords);
@@ -3,6 +3,21 @@
 #define MAX_JOINTS 128
 #define MAX_JOINT_INFLUENCE 4
 
+// variants: PACKED_STATIC PACKED_SKINNED
+// every variant decodes one VertexLayout of ShaderObjects.hpp, the default decodes Vertex
+// packed variants store no tangent, the decoder leaves tangents zero and pbr.frag derives the whole tangent frame
+// from screen space derivatives
+#if defined(PACKED_STATIC)
+layout (location = 0) in vec4 a_Position; // unorm16 within mesh bounds, u_Model dequantizes
+layout (location = 1) in vec2 a_Normal;   // octahedral
+layout (location = 4) in vec2 a_TexCoords;
+#elif defined(PACKED_SKINNED)
+layout (location = 0) in vec3 a_Position;
+layout (location = 1) in vec2 a_Normal;   // octahedral
+layout (location = 4) in vec2 a_TexCoords;
+layout (location = 5) in uvec4 a_JointIDs;
+layout (location = 6) in vec4 a_Weights;
+#else
 layout (location = 0) in vec3 a_Position;
 layout (location = 1) in vec3 a_Normal;
 layout (location = 2) in vec3 a_Tangent;
@@ -10,6 +25,7 @@ layout (location = 3) in vec3 a_Bitanget;
 layout (location = 4) in vec2 a_TexCoords;
 layout (location = 5) in ivec4 a_JointIDs;
 layout (location = 6) in vec4 a_Weights;
+#endif
 
 layout(location = 0) out vec3 v_Position;
 layout(location = 1) out vec3 v_Normal;
@@ -22,24 +38,44 @@ layout (set = 0, binding = 0) uniform UniformBufferObject {
     mat4 u_FinalJointTransforms[MAX_JOINTS];
 };
 
+vec3 octahedralDecode(vec2 e) {
+    vec3 v = vec3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0f);
+    v.xy += vec2(v.x >= 0.0f ? -t : t, v.y >= 0.0f ? -t : t);
+    return normalize(v);
+}
+
 void main() {
+#if defined(PACKED_STATIC) || defined(PACKED_SKINNED)
+    vec3 position = a_Position.xyz;
+    vec3 normal = octahedralDecode(a_Normal);
+#else
+    vec3 position = a_Position;
+    vec3 normal = a_Normal;
+#endif
+
+#if defined(PACKED_STATIC)
+    vec4 animatedPosition = vec4(position, 1.0f);
+    mat4 jointTransform = mat4(1.0f);
+#else
     vec4 animatedPosition = vec4(0.0f);
     mat4 jointTransform = mat4(0.0f);
 
     for (int i = 0; i < MAX_JOINT_INFLUENCE; i++) {
         if (a_JointIDs[i] >= MAX_JOINTS || a_JointIDs[i] < 0) {
-            animatedPosition = vec4(a_Position, 1.0f);
+            animatedPosition = vec4(position, 1.0f);
             jointTransform = mat4(1.0f);
             break;
         }
 
-        vec4 localPosition = u_FinalJointTransforms[a_JointIDs[i]] * vec4(a_Position, 1.0f);
+        vec4 localPosition = u_FinalJointTransforms[a_JointIDs[i]] * vec4(position, 1.0f);
         animatedPosition += localPosition * a_Weights[i];
         jointTransform += u_FinalJointTransforms[a_JointIDs[i]] * a_Weights[i];
     }
+#endif
 
 	v_Position = vec3(u_Model * animatedPosition);
-    v_Normal = mat3(transpose(inverse(u_Model * jointTransform))) * a_Normal;
+    v_Normal = mat3(transpose(inverse(u_Model * jointTransform))) * normal;
 	v_TexCoords = a_TexCoords;
 
     gl_Position = u_Projection * u_View * vec4(v_Position, 1.0);
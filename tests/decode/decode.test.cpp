@@ -0,0 +1,214 @@
+#include <R3>
+#include <R3_core>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include "render/model/VertexDecode.hxx"
+
+// Validation and micro-benchmark of the accessor decode kernels
+// every supported instruction set must match the scalar kernels bit for bit, including their scalar tails
+// then each model's binary buffer is decoded as index, weight and vertex streams by every supported instruction set
+
+using namespace R3;
+
+static constexpr const char* MODELS[] = {
+    "assets/glTF/Models/Sponza/glTF/Sponza.bin",
+    "assets/glTF/Models/ABeautifulGame/glTF/ABeautifulGame.bin",
+    "assets/WalkingRobot/glTF/scene.bin",
+    "assets/Phoenix/glTF-Binary/Phoenix.glb",
+};
+
+static constexpr usize ITERATIONS = 20;
+
+// around the 8 and 16 element vector widths, so every kernel also runs its scalar tail
+static constexpr usize COUNTS[] = {0, 1, 2, 7, 8, 9, 15, 16, 17, 31, 33, 1000, 1021};
+
+template <typename T>
+static bool same(const std::vector<T>& expected, const std::vector<T>& actual) {
+    return expected.empty() || std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(T)) == 0;
+}
+
+static bool validateKernels(const decode::Kernels& kernels) {
+    const decode::Kernels& scalar = decode::kernels(decode::Isa::Scalar);
+    std::mt19937 random(0x5eed);
+    bool valid = true;
+
+    auto check = [&](bool equal, const char* kernel, usize count) {
+        if (!equal) {
+            LOG(Error, kernels.name, kernel, "differs from Scalar for", count, "elements");
+            valid = false;
+        }
+    };
+
+    for (usize count : COUNTS) {
+        std::vector<uint8> u8(count);
+        std::vector<uint16> u16(count);
+        std::ranges::generate(u8, [&] { return uint8(random()); });
+        std::ranges::generate(u16, [&] { return uint16(random()); });
+
+        std::vector<uint32> widenedScalar(count);
+        std::vector<uint32> widened(count);
+        scalar.widenU8(u8.data(), widenedScalar.data(), count);
+        kernels.widenU8(u8.data(), widened.data(), count);
+        check(same(widenedScalar, widened), "widenU8", count);
+
+        scalar.widenU16(u16.data(), widenedScalar.data(), count);
+        kernels.widenU16(u16.data(), widened.data(), count);
+        check(same(widenedScalar, widened), "widenU16", count);
+
+        std::vector<float> normalizedScalar(count);
+        std::vector<float> normalized(count);
+        scalar.unormU8(u8.data(), normalizedScalar.data(), count);
+        kernels.unormU8(u8.data(), normalized.data(), count);
+        check(same(normalizedScalar, normalized), "unormU8", count);
+
+        scalar.unormU16(u16.data(), normalizedScalar.data(), count);
+        kernels.unormU16(u16.data(), normalized.data(), count);
+        check(same(normalizedScalar, normalized), "unormU16", count);
+
+        std::uniform_real_distribution<float> real(-1.0f, 1.0f);
+        std::vector<vec3> positions(count);
+        std::vector<vec3> normals(count);
+        std::vector<vec2> texCoords(count);
+        std::vector<ivec4> joints(count);
+        std::vector<vec4> weights(count);
+        std::ranges::generate(positions, [&] { return vec3(real(random), real(random), real(random)); });
+        std::ranges::generate(normals, [&] { return vec3(real(random), real(random), real(random)); });
+        std::ranges::generate(texCoords, [&] { return vec2(real(random), real(random)); });
+        std::ranges::generate(joints, [&] { return ivec4(random() % 256, random() % 256, random() % 256, -1); });
+        std::ranges::generate(weights, [&] { return vec4(real(random), real(random), real(random), real(random)); });
+
+        decode::VertexStreams streams = {
+            .positions = positions.data(),
+            .normals = normals.data(),
+            .texCoords = texCoords.data(),
+            .joints = joints.data(),
+            .weights = weights.data(),
+            .count = count,
+        };
+        // the missing streams are filled with their defaults
+        decode::VertexStreams positionsOnly = {
+            .positions = positions.data(),
+            .count = count,
+        };
+
+        for (const decode::VertexStreams& input : {streams, positionsOnly}) {
+            std::vector<Vertex> verticesScalar(count);
+            std::vector<Vertex> vertices(count);
+            scalar.assemble(input, verticesScalar.data());
+            kernels.assemble(input, vertices.data());
+            check(same(verticesScalar, vertices), input.normals ? "assemble" : "assemble (positions only)", count);
+        }
+    }
+
+    return valid;
+}
+
+template <typename F>
+static double benchmark(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    for (usize i = 0; i < ITERATIONS; i++) {
+        f();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ITERATIONS;
+}
+
+static void benchmarkModel(const char* path) {
+    if (!std::filesystem::exists(path)) {
+        LOG(Warning, "skipping", path, "not found");
+        return;
+    }
+
+    std::ifstream ifs(path, std::ios::binary);
+    std::vector<std::byte> buffer(std::filesystem::file_size(path));
+    ifs.read((char*)buffer.data(), buffer.size());
+
+    // reinterpret the raw buffer as every stream type, the content does not matter for throughput
+    const usize u16Count = buffer.size() / sizeof(uint16);
+    const usize u8Count = buffer.size();
+    const usize vertexCount = buffer.size() / (sizeof(vec3) * 2 + sizeof(vec2) + sizeof(ivec4) + sizeof(vec4));
+
+    std::vector<uint32> widened(u8Count);
+    std::vector<float> normalized(u8Count);
+    std::vector<Vertex> vertices(vertexCount);
+
+    const auto* base = (const std::byte*)buffer.data();
+    const decode::VertexStreams streams = {
+        .positions = (const vec3*)base,
+        .normals = (const vec3*)(base + vertexCount * sizeof(vec3)),
+        .texCoords = (const vec2*)(base + vertexCount * sizeof(vec3) * 2),
+        .joints = (const ivec4*)(base + vertexCount * (sizeof(vec3) * 2 + sizeof(vec2))),
+        .weights = (const vec4*)(base + vertexCount * (sizeof(vec3) * 2 + sizeof(vec2) + sizeof(ivec4))),
+        .count = vertexCount,
+    };
+
+    LOG(Info, "===", path, buffer.size(), "bytes ===");
+
+    for (decode::Isa isa : {decode::Isa::Scalar, decode::Isa::SSE2, decode::Isa::AVX2}) {
+        const decode::Kernels& kernels = decode::kernels(isa);
+        if (kernels.isa != isa) {
+            continue; // not supported on this CPU
+        }
+
+        double widenU8 = benchmark([&] { kernels.widenU8((const uint8*)base, widened.data(), u8Count); });
+        double widenU16 = benchmark([&] { kernels.widenU16((const uint16*)base, widened.data(), u16Count); });
+        double unormU8 = benchmark([&] { kernels.unormU8((const uint8*)base, normalized.data(), u8Count); });
+        double unormU16 = benchmark([&] { kernels.unormU16((const uint16*)base, normalized.data(), u16Count); });
+        double assemble = benchmark([&] { kernels.assemble(streams, vertices.data()); });
+
+        LOG(Info,
+            kernels.name,
+            "widenU8",
+            widenU8,
+            "ms widenU16",
+            widenU16,
+            "ms unormU8",
+            unormU8,
+            "ms unormU16",
+            unormU16,
+            "ms assemble",
+            assemble,
+            "ms");
+    }
+}
+
+extern "C" {
+
+R3_DLL void* Entry() {
+    CurrentScene = new Scene(HASH32("Decode"), "Decode");
+    return CurrentScene;
+}
+
+R3_DLL void Exit(void* scene_) {
+    auto* scene = ((Scene*)scene_);
+    scene->clearRegistry();
+    delete scene;
+}
+
+R3_DLL void Run() {
+    try {
+        LOG(Info, "selected decode kernels:", decode::kernels().name);
+
+        for (decode::Isa isa : {decode::Isa::SSE2, decode::Isa::AVX2}) {
+            const decode::Kernels& kernels = decode::kernels(isa);
+            if (kernels.isa != isa) {
+                continue; // not supported on this CPU
+            }
+            if (validateKernels(kernels)) {
+                LOG(Info, kernels.name, "kernels match Scalar");
+            }
+        }
+
+        for (const char* model : MODELS) {
+            benchmarkModel(model);
+        }
+    } catch (std::exception const& e) {
+        LOG(Error, e.what());
+    }
+}
+
+} // extern "C"